@@ -0,0 +1,66 @@
+#include "massive/rest/client.hpp"
+#include "massive/testing/loopback_server.hpp"
+#include "massive/websocket/client.hpp"
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+using namespace massive;
+
+namespace {
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+} // namespace
+
+int main() {
+    try {
+        // Ten pages of 5,000 trades, every 7th request throttled and every 11th cut off, to
+        // exercise pagination, connection reuse and retries without the real service.
+        testing::LoopbackServerOptions options;
+        options.trades_per_page = 5000;
+        options.pages = 10;
+        options.throttle_every = 7;
+        options.disconnect_every = 11;
+        options.frames_per_second = 2000;
+        testing::LoopbackServer server(options);
+        std::cout << "Loopback server on " << server.base_url() << std::endl;
+
+        auto config = core::ClientConfig::WithApiKey("loopback");
+        config.set_base_url(server.base_url());
+        config.set_retry_policy({5, std::chrono::milliseconds(50), std::chrono::milliseconds(200)});
+        rest::RESTClient client(config);
+
+        auto start = std::chrono::steady_clock::now();
+        auto trades = client.list_trades("AAPL");
+        const double rest_seconds = seconds_since(start);
+        std::cout << "REST: " << trades.size() << " trades in " << rest_seconds << "s ("
+                  << static_cast<double>(trades.size()) / rest_seconds << " trades/s)"
+                  << std::endl;
+
+        std::atomic<std::size_t> received{0};
+        websocket::WebSocketClient ws("loopback");
+        ws.set_endpoint("127.0.0.1", std::to_string(server.port()));
+        ws.subscribe({"T.*"});
+        start = std::chrono::steady_clock::now();
+        ws.connect([&](const std::vector<websocket::WebSocketMessage>& messages) {
+            received += messages.size();
+        });
+        std::this_thread::sleep_for(std::chrono::seconds(2));
+        ws.close();
+        const double ws_seconds = seconds_since(start);
+        std::cout << "WebSocket: " << received.load() << " trades in " << ws_seconds << "s ("
+                  << static_cast<double>(received.load()) / ws_seconds << " trades/s)"
+                  << std::endl;
+
+        const auto stats = server.stats();
+        std::cout << "Server: " << stats.connections << " connections, " << stats.requests
+                  << " requests, " << stats.throttled << " throttled, " << stats.disconnects
+                  << " disconnects, " << stats.frames << " frames" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace massive::core {
+
+// Identifies a series of aggregate bars; each series is stored one day per file.
+struct BarKey {
+    std::string ticker;
+    int multiplier{1};
+    std::string timespan;
+    bool adjusted{true};
+};
+
+// Bars column by column. Missing prices and volumes are NaN; whether transactions and otc are
+// present is recorded in `flags`.
+struct BarColumns {
+    static constexpr std::uint8_t kHasTransactions = 1;
+    static constexpr std::uint8_t kHasOtc = 2;
+    static constexpr std::uint8_t kOtc = 4;
+
+    std::vector<std::int64_t> timestamp;
+    std::vector<double> open;
+    std::vector<double> high;
+    std::vector<double> low;
+    std::vector<double> close;
+    std::vector<double> volume;
+    std::vector<double> vwap;
+    std::vector<std::int64_t> transactions;
+    std::vector<std::uint8_t> flags;
+
+    [[nodiscard]] std::size_t size() const noexcept { return timestamp.size(); }
+};
+
+struct BarStoreStats {
+    // Days served from disk.
+    std::uint64_t days_read{0};
+    std::uint64_t bars_read{0};
+    std::uint64_t days_written{0};
+};
+
+// On-disk store of historical aggregate bars for days that can no longer change, consulted by
+// RESTClient::list_aggs (ClientConfig::set_bar_store). Each (ticker, multiplier, timespan,
+// adjusted, day) is one file under the directory, holding a small header and then one
+// contiguous array per column, so a read is a memory-mapped copy per column. Files use the
+// host's byte order; a file from a host with the other order reads as missing. Safe to share
+// between threads and processes.
+class BarStore {
+public:
+    explicit BarStore(std::string directory);
+
+    [[nodiscard]] const std::string &directory() const noexcept { return directory_; }
+
+    // Appends the stored bars of `day` (YYYY-MM-DD) to `out`. Returns false, leaving `out`
+    // alone, when the day is not stored or its file is unreadable.
+    bool read(const BarKey &key, std::string_view day, BarColumns &out);
+    // Stores every bar of `day`, replacing an earlier copy. The file is written under a
+    // temporary name and renamed, so readers never see it half-written.
+    void write(const BarKey &key, std::string_view day, const BarColumns &bars);
+
+    [[nodiscard]] BarStoreStats stats() const noexcept;
+
+private:
+    [[nodiscard]] std::string path_for(const BarKey &key, std::string_view day) const;
+
+    std::string directory_;
+    std::atomic<std::uint64_t> days_read_{0};
+    std::atomic<std::uint64_t> bars_read_{0};
+    std::atomic<std::uint64_t> days_written_{0};
+};
+
+} // namespace massive::core
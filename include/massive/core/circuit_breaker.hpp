@@ -0,0 +1,76 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace massive::core {
+
+struct CircuitBreakerOptions {
+    // Consecutive failures (5xx or transport errors) that open an endpoint's circuit.
+    std::size_t failure_threshold{5};
+    // How long an open circuit fails fast before letting a probe through.
+    std::chrono::milliseconds open_duration{5000};
+    // Probes allowed in flight while half-open.
+    std::size_t half_open_probes{1};
+};
+
+enum class CircuitState {
+    Closed,
+    Open,
+    HalfOpen,
+};
+
+struct CircuitBreakerStats {
+    std::uint64_t opened{0};
+    // Requests refused while open.
+    std::uint64_t rejected{0};
+};
+
+// Per-endpoint circuit breakers, shared by every client holding the same instance
+// (ClientConfig::set_circuit_breaker). A circuit opens after failure_threshold consecutive
+// failures; requests to it then fail fast with CircuitOpenError until open_duration has passed.
+// It then goes half-open and lets a probe through: success closes it, failure opens it again.
+class CircuitBreaker {
+public:
+    explicit CircuitBreaker(CircuitBreakerOptions options = {});
+
+    // Whether a request to `endpoint` may be sent now. Every allowed request must be followed
+    // by record_success(), record_failure() or record_abandoned().
+    bool allow(const std::string &endpoint);
+    void record_success(const std::string &endpoint);
+    void record_failure(const std::string &endpoint);
+    // For a request the caller gave up on, which says nothing about the endpoint: frees its
+    // probe slot, if it was one, and otherwise changes nothing.
+    void record_abandoned(const std::string &endpoint);
+
+    [[nodiscard]] CircuitState state(const std::string &endpoint) const;
+    // Time until an open circuit lets a probe through; zero unless open.
+    [[nodiscard]] std::chrono::milliseconds retry_in(const std::string &endpoint) const;
+    [[nodiscard]] CircuitBreakerStats stats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Circuit {
+        CircuitState state{CircuitState::Closed};
+        std::size_t failures{0};
+        std::size_t probes{0};
+        Clock::time_point open_until{};
+    };
+
+    CircuitBreakerOptions options_;
+    mutable std::mutex mutex_;
+    std::map<std::string, Circuit, std::less<>> circuits_;
+    CircuitBreakerStats stats_;
+};
+
+// Endpoint a request path is tracked under: its first two segments, e.g. "/v2/aggs" for
+// "/v2/aggs/ticker/AAPL/range/1/day/...", so one ticker's failures count toward its API.
+std::string circuit_endpoint(std::string_view path);
+
+} // namespace massive::core
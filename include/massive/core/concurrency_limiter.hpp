@@ -0,0 +1,91 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace massive::core {
+
+struct ConcurrencyLimiterOptions {
+    std::size_t initial_limit{8};
+    std::size_t min_limit{1};
+    std::size_t max_limit{64};
+    // Multiplicative decrease applied on a 429, a 5xx, a transport error or a latency spike.
+    double backoff_ratio{0.7};
+    // A response slower than this multiple of the baseline latency counts as a spike.
+    double latency_tolerance{2.0};
+};
+
+struct ConcurrencyLimiterStats {
+    // Current number of requests allowed in flight.
+    std::size_t limit{0};
+    std::size_t in_flight{0};
+    std::uint64_t increases{0};
+    std::uint64_t decreases{0};
+    // Smoothed latency that spikes are measured against.
+    std::chrono::microseconds baseline_latency{0};
+    // Time callers spent blocked in acquire().
+    std::chrono::milliseconds waited{0};
+};
+
+// AIMD limit on requests in flight, shared by every thread and client that holds the same
+// instance (for example through ClientConfig::set_concurrency_limiter). The limit grows by
+// about one per limit's worth of successful responses while it is actually in use, and is cut
+// by backoff_ratio when the server pushes back. Only responses to requests sent after the last
+// cut can cut it again, so a burst of failures from one overload costs a single decrease.
+class ConcurrencyLimiter {
+public:
+    // One request's slot. Report how it went with release(); a permit destroyed without a
+    // report frees the slot without affecting the limit.
+    class Permit {
+    public:
+        Permit(Permit &&other) noexcept;
+        Permit &operator=(Permit &&) = delete;
+        Permit(const Permit &) = delete;
+        Permit &operator=(const Permit &) = delete;
+        ~Permit();
+
+        // 429 and 5xx shrink the limit; other statuses feed the latency baseline.
+        void release(int status_code);
+        // The request failed in the transport (timeout, reset, ...).
+        void release_failed();
+
+    private:
+        friend class ConcurrencyLimiter;
+        Permit(ConcurrencyLimiter *limiter, std::uint64_t epoch);
+
+        ConcurrencyLimiter *limiter_;
+        std::uint64_t epoch_;
+        std::chrono::steady_clock::time_point started_;
+    };
+
+    explicit ConcurrencyLimiter(ConcurrencyLimiterOptions options = {});
+
+    // Blocks until fewer than limit() requests are in flight. The limiter must outlive the
+    // permit.
+    [[nodiscard]] Permit acquire();
+
+    [[nodiscard]] std::size_t limit() const;
+    [[nodiscard]] ConcurrencyLimiterStats stats() const;
+
+private:
+    enum class Outcome { Success, Overloaded, Abandoned };
+
+    void release(const Permit &permit, Outcome outcome);
+    [[nodiscard]] std::size_t limit_locked() const;
+
+    ConcurrencyLimiterOptions options_;
+    mutable std::mutex mutex_;
+    std::condition_variable slot_freed_;
+    double limit_;
+    std::size_t in_flight_{0};
+    // Bumped on every decrease; permits remember the value they were issued under.
+    std::uint64_t epoch_{0};
+    double baseline_us_{0};
+    std::uint64_t samples_{0};
+    ConcurrencyLimiterStats stats_;
+};
+
+} // namespace massive::core
@@ -1,7 +1,16 @@
 #pragma once
 
+#include "massive/core/bar_store.hpp"
+#include "massive/core/circuit_breaker.hpp"
+#include "massive/core/concurrency_limiter.hpp"
 #include "massive/core/logging.hpp"
+#include "massive/core/rate_limiter.hpp"
+#include "massive/core/request_coalescer.hpp"
+#include "massive/core/request_observer.hpp"
+#include "massive/core/response_cache.hpp"
+#include "massive/core/retry_budget.hpp"
 #include <chrono>
+#include <cstddef>
 #include <memory>
 #include <optional>
 #include <string>
@@ -9,12 +18,19 @@
 
 namespace massive::core {
 
+// Retries back off with decorrelated jitter between initial_backoff and max_backoff.
 struct RetryPolicy {
     std::size_t max_attempts{3};
     std::chrono::milliseconds initial_backoff{200};
     std::chrono::milliseconds max_backoff{1500};
 };
 
+enum class HttpVersion {
+    Http1_1,
+    // Multiplexes requests over one connection per host; needs MASSIVE_ENABLE_HTTP2.
+    Http2,
+};
+
 class ClientConfig {
 public:
     ClientConfig() = default;
@@ -25,27 +41,84 @@ public:
     ClientConfig &set_api_key(std::string api_key);
     ClientConfig &set_base_url(std::string base_url);
     ClientConfig &set_retry_policy(RetryPolicy policy);
+    // When enabled, list_* methods follow next_url and return every page.
     ClientConfig &set_pagination(bool enabled);
+    // Caps on what a single list_* call collects while paginating; 0 means no limit.
+    ClientConfig &set_max_pages(std::size_t pages);
+    ClientConfig &set_max_items(std::size_t items);
+    // Pages fetched ahead in the background by *_iter iterators; 0 fetches on demand.
+    ClientConfig &set_page_prefetch(std::size_t depth);
+    // Protocol used by transports built with make_transport(config).
+    ClientConfig &set_http_version(HttpVersion version);
     ClientConfig &set_verbose(bool enabled);
     ClientConfig &set_trace(bool enabled);
     ClientConfig &set_logger(std::shared_ptr<ILogger> logger);
+    // Paces requests through `limiter`. Hand the same instance to every config (and thus every
+    // RESTClient) that shares an API key so they draw from one budget.
+    ClientConfig &set_rate_limiter(std::shared_ptr<RateLimiter> limiter);
+    // Caps requests in flight with an adaptive limit; share the instance the same way.
+    ClientConfig &set_concurrency_limiter(std::shared_ptr<ConcurrencyLimiter> limiter);
+    // Caps retries at a share of traffic across every client holding the same budget.
+    ClientConfig &set_retry_budget(std::shared_ptr<RetryBudget> budget);
+    // Fails requests fast with CircuitOpenError while their endpoint keeps failing.
+    ClientConfig &set_circuit_breaker(std::shared_ptr<CircuitBreaker> breaker);
+    // Reports timing, sizes and outcome of every request attempt to `observer`.
+    ClientConfig &set_request_observer(std::shared_ptr<IRequestObserver> observer);
+    // Serves repeated reference-data lookups from `cache` until their TTL runs out.
+    ClientConfig &set_response_cache(std::shared_ptr<ResponseCache> cache);
+    // Shares one round trip between identical GETs sent at the same time.
+    ClientConfig &set_request_coalescer(std::shared_ptr<RequestCoalescer> coalescer);
+    // Lets list_aggs read finished days from `store` and save the ones it downloads.
+    ClientConfig &set_bar_store(std::shared_ptr<BarStore> store);
 
     [[nodiscard]] std::string_view api_key() const noexcept;
     [[nodiscard]] std::string_view base_url() const noexcept;
     [[nodiscard]] const RetryPolicy &retry_policy() const noexcept;
     [[nodiscard]] bool pagination() const noexcept;
+    [[nodiscard]] std::size_t max_pages() const noexcept;
+    [[nodiscard]] std::size_t max_items() const noexcept;
+    [[nodiscard]] std::size_t page_prefetch() const noexcept;
+    [[nodiscard]] HttpVersion http_version() const noexcept;
     [[nodiscard]] bool verbose() const noexcept;
     [[nodiscard]] bool trace() const noexcept;
     [[nodiscard]] std::shared_ptr<ILogger> logger() const noexcept;
+    // Null when requests are not rate limited.
+    [[nodiscard]] const std::shared_ptr<RateLimiter> &rate_limiter() const noexcept;
+    // Null when concurrency is not limited.
+    [[nodiscard]] const std::shared_ptr<ConcurrencyLimiter> &concurrency_limiter() const noexcept;
+    // Null when retries are limited only by RetryPolicy::max_attempts.
+    [[nodiscard]] const std::shared_ptr<RetryBudget> &retry_budget() const noexcept;
+    // Null when no circuit breaker is used.
+    [[nodiscard]] const std::shared_ptr<CircuitBreaker> &circuit_breaker() const noexcept;
+    // Null when requests are not observed.
+    [[nodiscard]] const std::shared_ptr<IRequestObserver> &request_observer() const noexcept;
+    // Null when responses are not cached.
+    [[nodiscard]] const std::shared_ptr<ResponseCache> &response_cache() const noexcept;
+    // Null when every call sends its own request.
+    [[nodiscard]] const std::shared_ptr<RequestCoalescer> &request_coalescer() const noexcept;
+    // Null when list_aggs always downloads.
+    [[nodiscard]] const std::shared_ptr<BarStore> &bar_store() const noexcept;
 
 private:
     std::string api_key_;
     std::string base_url_{"https://api.massive.com"};
     RetryPolicy retry_policy_{};
     bool pagination_{true};
+    std::size_t max_pages_{0};
+    std::size_t max_items_{0};
+    std::size_t page_prefetch_{0};
+    HttpVersion http_version_{HttpVersion::Http1_1};
     bool verbose_{false};
     bool trace_{false};
     std::shared_ptr<ILogger> logger_;
+    std::shared_ptr<RateLimiter> rate_limiter_;
+    std::shared_ptr<ConcurrencyLimiter> concurrency_limiter_;
+    std::shared_ptr<RetryBudget> retry_budget_;
+    std::shared_ptr<CircuitBreaker> circuit_breaker_;
+    std::shared_ptr<IRequestObserver> request_observer_;
+    std::shared_ptr<ResponseCache> response_cache_;
+    std::shared_ptr<RequestCoalescer> request_coalescer_;
+    std::shared_ptr<BarStore> bar_store_;
 };
 
 } // namespace massive::core
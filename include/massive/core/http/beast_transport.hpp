@@ -1,28 +1,79 @@
 #pragma once
 
+#include "massive/core/http/connection_pool.hpp"
+#include "massive/core/http/dns_cache.hpp"
+#include "massive/core/http/happy_eyeballs.hpp"
+#include "massive/core/http/request_deadline.hpp"
+#include "massive/core/http/tls_context.hpp"
 #include "massive/core/http_transport.hpp"
+#include "massive/core/io_runtime.hpp"
 
+#include <boost/asio/awaitable.hpp>
 #include <boost/asio/io_context.hpp>
 #include <boost/beast/core.hpp>
 #include <boost/beast/http.hpp>
 #include <boost/beast/version.hpp>
 
+#include <chrono>
+#include <memory>
+
 namespace massive::core {
 
-class BeastHttpTransport final : public IHttpTransport {
+struct BeastTransportOptions {
+    ConnectionPoolOptions pool{};
+    // I/O threads that run requests; null uses IoRuntime::shared().
+    std::shared_ptr<IoRuntime> runtime;
+    // Resolver cache; null uses DnsCache::shared().
+    std::shared_ptr<DnsCache> dns;
+    // Head start each address gets before the next one is tried in parallel.
+    std::chrono::milliseconds connect_attempt_delay{kConnectAttemptDelay};
+    // Limit for opening a connection: DNS, TCP connect and TLS handshake together.
+    std::chrono::milliseconds connect_timeout{std::chrono::seconds{10}};
+    // Limit for each request write, header read and body read step (at most 1MB). A server that
+    // stops sending mid-response fails within this time. Zero disables either limit;
+    // HttpRequest::timeout additionally bounds the request as a whole.
+    std::chrono::milliseconds io_timeout{std::chrono::seconds{30}};
+};
+
+class BeastHttpTransport final : public IHttpTransport,
+                                 public std::enable_shared_from_this<BeastHttpTransport> {
 public:
     BeastHttpTransport();
+    explicit BeastHttpTransport(BeastTransportOptions options);
     ~BeastHttpTransport() override;
 
+    // Blocks the calling thread until co_send completes on the runtime. Must not be called
+    // from one of the runtime's own threads; use async_send there instead.
     HttpResponse send(const HttpRequest& request) override;
 
+    void async_send(HttpRequest request, HttpResponseHandler handler) override;
+
+    // Coroutine form for callers already running on the transport's runtime. The request
+    // itself runs on a strand of its own.
+    boost::asio::awaitable<HttpResponse> co_send(HttpRequest request);
+
+    [[nodiscard]] const ConnectionPool& connection_pool() const noexcept { return pool_; }
+    [[nodiscard]] TlsHandshakeStats tls_handshake_stats() const noexcept {
+        return tls_.handshake_stats();
+    }
+    [[nodiscard]] IoRuntime& runtime() const noexcept { return *runtime_; }
+
 private:
-    void ensure_executor();
+    // Runs on a per-request strand, which the deadline's timer shares.
+    boost::asio::awaitable<HttpResponse> do_send(HttpRequest request);
 
-    boost::asio::io_context io_;
+    boost::asio::awaitable<std::unique_ptr<PooledConnection>>
+    open_connection(const std::string& host, const std::string& port, const std::string& key,
+                    RequestDeadline& deadline, RequestTiming& timing);
+
+    BeastTransportOptions options_;
+    std::shared_ptr<IoRuntime> runtime_;
+    std::shared_ptr<DnsCache> dns_;
+    TlsContext tls_;
+    ConnectionPool pool_;
 };
 
 std::shared_ptr<IHttpTransport> make_beast_transport();
+std::shared_ptr<IHttpTransport> make_beast_transport(BeastTransportOptions options);
 
 }  // namespace massive::core
-
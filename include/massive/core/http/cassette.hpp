@@ -0,0 +1,104 @@
+#pragma once
+
+#include "massive/core/http_transport.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace massive::core {
+
+// A cassette is a binary file of recorded exchanges: the method and request target (path and
+// query, without scheme and host), then the status, headers, decoded body and latency of the
+// response. Request headers are not stored, so API keys stay out of it.
+
+// Forwards requests to another transport and appends every response, including error statuses,
+// to a cassette. Failed requests (exceptions) are not recorded. Safe to share between threads.
+class RecordingTransport final : public IHttpTransport,
+                                 public std::enable_shared_from_this<RecordingTransport> {
+public:
+    // Appends to `path`, creating it if needed. Throws if the file cannot be opened or is not
+    // a cassette.
+    RecordingTransport(std::shared_ptr<IHttpTransport> inner, const std::string& path);
+
+    HttpResponse send(const HttpRequest& request) override;
+    void async_send(HttpRequest request, HttpResponseHandler handler) override;
+
+    [[nodiscard]] std::size_t recorded() const;
+
+private:
+    // Collects a streamed body so it can be recorded too.
+    HttpRequest capture(HttpRequest request, const std::shared_ptr<std::string>& body) const;
+    void record(const HttpRequest& request, const HttpResponse& response,
+                const std::string& streamed_body);
+
+    std::shared_ptr<IHttpTransport> inner_;
+    mutable std::mutex mutex_;
+    std::ofstream out_;
+    std::size_t recorded_{0};
+};
+
+struct ReplayOptions {
+    // Sleep for each response's recorded latency, to reproduce the timing of the session.
+    bool recorded_latency{false};
+    // Added to every response; with recorded_latency unset this is the whole simulated delay.
+    std::chrono::microseconds latency{0};
+};
+
+// Serves responses from a memory-mapped cassette without touching the network. Requests match
+// on method and target; when a target was recorded several times its responses are served in
+// order and then start over. A request that was never recorded throws. Streamed requests
+// receive the body straight from the mapping. Safe to share between threads.
+class ReplayTransport final : public IHttpTransport {
+public:
+    explicit ReplayTransport(const std::string& path, ReplayOptions options = {});
+    ~ReplayTransport() override;
+
+    ReplayTransport(const ReplayTransport&) = delete;
+    ReplayTransport& operator=(const ReplayTransport&) = delete;
+
+    HttpResponse send(const HttpRequest& request) override;
+
+    // Number of responses in the cassette.
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+private:
+    // Views into the mapping.
+    struct Exchange {
+        HttpMethod method{HttpMethod::Get};
+        std::int32_t status_code{0};
+        std::chrono::microseconds latency{0};
+        std::vector<std::pair<std::string_view, std::string_view>> headers;
+        std::string_view body;
+    };
+    struct Track {
+        std::vector<Exchange> exchanges;
+        std::atomic<std::size_t> next{0};
+    };
+
+    void index();
+
+    ReplayOptions options_;
+    const char* data_{nullptr};
+    std::size_t length_{0};
+    // Holds the file on platforms where it is read rather than mapped.
+    std::string contents_;
+    std::size_t size_{0};
+    // Keyed by request target; the map is filled once and then only read.
+    std::unordered_map<std::string_view, Track> tracks_;
+};
+
+std::shared_ptr<IHttpTransport> make_recording_transport(std::shared_ptr<IHttpTransport> inner,
+                                                         const std::string& path);
+std::shared_ptr<IHttpTransport> make_replay_transport(const std::string& path,
+                                                      ReplayOptions options = {});
+
+}  // namespace massive::core
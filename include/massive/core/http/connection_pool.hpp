@@ -0,0 +1,59 @@
+#pragma once
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/ssl.hpp>
+#include <boost/beast/core/flat_buffer.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace massive::core {
+
+struct ConnectionPoolOptions {
+    // Idle keep-alive connections retained per host:port. Zero disables pooling.
+    std::size_t max_idle_per_host{8};
+    // Idle connections older than this are discarded instead of reused.
+    std::chrono::milliseconds idle_timeout{std::chrono::seconds{30}};
+};
+
+// A TLS stream plus the read buffer that must travel with it between requests.
+struct PooledConnection {
+    PooledConnection(boost::asio::io_context &io, boost::asio::ssl::context &ctx, std::string key);
+
+    std::string key;
+    boost::asio::ssl::stream<boost::asio::ip::tcp::socket> stream;
+    boost::beast::flat_buffer buffer;
+    std::chrono::steady_clock::time_point last_used;
+    std::size_t requests_served{0};
+};
+
+// Thread-safe per-host cache of idle HTTP/1.1 keep-alive connections.
+class ConnectionPool {
+public:
+    explicit ConnectionPool(ConnectionPoolOptions options = {});
+
+    // Returns the most recently used idle connection for `key`, or nullptr on a miss.
+    std::unique_ptr<PooledConnection> acquire(const std::string &key);
+
+    // Hands a healthy connection back; it is dropped if the host is already at capacity.
+    void release(std::unique_ptr<PooledConnection> connection);
+
+    void clear();
+    [[nodiscard]] std::size_t idle_count() const;
+    [[nodiscard]] const ConnectionPoolOptions &options() const noexcept;
+
+private:
+    void evict_expired_locked(std::chrono::steady_clock::time_point now);
+
+    ConnectionPoolOptions options_;
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::vector<std::unique_ptr<PooledConnection>>> idle_;
+};
+
+}  // namespace massive::core
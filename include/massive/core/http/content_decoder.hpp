@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace massive::core {
+
+// Incremental decoder for the gzip and deflate HTTP content codings. Compressed chunks are
+// fed in as they come off the socket and decoded bytes are appended to the caller's buffer.
+class ContentDecoder {
+public:
+    explicit ContentDecoder(std::string_view encoding);
+    ~ContentDecoder();
+
+    ContentDecoder(const ContentDecoder &) = delete;
+    ContentDecoder &operator=(const ContentDecoder &) = delete;
+
+    // True for the Content-Encoding values this decoder understands.
+    static bool supports(std::string_view encoding) noexcept;
+
+    void write(const char *data, std::size_t size, std::string &out);
+
+    // Throws if the compressed stream ended early.
+    void finish() const;
+
+private:
+    struct State;
+    std::unique_ptr<State> state_;
+};
+
+}  // namespace massive::core
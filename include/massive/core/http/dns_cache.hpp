@@ -0,0 +1,78 @@
+#pragma once
+
+#include "massive/core/io_runtime.hpp"
+
+#include <boost/asio/ip/tcp.hpp>
+// Must follow ip/tcp.hpp: awaitable.hpp uses std::exchange without including <utility>
+#include <boost/asio/awaitable.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace massive::core {
+
+struct DnsCacheOptions {
+    // The system resolver does not report record TTLs, so entries live for this long.
+    std::chrono::seconds ttl{60};
+    // A hit this close to expiry starts a background refresh.
+    std::chrono::seconds refresh_ahead{15};
+    // Expired entries are still served for this long while a refresh runs, so a slow or failing
+    // resolver does not stall requests.
+    std::chrono::seconds stale_grace{300};
+};
+
+struct DnsCacheStats {
+    std::uint64_t hits{0};
+    std::uint64_t misses{0};
+    std::uint64_t refreshes{0};
+};
+
+// Shared, TTL-bounded cache in front of the system resolver, keyed by host:port. Background
+// refreshes keep the cache alive through shared_from_this, so create it with make_shared.
+class DnsCache : public std::enable_shared_from_this<DnsCache> {
+public:
+    using Endpoints = std::vector<boost::asio::ip::tcp::endpoint>;
+
+    // Background refreshes run on `runtime`; null uses IoRuntime::shared().
+    explicit DnsCache(DnsCacheOptions options = {}, std::shared_ptr<IoRuntime> runtime = nullptr);
+
+    // Process-wide cache used by transports that are not given their own.
+    static std::shared_ptr<DnsCache> shared();
+
+    // A non-zero `timeout` bounds a lookup that misses the cache (TimeoutError). The timer
+    // completes on the caller's executor, so call it from a strand.
+    boost::asio::awaitable<Endpoints>
+    co_resolve(std::string host, std::string port,
+               std::chrono::milliseconds timeout = std::chrono::milliseconds::zero());
+
+    // Blocking form for synchronous callers such as the WebSocket client.
+    Endpoints resolve(const std::string &host, const std::string &port);
+
+    void clear();
+    [[nodiscard]] DnsCacheStats stats() const;
+
+private:
+    struct Entry {
+        Endpoints endpoints;
+        std::chrono::steady_clock::time_point expires;
+        bool refreshing{false};
+    };
+
+    // Returns cached endpoints usable now, starting a background refresh when due.
+    bool lookup(const std::string &host, const std::string &port, Endpoints &out);
+    void store(const std::string &key, const Endpoints &endpoints);
+    void refresh_in_background(const std::string &host, const std::string &port);
+
+    DnsCacheOptions options_;
+    std::shared_ptr<IoRuntime> runtime_;
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+    DnsCacheStats stats_;
+};
+
+}  // namespace massive::core
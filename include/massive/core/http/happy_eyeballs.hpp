@@ -0,0 +1,27 @@
+#pragma once
+
+#include <boost/asio/ip/tcp.hpp>
+// Must follow ip/tcp.hpp: awaitable.hpp uses std::exchange without including <utility>
+#include <boost/asio/awaitable.hpp>
+
+#include <chrono>
+#include <vector>
+
+namespace massive::core {
+
+// Delay between connection attempts recommended by RFC 8305.
+inline constexpr std::chrono::milliseconds kConnectAttemptDelay{250};
+
+// Connects `socket` to one of `endpoints`, RFC 8305 ("happy eyeballs") style: addresses are
+// interleaved by family and a new attempt starts whenever the previous one fails or has not
+// finished within `attempt_delay`. The first attempt to connect wins and the rest are cancelled,
+// so one black-holed address costs at most `attempt_delay` instead of a full connect timeout.
+// A non-zero `timeout` bounds the whole race; when it runs out every attempt is abandoned and
+// TimeoutError is thrown.
+boost::asio::awaitable<void>
+async_connect_happy_eyeballs(boost::asio::ip::tcp::socket &socket,
+                             const std::vector<boost::asio::ip::tcp::endpoint> &endpoints,
+                             std::chrono::milliseconds attempt_delay = kConnectAttemptDelay,
+                             std::chrono::milliseconds timeout = std::chrono::milliseconds::zero());
+
+}  // namespace massive::core
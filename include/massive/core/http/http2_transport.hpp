@@ -0,0 +1,75 @@
+#pragma once
+
+#include "massive/core/http/dns_cache.hpp"
+#include "massive/core/http/happy_eyeballs.hpp"
+#include "massive/core/http/tls_context.hpp"
+#include "massive/core/http_transport.hpp"
+#include "massive/core/io_runtime.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// Only available when the library is built with MASSIVE_ENABLE_HTTP2=ON (defines
+// MASSIVE_HAS_HTTP2).
+
+namespace massive::core {
+
+struct Http2TransportOptions {
+    // I/O threads that run requests; null uses IoRuntime::shared().
+    std::shared_ptr<IoRuntime> runtime;
+    // Receive windows advertised to the server. Large windows let big responses stream
+    // without stalling on WINDOW_UPDATE round trips.
+    std::int32_t stream_window_size{16 * 1024 * 1024};
+    std::int32_t connection_window_size{64 * 1024 * 1024};
+    // Resolver cache; null uses DnsCache::shared().
+    std::shared_ptr<DnsCache> dns;
+    // Head start each address gets before the next one is tried in parallel.
+    std::chrono::milliseconds connect_attempt_delay{kConnectAttemptDelay};
+    // Limit for opening a connection: DNS, TCP connect and TLS handshake together. Zero
+    // disables it. HttpRequest::timeout bounds each request, which is reset on expiry.
+    std::chrono::milliseconds connect_timeout{std::chrono::seconds{10}};
+};
+
+class Http2Connection;
+
+// HTTP/2 transport built on nghttp2. Requests to the same host:port share one TLS connection
+// (negotiated through ALPN) and run as concurrent streams on it, with HPACK-compressed headers.
+class Http2Transport final : public IHttpTransport,
+                             public std::enable_shared_from_this<Http2Transport> {
+public:
+    Http2Transport();
+    explicit Http2Transport(Http2TransportOptions options);
+    ~Http2Transport() override;
+
+    // Blocks until the response arrives; must not be called from one of the runtime's threads.
+    HttpResponse send(const HttpRequest& request) override;
+
+    void async_send(HttpRequest request, HttpResponseHandler handler) override;
+
+    // Connections currently open or being opened.
+    [[nodiscard]] std::size_t connection_count() const;
+    [[nodiscard]] TlsHandshakeStats tls_handshake_stats() const noexcept {
+        return tls_->handshake_stats();
+    }
+    [[nodiscard]] IoRuntime& runtime() const noexcept { return *runtime_; }
+
+private:
+    std::shared_ptr<Http2Connection> connection_for(const std::string& host,
+                                                    const std::string& port);
+
+    Http2TransportOptions options_;
+    std::shared_ptr<IoRuntime> runtime_;
+    std::shared_ptr<TlsContext> tls_;
+    mutable std::mutex mutex_;
+    std::map<std::string, std::shared_ptr<Http2Connection>> connections_;
+};
+
+std::shared_ptr<IHttpTransport> make_http2_transport();
+std::shared_ptr<IHttpTransport> make_http2_transport(Http2TransportOptions options);
+
+}  // namespace massive::core
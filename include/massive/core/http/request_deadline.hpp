@@ -0,0 +1,74 @@
+#pragma once
+
+#include "massive/exceptions.hpp"
+
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace massive::core {
+
+// Tracks a request's overall deadline and the deadline of the phase it is in. While a socket
+// is watched, running out of time closes it, which fails whatever operation is pending.
+//
+// Create it on the strand that runs the watched socket's I/O: the timer completes there, so the
+// close can never race with that I/O.
+class RequestDeadline {
+public:
+    RequestDeadline(const boost::asio::any_io_executor &executor,
+                    std::optional<std::chrono::milliseconds> overall);
+    ~RequestDeadline();
+
+    RequestDeadline(const RequestDeadline &) = delete;
+    RequestDeadline &operator=(const RequestDeadline &) = delete;
+
+    // Starts `phase`, bounded by `limit` (zero for none) and the overall deadline. Returns the
+    // time the phase may take, zero if unbounded, and throws TimeoutError if none is left (or
+    // std::runtime_error once cancelled).
+    std::chrono::milliseconds begin(const std::string &phase, std::chrono::milliseconds limit);
+
+    // Closes `socket` if the current phase runs out, or the request is cancelled, before end()
+    // is called.
+    void watch(boost::asio::ip::tcp::socket &socket);
+    void end();
+
+    // Returns a callable that abandons the request: it closes the watched socket and makes the
+    // next begin() throw. Run it on the deadline's strand; it stays safe to run at any time.
+    [[nodiscard]] std::function<void()> canceller() const;
+
+    // True once a watched phase ran out and closed its socket.
+    [[nodiscard]] bool expired() const noexcept;
+    [[nodiscard]] bool cancelled() const noexcept;
+    // The error describing the phase that ran out.
+    [[nodiscard]] TimeoutError error() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // Outlives the deadline so timer completions queued after destruction stay harmless.
+    struct State {
+        explicit State(const boost::asio::any_io_executor &executor) : timer(executor) {}
+
+        boost::asio::steady_timer timer;
+        boost::asio::ip::tcp::socket *socket{nullptr};
+        std::uint64_t generation{0};
+        bool expired{false};
+        bool cancelled{false};
+    };
+
+    std::shared_ptr<State> state_;
+    std::optional<Clock::time_point> overall_deadline_;
+    std::chrono::milliseconds overall_limit_{0};
+    Clock::time_point phase_deadline_{Clock::time_point::max()};
+    std::string phase_;
+    std::chrono::milliseconds phase_limit_{0};
+};
+
+}  // namespace massive::core
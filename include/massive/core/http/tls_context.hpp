@@ -0,0 +1,51 @@
+#pragma once
+
+#include <boost/asio/ssl.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace massive::core {
+
+struct TlsHandshakeStats {
+    std::uint64_t full{0};
+    std::uint64_t resumed{0};
+};
+
+// Long-lived client SSL context shared by every connection a transport opens. It loads the
+// CA bundle once and caches session tickets per host:port so reconnects can resume.
+class TlsContext {
+public:
+    TlsContext();
+    ~TlsContext();
+
+    TlsContext(const TlsContext &) = delete;
+    TlsContext &operator=(const TlsContext &) = delete;
+
+    [[nodiscard]] boost::asio::ssl::context &native() noexcept { return ctx_; }
+
+    // Sets SNI and offers any cached session for `key` on a stream that has not yet
+    // handshaken. `key` must outlive the stream, since new tickets are filed under it.
+    void prepare(SSL *ssl, const std::string &host, const std::string &key);
+
+    // Counts a completed handshake as full or resumed.
+    void record_handshake(SSL *ssl);
+
+    [[nodiscard]] TlsHandshakeStats handshake_stats() const noexcept;
+    void clear_sessions();
+
+private:
+    static int on_new_session(SSL *ssl, SSL_SESSION *session);
+    void store_session(const std::string &key, SSL_SESSION *session);
+
+    boost::asio::ssl::context ctx_;
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, SSL_SESSION *> sessions_;
+    std::atomic<std::uint64_t> full_handshakes_{0};
+    std::atomic<std::uint64_t> resumed_handshakes_{0};
+};
+
+}  // namespace massive::core
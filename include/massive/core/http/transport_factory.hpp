@@ -0,0 +1,14 @@
+#pragma once
+
+#include "massive/core/config.hpp"
+#include "massive/core/http_transport.hpp"
+
+#include <memory>
+
+namespace massive::core {
+
+// Builds the transport selected by config.http_version(). Throws if HTTP/2 is requested but
+// the library was built without MASSIVE_ENABLE_HTTP2.
+std::shared_ptr<IHttpTransport> make_transport(const ClientConfig &config);
+
+}  // namespace massive::core
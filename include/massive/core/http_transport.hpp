@@ -1,8 +1,14 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -10,27 +16,105 @@
 
 namespace massive::core {
 
+// Spare capacity transports leave after the response body so it can be handed to simdjson
+// without another copy. Matches SIMDJSON_PADDING.
+inline constexpr std::size_t kResponseBodyPadding = 64;
+
 enum class HttpMethod { Get, Post, Put, Patch, Delete };
 
+// Lets a caller abandon a request it no longer needs. Transports that support cancellation
+// register a handler when the request starts; the request then fails promptly and its
+// connection or stream is torn down rather than left to finish.
+class RequestCancellation {
+public:
+    // Runs the registered handler once, or marks the request so the handler runs on registration.
+    void cancel();
+    [[nodiscard]] bool cancelled() const;
+
+    // Called by transports. Runs `handler` right away if cancel() already happened.
+    void on_cancel(std::function<void()> handler);
+
+private:
+    mutable std::mutex mutex_;
+    bool cancelled_{false};
+    std::function<void()> handler_;
+};
+
+// Receives a response body piece by piece, already decoded. Runs on a transport thread.
+using BodyChunkHandler = std::function<void(std::string_view chunk)>;
+
 struct HttpRequest {
     HttpMethod method{HttpMethod::Get};
     std::string url;
     std::map<std::string, std::string> headers;
+    // Optional headers shared between requests, such as a client's Authorization block. Sent
+    // before `headers`, which replace entries with the same (case-insensitive) name.
+    std::shared_ptr<const std::map<std::string, std::string>> base_headers;
     std::string body;
     std::optional<std::chrono::milliseconds> timeout;
+    // Optional; see RequestCancellation.
+    std::shared_ptr<RequestCancellation> cancellation;
+    // When set, a 2xx body is handed here as it arrives instead of being collected, so memory
+    // stays bounded by the chunk size. Other responses are still collected into body, for the
+    // error message. An exception thrown by the handler fails the request. Transports that do
+    // not stream ignore it and return the whole body.
+    BodyChunkHandler on_body_chunk;
+};
+
+// Where the time of one request went. Steps a reused connection skips (resolve, connect and
+// the TLS handshake) stay zero.
+struct RequestTiming {
+    std::chrono::microseconds dns{0};
+    std::chrono::microseconds connect{0};
+    std::chrono::microseconds tls_handshake{0};
+    std::chrono::microseconds request_write{0};
+    // From the end of the request write until the response header has been read.
+    std::chrono::microseconds time_to_first_byte{0};
+    std::chrono::microseconds body_download{0};
+    // Everything, including waiting for a pooled connection.
+    std::chrono::microseconds total{0};
 };
 
 struct HttpResponse {
     std::int32_t status_code{0};
     std::map<std::string, std::string> headers;
+    // BeastHttpTransport leaves kResponseBodyPadding bytes of capacity past the end so the body
+    // can be parsed where it lies; move the response rather than copying it to keep that.
+    // Empty when the body went to HttpRequest::on_body_chunk.
     std::string body;
+    // Content-Encoding removed by the transport, empty if the body arrived uncompressed.
+    std::string content_encoding;
+    // Body size as received on the wire and after decoding.
+    std::size_t wire_body_bytes{0};
+    std::size_t decoded_body_bytes{0};
+    // Filled in by BeastHttpTransport; other transports leave them zero. Byte counts are HTTP
+    // bytes, before TLS framing.
+    RequestTiming timing;
+    std::size_t bytes_sent{0};
+    std::size_t bytes_received{0};
+    bool connection_reused{false};
 };
 
+// Case-insensitive header lookup; HTTP/2 transports report names in lower case, HTTP/1.1 as
+// the server sent them.
+std::optional<std::string_view> find_header(const std::map<std::string, std::string>& headers,
+                                            std::string_view name);
+
+// Completion handler for async_send. Exactly one of `error` or `response` is meaningful.
+using HttpResponseHandler = std::function<void(std::exception_ptr error, HttpResponse response)>;
+
 class IHttpTransport {
 public:
     virtual ~IHttpTransport() = default;
 
     virtual HttpResponse send(const HttpRequest& request) = 0;
+
+    // Starts `request` and returns without waiting for it. Transports with non-blocking I/O
+    // invoke `handler` on one of their I/O threads; the default completes inline via send().
+    virtual void async_send(HttpRequest request, HttpResponseHandler handler);
+
+    // Future-returning convenience over async_send.
+    std::future<HttpResponse> send_async(HttpRequest request);
 };
 
 }  // namespace massive::core
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace massive::core {
+
+// An io_context driven by a fixed pool of threads. Transports share one runtime so many
+// requests can be in flight without a blocked OS thread per request.
+class IoRuntime {
+public:
+    explicit IoRuntime(std::size_t threads = default_thread_count());
+    ~IoRuntime();
+
+    IoRuntime(const IoRuntime &) = delete;
+    IoRuntime &operator=(const IoRuntime &) = delete;
+
+    [[nodiscard]] boost::asio::io_context &context() noexcept { return io_; }
+    [[nodiscard]] std::size_t thread_count() const noexcept { return threads_.size(); }
+
+    // True when called from one of this runtime's threads.
+    [[nodiscard]] bool running_in_this_thread() const noexcept;
+
+    // Process-wide runtime used by transports that are not given one explicitly.
+    static std::shared_ptr<IoRuntime> shared();
+
+    static std::size_t default_thread_count() noexcept;
+
+private:
+    boost::asio::io_context io_;
+    boost::asio::executor_work_guard<boost::asio::io_context::executor_type> work_;
+    std::vector<std::thread> threads_;
+};
+
+}  // namespace massive::core
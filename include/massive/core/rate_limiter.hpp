@@ -0,0 +1,74 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace massive::core {
+
+struct RateLimiterOptions {
+    // Rate used until the server advertises one, and the ceiling recovery climbs back to
+    // after a 429.
+    double requests_per_second{10.0};
+    // Requests that may go out back to back after an idle period.
+    double burst{5.0};
+    // Floor for the rate while 429s keep halving it.
+    double min_requests_per_second{0.2};
+};
+
+struct RateLimiterStats {
+    std::uint64_t requests{0};
+    // 429 responses observed.
+    std::uint64_t throttled{0};
+    // Time callers spent blocked in acquire().
+    std::chrono::milliseconds waited{0};
+};
+
+// Token bucket shared by every thread and client that holds the same instance (for example
+// through ClientConfig::set_rate_limiter). Requests are paced before they are sent rather than
+// retried after being rejected, and the rate is learned from responses:
+//  - X-RateLimit-Remaining / X-RateLimit-Reset (or the RateLimit-* equivalents) spread the
+//    remaining quota over the time left in the window;
+//  - Retry-After pauses every caller until the given time;
+//  - a 429 without those headers halves the rate; later successes raise it again.
+class RateLimiter {
+public:
+    explicit RateLimiter(RateLimiterOptions options = {});
+
+    // Blocks until a request may be sent and claims its slot.
+    void acquire();
+    // Claims a slot only if one is free now. Used for optional traffic such as hedges.
+    bool try_acquire();
+
+    // Feeds back a response's status and headers.
+    void observe(int status_code, const std::map<std::string, std::string> &headers);
+
+    [[nodiscard]] double rate() const;
+    [[nodiscard]] RateLimiterStats stats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // Earliest time the next request may start; the caller must hold mutex_.
+    Clock::time_point next_slot_locked(Clock::time_point now) const;
+    void claim_locked(Clock::time_point slot);
+    void set_rate_locked(double rate, Clock::time_point now);
+
+    RateLimiterOptions options_;
+    mutable std::mutex mutex_;
+    double rate_;
+    // Theoretical arrival time of the next request (GCRA); requests may run up to `burst`
+    // intervals ahead of it.
+    Clock::time_point schedule_{};
+    Clock::time_point paused_until_{};
+    RateLimiterStats stats_;
+};
+
+// Parses a Retry-After value: delay seconds or an HTTP date.
+std::optional<std::chrono::milliseconds> parse_retry_after(std::string_view value);
+
+}  // namespace massive::core
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "massive/core/http_transport.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace massive::core {
+
+struct RequestCoalescerStats {
+    // Calls that sent their own request.
+    std::uint64_t leaders{0};
+    // Calls that waited for an identical request already in flight instead.
+    std::uint64_t coalesced{0};
+};
+
+// Collapses identical concurrent GETs into one round trip (ClientConfig::set_request_coalescer).
+// The first caller for a key sends the request; callers arriving while it is in flight wait for
+// it and get a copy of the same response, or the same exception. Nothing is kept once the
+// request completes. Share an instance only between clients using the same API key.
+class RequestCoalescer {
+public:
+    HttpResponse run(const std::string &key, const std::function<HttpResponse()> &fetch);
+
+    [[nodiscard]] RequestCoalescerStats stats() const;
+
+private:
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_future<HttpResponse>> in_flight_;
+    RequestCoalescerStats stats_;
+};
+
+} // namespace massive::core
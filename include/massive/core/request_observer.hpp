@@ -0,0 +1,40 @@
+#pragma once
+
+#include "massive/core/http_transport.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace massive::core {
+
+// One attempt of a REST request, as reported to an IRequestObserver. The views are only valid
+// during the call.
+struct RequestMetrics {
+    HttpMethod method{HttpMethod::Get};
+    // Request path without the query, e.g. /v3/trades/AAPL.
+    std::string_view path;
+    // The first two path segments (/v3/trades), a low-cardinality key for grouping.
+    std::string_view endpoint;
+    std::size_t attempt{1};
+    // Zero when the attempt failed without a response; `error` then says why.
+    std::int32_t status_code{0};
+    std::string_view error;
+    // Phase breakdown from the transport. Only `total` is set for failed attempts and for
+    // transports that do not measure phases.
+    RequestTiming timing;
+    std::size_t bytes_sent{0};
+    std::size_t bytes_received{0};
+    bool connection_reused{false};
+};
+
+// Receives the metrics of every request attempt, e.g. to export latency histograms. Called on
+// the thread that made the request, after the attempt and before any retry backoff; keep it
+// cheap and do not throw.
+class IRequestObserver {
+public:
+    virtual ~IRequestObserver() = default;
+    virtual void on_request(const RequestMetrics& metrics) = 0;
+};
+
+}  // namespace massive::core
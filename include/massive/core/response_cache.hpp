@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace massive::core {
+
+struct ResponseCacheOptions {
+    // Independent LRU lists with their own locks; the limits below are split between them.
+    std::size_t shards{16};
+    std::size_t max_entries{10000};
+    // Approximate, counted from response body sizes.
+    std::size_t max_bytes{64 * 1024 * 1024};
+    // Freshness per request path prefix; the longest matching prefix wins and default_ttl
+    // covers the rest. A zero TTL turns caching off for that path.
+    std::map<std::string, std::chrono::seconds> ttls{
+        {"/v1/marketstatus/upcoming", std::chrono::hours(1)},
+        {"/v3/reference/conditions", std::chrono::hours(24)},
+        {"/v3/reference/exchanges", std::chrono::hours(24)},
+        {"/v3/reference/tickers/types", std::chrono::hours(24)},
+    };
+    std::chrono::seconds default_ttl{std::chrono::minutes(15)};
+};
+
+struct ResponseCacheStats {
+    std::uint64_t hits{0};
+    std::uint64_t misses{0};
+    // Stale entries confirmed unchanged by a 304 Not Modified.
+    std::uint64_t revalidated{0};
+    std::uint64_t evictions{0};
+    std::size_t entries{0};
+    std::size_t bytes{0};
+};
+
+// A parsed result kept by ResponseCache. Entries are immutable and handed out shared, so a
+// reader keeps its copy alive while the entry is replaced or evicted.
+struct CachedResponse {
+    std::shared_ptr<const void> value;
+    // The C++ type of `value`, checked before it is cast back.
+    std::type_index type{typeid(void)};
+    // Validator for If-None-Match revalidation; empty if the server sent none.
+    std::string etag;
+    std::chrono::steady_clock::time_point expires;
+    std::size_t bytes{0};
+};
+
+// Sharded in-memory LRU of parsed REST results for slow-changing reference endpoints, keyed by
+// request URL (ClientConfig::set_response_cache). Expired entries stay until evicted so they
+// can be revalidated with their ETag. Share an instance only between clients using the same
+// API key, since entitlements can differ between keys.
+class ResponseCache {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit ResponseCache(ResponseCacheOptions options = {});
+
+    // How long results for `path` stay fresh; zero if they are not cached.
+    [[nodiscard]] std::chrono::seconds ttl(std::string_view path) const;
+
+    // The entry for `key`, fresh or not, and null if there is none. Counts a hit when the
+    // entry is fresh and a miss otherwise.
+    std::shared_ptr<const CachedResponse> find(const std::string &key);
+    void store(const std::string &key, CachedResponse entry);
+    // Marks a stale entry fresh again for `ttl` after the server answered 304.
+    void revalidate(const std::string &key, std::chrono::seconds ttl);
+
+    void clear();
+    [[nodiscard]] ResponseCacheStats stats() const;
+
+private:
+    struct Shard {
+        std::mutex mutex;
+        // Most recently used first.
+        std::list<std::pair<std::string, std::shared_ptr<const CachedResponse>>> lru;
+        std::unordered_map<std::string_view, decltype(lru)::iterator> index;
+        std::size_t bytes{0};
+    };
+
+    Shard &shard_for(const std::string &key);
+    // The caller must hold the shard's mutex.
+    void evict_locked(Shard &shard);
+
+    ResponseCacheOptions options_;
+    std::size_t max_entries_per_shard_;
+    std::size_t max_bytes_per_shard_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+
+    std::atomic<std::uint64_t> hits_{0};
+    std::atomic<std::uint64_t> misses_{0};
+    std::atomic<std::uint64_t> revalidated_{0};
+    std::atomic<std::uint64_t> evictions_{0};
+};
+
+} // namespace massive::core
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace massive::core {
+
+struct RetryBudgetOptions {
+    // Retries allowed as a fraction of first attempts over the window.
+    double ratio{0.1};
+    // Retries always allowed per second, so a quiet client can still retry.
+    double min_retries_per_second{1.0};
+};
+
+struct RetryBudgetStats {
+    std::uint64_t requests{0};
+    std::uint64_t retries{0};
+    // Retries refused because the budget was spent.
+    std::uint64_t rejected{0};
+};
+
+// Caps retries at a fraction of overall traffic, shared by every client holding the same
+// instance (ClientConfig::set_retry_budget). While an upstream is failing, at most about
+// `ratio` extra load is added on top of first attempts instead of max_attempts times as much.
+class RetryBudget {
+public:
+    static constexpr std::size_t kWindowSeconds = 10;
+
+    explicit RetryBudget(RetryBudgetOptions options = {});
+
+    // Counts a first attempt.
+    void record_request();
+    // Claims a retry if the budget allows one.
+    bool try_retry();
+
+    [[nodiscard]] RetryBudgetStats stats() const;
+
+private:
+    struct Bucket {
+        std::int64_t second{-1};
+        std::uint64_t requests{0};
+        std::uint64_t retries{0};
+    };
+
+    // The caller must hold mutex_.
+    Bucket &current_locked();
+
+    RetryBudgetOptions options_;
+    mutable std::mutex mutex_;
+    // Per-second counts for the last kWindowSeconds seconds, indexed by second modulo size.
+    std::array<Bucket, kWindowSeconds> buckets_{};
+    RetryBudgetStats stats_;
+};
+
+} // namespace massive::core
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <stdexcept>
 #include <string>
 
@@ -29,5 +30,41 @@ private:
     std::string body_;
 };
 
+// A request, or one phase of it (resolve, connect, TLS handshake, write, read), outlasted its
+// deadline. The transport closes the connection involved, so it is never reused.
+class TimeoutError : public std::runtime_error {
+public:
+    TimeoutError(const std::string& phase, std::chrono::milliseconds limit)
+        : std::runtime_error("TimeoutError: " + phase + " did not complete within " +
+                             std::to_string(limit.count()) + "ms")
+        , phase_(phase)
+        , limit_(limit) {}
+
+    [[nodiscard]] const std::string& phase() const noexcept { return phase_; }
+    [[nodiscard]] std::chrono::milliseconds limit() const noexcept { return limit_; }
+
+private:
+    std::string phase_;
+    std::chrono::milliseconds limit_;
+};
+
+// The circuit breaker for an endpoint is open after repeated failures, so the request was not
+// sent. retry_in() is how long until a probe request will be let through.
+class CircuitOpenError : public std::runtime_error {
+public:
+    CircuitOpenError(const std::string& endpoint, std::chrono::milliseconds retry_in)
+        : std::runtime_error("CircuitOpenError: " + endpoint + " is failing, retry in " +
+                             std::to_string(retry_in.count()) + "ms")
+        , endpoint_(endpoint)
+        , retry_in_(retry_in) {}
+
+    [[nodiscard]] const std::string& endpoint() const noexcept { return endpoint_; }
+    [[nodiscard]] std::chrono::milliseconds retry_in() const noexcept { return retry_in_; }
+
+private:
+    std::string endpoint_;
+    std::chrono::milliseconds retry_in_;
+};
+
 }  // namespace massive
 
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace massive::rest {
+
+// Outcome of one call in a batch: either a value or the exception the call threw.
+template <typename T>
+struct BatchResult {
+    std::optional<T> value;
+    std::exception_ptr error;
+
+    [[nodiscard]] bool ok() const noexcept { return value.has_value(); }
+
+    // Returns the value or rethrows the captured error.
+    const T &get() const {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return *value;
+    }
+};
+
+struct BatchOptions {
+    // Upper bound on requests running at the same time.
+    std::size_t max_in_flight{16};
+};
+
+template <typename T>
+using BatchCallback = std::function<void(const std::string &key, BatchResult<T> result)>;
+
+// Runs `call` for every key with at most options.max_in_flight calls running at once.
+// `on_result` is invoked once per key in completion order and never concurrently with itself.
+// Failures of `call` are captured in the result; an exception thrown by `on_result` stops
+// new calls from starting and is rethrown once the running ones finish. So is a failure to
+// start a worker thread.
+template <typename T>
+void run_batch(const std::vector<std::string> &keys, const std::function<T(const std::string &)> &call,
+               const BatchCallback<T> &on_result, const BatchOptions &options = {}) {
+    if (keys.empty()) {
+        return;
+    }
+
+    std::atomic<std::size_t> next{0};
+    std::atomic<bool> stop{false};
+    std::mutex callback_mutex;
+    std::exception_ptr callback_error;
+
+    auto worker = [&]() {
+        while (!stop.load(std::memory_order_relaxed)) {
+            const std::size_t index = next.fetch_add(1, std::memory_order_relaxed);
+            if (index >= keys.size()) {
+                return;
+            }
+
+            BatchResult<T> result;
+            try {
+                result.value.emplace(call(keys[index]));
+            } catch (...) {
+                result.error = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock(callback_mutex);
+            if (callback_error) {
+                return;
+            }
+            try {
+                on_result(keys[index], std::move(result));
+            } catch (...) {
+                callback_error = std::current_exception();
+                stop.store(true, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    const std::size_t workers = std::clamp<std::size_t>(options.max_in_flight, 1, keys.size());
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    try {
+        for (std::size_t i = 1; i < workers; ++i) {
+            threads.emplace_back(worker);
+        }
+    } catch (...) {
+        // Joinable threads must not be destroyed: stop the ones started, then report.
+        stop.store(true, std::memory_order_relaxed);
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        throw;
+    }
+    worker();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    if (callback_error) {
+        std::rethrow_exception(callback_error);
+    }
+}
+
+// Collecting form of run_batch.
+template <typename T>
+std::map<std::string, BatchResult<T>>
+collect_batch(const std::vector<std::string> &keys, const std::function<T(const std::string &)> &call,
+              const BatchOptions &options = {}) {
+    std::map<std::string, BatchResult<T>> results;
+    run_batch<T>(
+        keys, call,
+        [&results](const std::string &key, BatchResult<T> result) {
+            results.insert_or_assign(key, std::move(result));
+        },
+        options);
+    return results;
+}
+
+} // namespace massive::rest
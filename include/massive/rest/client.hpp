@@ -4,6 +4,9 @@
 #include "massive/core/http_transport.hpp"
 #include "massive/core/json.hpp"
 #include "massive/exceptions.hpp"
+#include "massive/rest/batch.hpp"
+#include "massive/rest/hedging.hpp"
+#include "massive/rest/json_parser.hpp"
 #include "massive/rest/models.hpp"
 #include "massive/rest/models/benzinga.hpp"
 #include "massive/rest/models/conversion.hpp"
@@ -18,15 +21,23 @@
 #include "massive/rest/models/tmx.hpp"
 #include "massive/rest/models/vx.hpp"
 #include "massive/rest/pagination.hpp"
+#include "massive/rest/query_params.hpp"
 #include "massive/rest/request_options.hpp"
+#include "massive/rest/results_stream.hpp"
 
+#include <algorithm>
 #include <chrono>
+#include <cstddef>
 #include <functional>
 #include <iterator>
+#include <map>
 #include <memory>
 #include <optional>
+#include <stdexcept>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <typeinfo>
 #include <vector>
 
 namespace massive::rest {
@@ -34,6 +45,11 @@ namespace massive::rest {
 class RESTClient {
 public:
     RESTClient(core::ClientConfig config, std::shared_ptr<core::IHttpTransport> transport);
+    // Uses the transport config.http_version() selects.
+    explicit RESTClient(core::ClientConfig config);
+
+    // Counters for requests sent with RequestOptions::hedge.
+    [[nodiscard]] HedgeStats hedge_stats() const;
 
     // Aggregates (Bars) - All methods
     std::vector<Agg> list_aggs(const std::string &ticker, int multiplier,
@@ -57,8 +73,11 @@ public:
     DailyOpenCloseAgg get_daily_open_close_agg(const std::string &ticker, const std::string &date,
                                                std::optional<bool> adjusted = std::nullopt);
 
-    PreviousCloseAgg get_previous_close_agg(const std::string &ticker,
-                                            std::optional<bool> adjusted = std::nullopt);
+    // get_previous_close_agg, get_last_quote and get_snapshot_ticker accept RequestOptions so
+    // latency-critical callers can enable hedging (RequestOptions::hedge) per call.
+    PreviousCloseAgg
+    get_previous_close_agg(const std::string &ticker, std::optional<bool> adjusted = std::nullopt,
+                           const std::optional<RequestOptions> &options = std::nullopt);
 
     // Trades
     std::vector<Trade> list_trades(const std::string &ticker,
@@ -71,6 +90,22 @@ public:
                                    const std::optional<std::string> &sort = std::nullopt,
                                    const std::optional<std::string> &order = std::nullopt);
 
+    // Hands each trade to on_trade as soon as it is parsed, while the page is still downloading,
+    // so memory stays bounded however large the pages are. on_trade runs on the calling thread,
+    // so it may use this client; a slow on_trade holds back the download. Pagination and the max_pages/max_items caps apply as for
+    // list_trades. A page that breaks off after trades were handed over is not retried, since
+    // they cannot be taken back; the call throws instead.
+    void stream_trades(const std::string &ticker,
+                       const std::function<void(const Trade &)> &on_trade,
+                       const std::optional<std::string> &timestamp = std::nullopt,
+                       const std::optional<std::string> &timestamp_lt = std::nullopt,
+                       const std::optional<std::string> &timestamp_lte = std::nullopt,
+                       const std::optional<std::string> &timestamp_gt = std::nullopt,
+                       const std::optional<std::string> &timestamp_gte = std::nullopt,
+                       std::optional<int> limit = std::nullopt,
+                       const std::optional<std::string> &sort = std::nullopt,
+                       const std::optional<std::string> &order = std::nullopt);
+
     LastTrade get_last_trade(const std::string &ticker);
     CryptoTrade get_last_crypto_trade(const std::string &from, const std::string &to);
 
@@ -85,7 +120,20 @@ public:
                                    const std::optional<std::string> &sort = std::nullopt,
                                    const std::optional<std::string> &order = std::nullopt);
 
-    LastQuote get_last_quote(const std::string &ticker);
+    // Quote counterpart of stream_trades.
+    void stream_quotes(const std::string &ticker,
+                       const std::function<void(const Quote &)> &on_quote,
+                       const std::optional<std::string> &timestamp = std::nullopt,
+                       const std::optional<std::string> &timestamp_lt = std::nullopt,
+                       const std::optional<std::string> &timestamp_lte = std::nullopt,
+                       const std::optional<std::string> &timestamp_gt = std::nullopt,
+                       const std::optional<std::string> &timestamp_gte = std::nullopt,
+                       std::optional<int> limit = std::nullopt,
+                       const std::optional<std::string> &sort = std::nullopt,
+                       const std::optional<std::string> &order = std::nullopt);
+
+    LastQuote get_last_quote(const std::string &ticker,
+                             const std::optional<RequestOptions> &options = std::nullopt);
     LastForexQuote get_last_forex_quote(const std::string &from, const std::string &to);
     RealTimeCurrencyConversion
     get_real_time_currency_conversion(const std::string &from, const std::string &to,
@@ -97,7 +145,8 @@ public:
                                                  const std::vector<std::string> &tickers = {},
                                                  bool include_otc = false);
 
-    TickerSnapshot get_snapshot_ticker(SnapshotMarketType market_type, const std::string &ticker);
+    TickerSnapshot get_snapshot_ticker(SnapshotMarketType market_type, const std::string &ticker,
+                                       const std::optional<RequestOptions> &options = std::nullopt);
 
     std::vector<TickerSnapshot> get_snapshot_direction(SnapshotMarketType market_type,
                                                        Direction direction,
@@ -900,6 +949,40 @@ public:
                           const std::optional<std::string> &date = std::nullopt,
                           const std::optional<std::string> &precision = std::nullopt);
 
+    // Batch Methods
+    // These methods issue one request per ticker concurrently, bounded by
+    // BatchOptions::max_in_flight. Per-ticker failures are captured in the result rather
+    // than thrown. The callback overloads stream results in completion order instead of
+    // collecting them.
+
+    std::map<std::string, BatchResult<std::vector<Agg>>>
+    get_aggs_many(const std::vector<std::string> &tickers, int multiplier,
+                  const std::string &timespan, const std::string &from, const std::string &to,
+                  std::optional<bool> adjusted = std::nullopt, const BatchOptions &options = {});
+
+    void get_aggs_many(const std::vector<std::string> &tickers, int multiplier,
+                       const std::string &timespan, const std::string &from,
+                       const std::string &to, const BatchCallback<std::vector<Agg>> &on_result,
+                       std::optional<bool> adjusted = std::nullopt,
+                       const BatchOptions &options = {});
+
+    std::map<std::string, BatchResult<LastTrade>>
+    get_last_trade_many(const std::vector<std::string> &tickers, const BatchOptions &options = {});
+
+    void get_last_trade_many(const std::vector<std::string> &tickers,
+                             const BatchCallback<LastTrade> &on_result,
+                             const BatchOptions &options = {});
+
+    std::map<std::string, BatchResult<TickerSnapshot>>
+    get_snapshot_ticker_many(SnapshotMarketType market_type,
+                             const std::vector<std::string> &tickers,
+                             const BatchOptions &options = {});
+
+    void get_snapshot_ticker_many(SnapshotMarketType market_type,
+                                  const std::vector<std::string> &tickers,
+                                  const BatchCallback<TickerSnapshot> &on_result,
+                                  const BatchOptions &options = {});
+
     // Paginated Iterator Methods
     // These methods return iterators that automatically handle pagination
 
@@ -952,18 +1035,277 @@ public:
 
 private:
     core::HttpResponse send_request(core::HttpMethod method, const std::string &path,
-                                    const std::map<std::string, std::string> &params = {},
-                                    const std::optional<RequestOptions> &options = std::nullopt);
-
-    std::string build_url(const std::string &path,
-                          const std::map<std::string, std::string> &params = {},
+                                    const QueryParams &params = {},
+                                    const std::optional<RequestOptions> &options = std::nullopt,
+                                    const core::BodyChunkHandler &on_body_chunk = nullptr,
+                                    const std::function<void()> &on_restart = nullptr);
+    // send_request without coalescing: the retry loop around a single request.
+    core::HttpResponse perform_request(core::HttpMethod method, const std::string &path,
+                                       const QueryParams &params,
+                                       const std::optional<RequestOptions> &options,
+                                       const core::BodyChunkHandler &on_body_chunk,
+                                       const std::function<void()> &on_restart);
+
+    // Sends `request`, plus a duplicate if it is still unanswered after the hedge delay, and
+    // returns the first response. Transport errors are rethrown once every attempt has failed.
+    core::HttpResponse send_hedged(const core::HttpRequest &request, std::string_view endpoint,
+                                   const HedgePolicy &policy);
+
+    std::string build_url(const std::string &path, const QueryParams &params = {},
                           const std::optional<RequestOptions> &options = std::nullopt) const;
-    std::map<std::string, std::string>
-    build_headers(const std::optional<RequestOptions> &options = std::nullopt) const;
+
+    // GETs path and hands each page's root object to parse_page, which appends to results.
+    // With pagination enabled next_url is followed until the last page or until the
+    // configured max_pages/max_items cap is reached.
+    template <typename T, typename ParsePage>
+    void collect_pages(std::string path, QueryParams params, std::vector<T> &results,
+                       ParsePage &&parse_page);
+
+    // Like collect_pages, but streams each page through ResultsStreamParser and calls
+    // on_result with every element of its results array as it arrives. The request runs on a
+    // thread of its own and hands the body over through a ChunkQueue; parsing, on_result and
+    // truncate run on the calling thread. A page that breaks off
+    // after results were delivered can only be fetched again when `truncate` is given: it is
+    // called with the number of results to keep before the page is retried. An exception
+    // thrown by on_result ends the call as it is, without a retry.
+    template <typename OnResult>
+    void stream_pages(std::string path, QueryParams params, OnResult &&on_result,
+                      const std::function<void(std::size_t)> &truncate = nullptr);
+
+    // GETs path and returns parse(body), going through the configured ResponseCache when the
+    // path has a TTL. Fresh entries are returned without a request; stale ones that carry an
+    // ETag are revalidated with If-None-Match and kept on 304.
+    template <typename T, typename Parse>
+    T cached_get(const std::string &path, const QueryParams &params, Parse &&parse);
+
+    // Caches the result of load() under path/params for the path's TTL, for results that take
+    // more than one request (collect_pages). There is no validator, so expiry means a reload.
+    // The key includes the pagination settings, since they decide how much of the list loads.
+    template <typename T, typename Load>
+    T cached_result(const std::string &path, const QueryParams &params, Load &&load);
+
+    // Points path/params at a next_url returned by the API.
+    void follow_next_url(const std::string &next_url, std::string &path,
+                         QueryParams &params) const;
 
     core::ClientConfig config_;
     std::shared_ptr<core::IHttpTransport> transport_;
     std::shared_ptr<core::JsonCodec> json_codec_;
+    std::shared_ptr<HedgeTracker> hedge_tracker_;
+    // Authorization and the other default headers, built once and shared by every request.
+    std::shared_ptr<const std::map<std::string, std::string>> default_headers_;
 };
 
+template <typename T, typename ParsePage>
+void RESTClient::collect_pages(std::string path, QueryParams params, std::vector<T> &results,
+                               ParsePage &&parse_page) {
+    const std::size_t max_pages = config_.max_pages();
+    const std::size_t max_items = config_.max_items();
+    std::string previous_next_url;
+
+    for (std::size_t pages = 1;; ++pages) {
+        auto response = send_request(core::HttpMethod::Get, path, params);
+
+        auto doc_result = iterate_json(response.body);
+        if (doc_result.error()) {
+            throw std::runtime_error("Failed to parse JSON response");
+        }
+        auto root_obj = doc_result.value().get_object();
+        if (root_obj.error()) {
+            throw std::runtime_error("Response is not a JSON object");
+        }
+        auto &root = root_obj.value();
+
+        // Grow geometrically so following many pages stays amortised O(n).
+        std::size_t expected = page_count_hint(root);
+        if (max_items != 0) {
+            expected = std::min(expected, max_items - std::min(max_items, results.size()));
+        }
+        if (results.size() + expected > results.capacity()) {
+            results.reserve(std::max(results.size() + expected, results.capacity() * 2));
+        }
+
+        parse_page(root);
+
+        if (max_items != 0 && results.size() >= max_items) {
+            results.erase(results.begin() + static_cast<std::ptrdiff_t>(max_items),
+                          results.end());
+            return;
+        }
+        if (!config_.pagination() || (max_pages != 0 && pages >= max_pages)) {
+            return;
+        }
+        // A repeated next_url would otherwise loop forever.
+        auto next_url = next_page_url(root);
+        if (!next_url.has_value() || *next_url == previous_next_url) {
+            return;
+        }
+        follow_next_url(*next_url, path, params);
+        previous_next_url = std::move(*next_url);
+    }
+}
+
+template <typename OnResult>
+void RESTClient::stream_pages(std::string path, QueryParams params, OnResult &&on_result,
+                              const std::function<void(std::size_t)> &truncate) {
+    const std::size_t max_pages = config_.max_pages();
+    const std::size_t max_items = config_.max_items();
+    std::size_t items = 0;
+    std::string previous_next_url;
+
+    for (std::size_t pages = 1;; ++pages) {
+        // Elements past max_items still arrive with the rest of the page; they are skipped.
+        ResultsStreamParser parser([&](::simdjson::ondemand::object &element) {
+            if (max_items == 0 || items < max_items) {
+                on_result(element);
+                ++items;
+            }
+        });
+        const std::size_t page_start = items;
+
+        // Up to 16 chunks of at most 64KB wait for the parser.
+        ChunkQueue queue(16);
+        RequestOptions options;
+        options.cancellation = std::make_shared<core::RequestCancellation>();
+        std::function<void()> restart;
+        if (truncate) {
+            restart = [&queue] { queue.push_restart(); };
+        }
+        core::HttpResponse response;
+        std::exception_ptr request_error;
+        std::thread request_thread([&] {
+            try {
+                response = send_request(
+                    core::HttpMethod::Get, path, params, options,
+                    [&queue](std::string_view chunk) { queue.push(chunk); }, restart);
+            } catch (...) {
+                request_error = std::current_exception();
+            }
+            queue.close();
+        });
+        try {
+            std::string chunk;
+            bool restarted = false;
+            while (queue.pop(chunk, restarted)) {
+                if (restarted) {
+                    parser.reset();
+                    truncate(page_start);
+                    items = page_start;
+                } else {
+                    parser.feed(chunk);
+                }
+            }
+        } catch (...) {
+            // The rest of the page is not wanted: stop the request rather than drain it.
+            queue.abandon();
+            options.cancellation->cancel();
+            request_thread.join();
+            throw;
+        }
+        request_thread.join();
+        if (request_error) {
+            std::rethrow_exception(request_error);
+        }
+        // A transport that does not stream hands back the whole body instead.
+        parser.feed(response.body);
+        parser.finish();
+
+        if (max_items != 0 && items >= max_items) {
+            return;
+        }
+        if (!config_.pagination() || (max_pages != 0 && pages >= max_pages)) {
+            return;
+        }
+        auto doc_result = iterate_json(parser.envelope());
+        if (doc_result.error()) {
+            throw std::runtime_error("Failed to parse JSON response");
+        }
+        auto root_obj = doc_result.value().get_object();
+        if (root_obj.error()) {
+            throw std::runtime_error("Response is not a JSON object");
+        }
+        auto &root = root_obj.value();
+        // A repeated next_url would otherwise loop forever.
+        auto next_url = next_page_url(root);
+        if (!next_url.has_value() || *next_url == previous_next_url) {
+            return;
+        }
+        follow_next_url(*next_url, path, params);
+        previous_next_url = std::move(*next_url);
+    }
+}
+
+
+template <typename T, typename Parse>
+T RESTClient::cached_get(const std::string &path, const QueryParams &params, Parse &&parse) {
+    const auto &cache = config_.response_cache();
+    const auto ttl = cache ? cache->ttl(path) : std::chrono::seconds(0);
+    if (ttl.count() <= 0) {
+        return parse(send_request(core::HttpMethod::Get, path, params).body);
+    }
+
+    const auto key = build_url(path, params);
+    auto entry = cache->find(key);
+    if (entry && entry->type != typeid(T)) {
+        entry.reset();
+    }
+    if (entry && core::ResponseCache::Clock::now() < entry->expires) {
+        return *std::static_pointer_cast<const T>(entry->value);
+    }
+
+    std::optional<RequestOptions> options;
+    if (entry && !entry->etag.empty()) {
+        options.emplace();
+        options->headers["If-None-Match"] = entry->etag;
+    }
+    auto response = send_request(core::HttpMethod::Get, path, params, options);
+    if (response.status_code == 304 && entry) {
+        cache->revalidate(key, ttl);
+        return *std::static_pointer_cast<const T>(entry->value);
+    }
+
+    auto value = std::make_shared<const T>(parse(response.body));
+    core::CachedResponse fresh;
+    fresh.value = value;
+    fresh.type = typeid(T);
+    if (auto etag = core::find_header(response.headers, "ETag")) {
+        fresh.etag = std::string(*etag);
+    }
+    fresh.expires = core::ResponseCache::Clock::now() + ttl;
+    fresh.bytes = key.size() + response.body.size();
+    cache->store(key, std::move(fresh));
+    return *value;
+}
+
+template <typename T, typename Load>
+T RESTClient::cached_result(const std::string &path, const QueryParams &params, Load &&load) {
+    const auto &cache = config_.response_cache();
+    const auto ttl = cache ? cache->ttl(path) : std::chrono::seconds(0);
+    if (ttl.count() <= 0) {
+        return load();
+    }
+
+    const auto key = build_url(path, params) + "#pagination=" +
+                     (config_.pagination() ? "on" : "off") +
+                     ",max_pages=" + std::to_string(config_.max_pages()) +
+                     ",max_items=" + std::to_string(config_.max_items());
+    auto entry = cache->find(key);
+    if (entry && entry->type == typeid(T) && core::ResponseCache::Clock::now() < entry->expires) {
+        return *std::static_pointer_cast<const T>(entry->value);
+    }
+
+    auto value = std::make_shared<const T>(load());
+    core::CachedResponse fresh;
+    fresh.value = value;
+    fresh.type = typeid(T);
+    fresh.expires = core::ResponseCache::Clock::now() + ttl;
+    // No body to measure, so estimate from the parsed elements.
+    fresh.bytes = key.size() + sizeof(T);
+    if constexpr (requires { value->size(); }) {
+        fresh.bytes += value->size() * sizeof(typename T::value_type);
+    }
+    cache->store(key, std::move(fresh));
+    return *value;
+}
+
 } // namespace massive::rest
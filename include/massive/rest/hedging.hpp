@@ -0,0 +1,76 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace massive::rest {
+
+// Opt-in hedging for idempotent GETs: when the first attempt has not answered within the
+// hedge delay, a duplicate is sent (on another connection or stream) and whichever response
+// arrives first is used. The slower one is cancelled.
+struct HedgePolicy {
+    // The delay is this percentile of recently observed latency of hedged requests to the
+    // same endpoint, each measured from the first attempt.
+    double percentile{0.95};
+    // Delay used until HedgeTracker::kMinSamples latencies have been observed.
+    std::chrono::milliseconds initial_delay{100};
+    // Bounds on the adaptive delay.
+    std::chrono::milliseconds min_delay{5};
+    std::chrono::milliseconds max_delay{2000};
+};
+
+struct HedgeStats {
+    // Hedge-enabled requests that got a response.
+    std::uint64_t requests{0};
+    // Duplicates sent because the first attempt was slower than the hedge delay.
+    std::uint64_t hedges_sent{0};
+    // Responses that came from the duplicate.
+    std::uint64_t hedge_wins{0};
+
+    // Fraction of duplicates that beat the first attempt.
+    [[nodiscard]] double win_rate() const noexcept {
+        return hedges_sent == 0 ? 0.0
+                                : static_cast<double>(hedge_wins) /
+                                      static_cast<double>(hedges_sent);
+    }
+};
+
+// Latency windows, one per endpoint, and counters shared by a client's hedged requests.
+// Thread-safe.
+class HedgeTracker {
+public:
+    static constexpr std::size_t kWindowSize = 512;
+    static constexpr std::size_t kMinSamples = 20;
+
+    // How long to wait for the first attempt to `endpoint` before sending the duplicate.
+    [[nodiscard]] std::chrono::milliseconds delay(std::string_view endpoint,
+                                                  const HedgePolicy &policy) const;
+
+    void record_hedge_sent();
+    // `latency` runs from the first attempt's start to the response, whichever attempt won,
+    // so a slow first attempt still counts as slow when the duplicate beats it.
+    void record_response(std::string_view endpoint, std::chrono::microseconds latency,
+                         bool from_hedge);
+
+    [[nodiscard]] HedgeStats stats() const;
+
+private:
+    // Ring buffer of the most recent latencies.
+    struct Window {
+        std::vector<std::chrono::microseconds> samples;
+        std::size_t next{0};
+    };
+
+    mutable std::mutex mutex_;
+    std::map<std::string, Window, std::less<>> windows_;
+    HedgeStats stats_;
+};
+
+} // namespace massive::rest
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <simdjson/ondemand.h>
+
+#include <string>
+
+namespace massive::rest {
+
+// Starts parsing a response body with a simdjson parser that is reused by every call on the
+// calling thread, so its internal buffers are sized once rather than on each response.
+// Bodies that carry SIMDJSON_PADDING bytes of spare capacity (BeastHttpTransport returns them
+// that way) are parsed in place; others are first copied into a reusable thread-local buffer.
+//
+// The document stays valid until the next iterate_json call on the same thread and only
+// while `body` is alive and unmodified.
+::simdjson::simdjson_result<::simdjson::ondemand::document> iterate_json(const std::string &body);
+
+} // namespace massive::rest
@@ -1,11 +1,20 @@
 #pragma once
 
+#include "massive/core/http_transport.hpp"
+
+#include <cstddef>
 #include <string>
 #include <optional>
 #include <vector>
 #include <functional>
 #include <memory>
 #include <stdexcept>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
 #include <simdjson/ondemand.h>
 
 namespace massive::rest {
@@ -20,6 +29,107 @@ struct PaginationInfo {
     std::optional<std::string> request_id;
 };
 
+namespace detail {
+
+// Background page fetcher used by PaginatedIterator in read-ahead mode. A worker thread
+// follows next_url links and keeps up to `depth` pages buffered ahead of the consumer. Every
+// fetch gets the prefetcher's cancellation, which is cancelled on destruction so a request in
+// flight ends early rather than holding up the join.
+template <typename T>
+class PagePrefetcher {
+public:
+    using Page = std::pair<std::vector<T>, PaginationInfo>;
+    using FetchFunction = std::function<Page(
+        const std::optional<std::string>&, const std::shared_ptr<core::RequestCancellation>&)>;
+
+    PagePrefetcher(FetchFunction fetch_fn, std::optional<std::string> next_url, std::size_t depth)
+        : fetch_fn_(std::move(fetch_fn)), next_url_(std::move(next_url)), depth_(depth) {
+        worker_ = std::thread([this]() { run(); });
+    }
+
+    ~PagePrefetcher() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            cancelled_ = true;
+        }
+        cv_.notify_all();
+        cancellation_->cancel();
+        if (worker_.joinable()) {
+            worker_.join();
+        }
+    }
+
+    PagePrefetcher(const PagePrefetcher&) = delete;
+    PagePrefetcher& operator=(const PagePrefetcher&) = delete;
+
+    // Blocks until the next page is available; rethrows a failed fetch.
+    Page next() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this]() { return !ready_.empty() || error_ || done_; });
+        if (!ready_.empty()) {
+            Page page = std::move(ready_.front());
+            ready_.pop_front();
+            cv_.notify_all();
+            return page;
+        }
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+        return Page{};
+    }
+
+private:
+    void run() {
+        std::optional<std::string> url = next_url_;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this]() { return cancelled_ || ready_.size() < depth_; });
+                if (cancelled_) {
+                    return;
+                }
+            }
+
+            Page page;
+            try {
+                page = fetch_fn_(url, cancellation_);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                error_ = std::current_exception();
+                cv_.notify_all();
+                return;
+            }
+
+            const auto& info = page.second;
+            url = info.next_url.has_value() ? info.next_url : info.next_page_token;
+            const bool last = !url.has_value();
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            ready_.push_back(std::move(page));
+            done_ = last;
+            cv_.notify_all();
+            if (last) {
+                return;
+            }
+        }
+    }
+
+    FetchFunction fetch_fn_;
+    std::optional<std::string> next_url_;
+    std::size_t depth_;
+    std::shared_ptr<core::RequestCancellation> cancellation_ =
+        std::make_shared<core::RequestCancellation>();
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<Page> ready_;
+    std::exception_ptr error_;
+    bool done_{false};
+    bool cancelled_{false};
+    std::thread worker_;
+};
+
+} // namespace detail
+
 // Generic paginated iterator for API responses
 template <typename T>
 class PaginatedIterator {
@@ -32,6 +142,9 @@ public:
 
     // Function type for fetching next page
     using FetchFunction = std::function<std::pair<std::vector<T>, PaginationInfo>(const std::optional<std::string>&)>;
+    // Same, for fetches that can be cut short: the cancellation is null for pages fetched on
+    // the caller's thread, and cancelled when a read-ahead is abandoned.
+    using CancellableFetchFunction = typename detail::PagePrefetcher<T>::FetchFunction;
 
     // End iterator
     class EndIterator {};
@@ -39,12 +152,29 @@ public:
     // Constructors
     PaginatedIterator() : is_end_(true) {}
     
-    PaginatedIterator(FetchFunction fetch_fn, const std::optional<std::string>& initial_url = std::nullopt)
+    // With prefetch_depth > 0, up to that many following pages are fetched on a background
+    // thread while the current one is consumed. Copies of the iterator share the read-ahead.
+    PaginatedIterator(FetchFunction fetch_fn, const std::optional<std::string>& initial_url = std::nullopt,
+                      std::size_t prefetch_depth = 0)
+        : PaginatedIterator(
+              CancellableFetchFunction(
+                  [fetch_fn = std::move(fetch_fn)](
+                      const std::optional<std::string>& url,
+                      const std::shared_ptr<core::RequestCancellation>&) { return fetch_fn(url); }),
+              initial_url, prefetch_depth) {}
+
+    PaginatedIterator(CancellableFetchFunction fetch_fn,
+                      const std::optional<std::string>& initial_url = std::nullopt,
+                      std::size_t prefetch_depth = 0)
         : fetch_fn_(std::move(fetch_fn))
         , current_url_(initial_url)
         , is_end_(false)
         , current_index_(0) {
         load_next_page();
+        if (prefetch_depth > 0 && has_next_page()) {
+            prefetcher_ = std::make_shared<detail::PagePrefetcher<T>>(fetch_fn_, current_url_,
+                                                                      prefetch_depth);
+        }
     }
 
     // Copy constructor
@@ -54,7 +184,8 @@ public:
         , is_end_(other.is_end_)
         , current_index_(other.current_index_)
         , current_page_(other.current_page_)
-        , pagination_info_(other.pagination_info_) {}
+        , pagination_info_(other.pagination_info_)
+        , prefetcher_(other.prefetcher_) {}
 
     // Assignment operator
     PaginatedIterator& operator=(const PaginatedIterator& other) {
@@ -65,6 +196,7 @@ public:
             current_index_ = other.current_index_;
             current_page_ = other.current_page_;
             pagination_info_ = other.pagination_info_;
+            prefetcher_ = other.prefetcher_;
         }
         return *this;
     }
@@ -154,7 +286,7 @@ private:
         }
 
         try {
-            auto [items, info] = fetch_fn_(current_url_);
+            auto [items, info] = prefetcher_ ? prefetcher_->next() : fetch_fn_(current_url_, nullptr);
             current_page_ = std::move(items);
             pagination_info_ = info;
             current_index_ = 0;
@@ -180,12 +312,13 @@ private:
         }
     }
 
-    FetchFunction fetch_fn_;
+    CancellableFetchFunction fetch_fn_;
     std::optional<std::string> current_url_;
     bool is_end_;
     size_t current_index_;
     std::vector<T> current_page_;
     PaginationInfo pagination_info_;
+    std::shared_ptr<detail::PagePrefetcher<T>> prefetcher_;
 };
 
 // Helper function to extract pagination info from JSON response
@@ -195,5 +328,12 @@ PaginationInfo extract_pagination_info(simdjson::ondemand::object& root_obj);
 // Helper function to check if response has pagination
 bool has_pagination(simdjson::ondemand::object& root_obj);
 
+// Number of results the page says it carries ("count", or "resultsCount" on aggregates);
+// 0 when absent. Used to size result vectors before the results array is parsed.
+std::size_t page_count_hint(simdjson::ondemand::object& root_obj);
+
+// The page's next_url, looked up on its own so a consumed results array is not re-read.
+std::optional<std::string> next_page_url(simdjson::ondemand::object& root_obj);
+
 } // namespace massive::rest
 
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace massive::rest {
+
+// Query parameters of one request, kept sorted by key like the std::map they replace so URLs
+// come out the same. The first kInlineCapacity entries live inside the object, and short keys
+// and values fit in std::string's small buffer, so a typical request builds its parameters
+// without touching the heap.
+class QueryParams {
+public:
+    using value_type = std::pair<std::string, std::string>;
+    using const_iterator = const value_type *;
+
+    static constexpr std::size_t kInlineCapacity = 8;
+
+    QueryParams() = default;
+
+    // Returns the value for `key`, inserting an empty one if it is missing.
+    std::string &operator[](std::string_view key);
+    // Null if `key` is not set.
+    [[nodiscard]] const std::string *find(std::string_view key) const;
+
+    void clear();
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+    [[nodiscard]] const_iterator begin() const noexcept { return data(); }
+    [[nodiscard]] const_iterator end() const noexcept { return data() + size_; }
+
+private:
+    [[nodiscard]] const value_type *data() const noexcept {
+        return spilled_.empty() ? inline_.data() : spilled_.data();
+    }
+    [[nodiscard]] value_type *data() noexcept {
+        return spilled_.empty() ? inline_.data() : spilled_.data();
+    }
+
+    std::array<value_type, kInlineCapacity> inline_{};
+    // Holds every entry once there are more than kInlineCapacity.
+    std::vector<value_type> spilled_;
+    std::size_t size_{0};
+};
+
+} // namespace massive::rest
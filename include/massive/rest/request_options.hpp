@@ -1,7 +1,11 @@
 #pragma once
 
+#include "massive/core/http_transport.hpp"
+#include "massive/rest/hedging.hpp"
+
 #include <chrono>
 #include <map>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -25,6 +29,13 @@ struct RequestOptions {
     // Request body (for POST/PUT/PATCH)
     std::optional<std::string> body;
     
+    // Hedge slow GETs with a duplicate request (ignored for other methods)
+    std::optional<HedgePolicy> hedge;
+    
+    // Abandons the request, retries and backoff included, once cancelled. Such a request is
+    // neither hedged nor coalesced with others.
+    std::shared_ptr<core::RequestCancellation> cancellation;
+    
     RequestOptions() = default;
 };
 
@@ -54,6 +65,9 @@ public:
     // Set request body
     RequestOptionBuilder& body(const std::string& body);
     
+    // Enable request hedging
+    RequestOptionBuilder& hedge(const HedgePolicy& policy = {});
+    
     // Build the RequestOptions
     RequestOptions build() const;
     
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <simdjson/ondemand.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace massive::rest {
+
+// Incremental parser for list responses. The body is fed in arbitrary pieces as it arrives;
+// each element of the top-level "results" array is parsed and handed over as soon as its
+// closing bracket is seen, so only one element is buffered at a time. Everything outside the
+// array (status, next_url, ...) is kept as a small envelope document, with the array emptied.
+class ResultsStreamParser {
+public:
+    // Called with each object element. The object is only valid during the call.
+    using ElementHandler = std::function<void(::simdjson::ondemand::object &element)>;
+
+    explicit ResultsStreamParser(ElementHandler on_element);
+
+    void feed(std::string_view chunk);
+    // Forgets everything fed so far, to start the same body over.
+    void reset();
+    // Throws if the body ended in the middle of a value.
+    void finish() const;
+
+    // The response without its results, e.g. {"status":"OK","results":[],"next_url":"..."}.
+    [[nodiscard]] const std::string &envelope() const noexcept { return envelope_; }
+    [[nodiscard]] std::size_t elements() const noexcept { return elements_; }
+
+private:
+    enum class Mode {
+        Envelope,
+        // Between the elements of the results array.
+        Results,
+        Element,
+    };
+
+    void emit();
+
+    ElementHandler on_element_;
+    std::string envelope_;
+    std::string element_;
+    // Last string seen directly in the top-level object, and whether it named the results.
+    std::string key_;
+    bool results_key_{false};
+
+    Mode mode_{Mode::Envelope};
+    std::size_t depth_{0};
+    bool in_string_{false};
+    bool escaped_{false};
+    std::size_t elements_{0};
+};
+
+// Bounded hand-off of body chunks from the transport thread that receives them to the thread
+// that parses them, so callers' handlers never run on an I/O thread. The producer blocks while
+// `capacity` chunks are waiting, which bounds memory when the consumer falls behind.
+class ChunkQueue {
+public:
+    explicit ChunkQueue(std::size_t capacity);
+
+    // Producer side. push() throws once the consumer has abandoned the queue.
+    void push(std::string_view chunk);
+    // Tells the consumer the body starts over, after the chunks already queued.
+    void push_restart();
+    // No more chunks will come.
+    void close();
+
+    // Consumer side. Waits for the next chunk and returns false once the queue is closed and
+    // empty. `restart` is set instead of filling `chunk` when the body starts over.
+    bool pop(std::string &chunk, bool &restart);
+    // Stops taking chunks and wakes a blocked producer.
+    void abandon();
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    // A restart is queued as nullopt.
+    std::deque<std::optional<std::string>> chunks_;
+    std::size_t capacity_;
+    bool closed_{false};
+    bool abandoned_{false};
+};
+
+} // namespace massive::rest
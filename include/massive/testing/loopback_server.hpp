@@ -0,0 +1,71 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace massive::testing {
+
+// Behaviour of a LoopbackServer. Every fault is deterministic ("every Nth"), so runs repeat.
+struct LoopbackServerOptions {
+    // 0 picks a free port; see LoopbackServer::port().
+    std::uint16_t port{0};
+    std::size_t threads{1};
+
+    // REST: GET /v3/trades/{ticker} serves `pages` pages of synthetic trades, linked by
+    // next_url. Other paths answer 404.
+    std::size_t trades_per_page{1000};
+    std::size_t pages{10};
+    // Delay before each response header.
+    std::chrono::milliseconds latency{0};
+    // Caps how fast each response body is written; 0 writes as fast as the socket allows.
+    std::size_t bytes_per_second{0};
+    // Every Nth request is answered 429 with Retry-After: 1; 0 never.
+    std::size_t throttle_every{0};
+    // Every Nth response is cut off halfway through its body by closing the socket; 0 never.
+    std::size_t disconnect_every{0};
+
+    // WebSocket: any upgrade request is accepted. After auth, each subscription to T.* or
+    // T.{ticker} gets frames of `trades_per_frame` trades at `frames_per_second`.
+    std::size_t trades_per_frame{10};
+    double frames_per_second{1000.0};
+    // Drops the connection after this many trade frames; 0 never.
+    std::size_t disconnect_after_frames{0};
+};
+
+struct LoopbackServerStats {
+    std::uint64_t connections{0};
+    std::uint64_t requests{0};
+    std::uint64_t throttled{0};
+    std::uint64_t disconnects{0};
+    std::uint64_t websocket_sessions{0};
+    std::uint64_t frames{0};
+};
+
+// In-process HTTPS (HTTP/1.1) and secure WebSocket server on 127.0.0.1, standing in for the
+// Massive API in benchmarks and load tests. It presents a self-signed certificate generated at
+// startup. Serving starts in the constructor and stops in stop() or the destructor.
+class LoopbackServer {
+public:
+    explicit LoopbackServer(LoopbackServerOptions options = {});
+    ~LoopbackServer();
+
+    LoopbackServer(const LoopbackServer &) = delete;
+    LoopbackServer &operator=(const LoopbackServer &) = delete;
+
+    [[nodiscard]] std::uint16_t port() const noexcept;
+    // https://127.0.0.1:{port}, for ClientConfig::set_base_url.
+    [[nodiscard]] std::string base_url() const;
+    [[nodiscard]] LoopbackServerStats stats() const noexcept;
+
+    // Closes the listener and every open connection, then joins the server threads.
+    void stop();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace massive::testing
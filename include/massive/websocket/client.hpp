@@ -7,6 +7,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <set>
 #include <optional>
@@ -37,7 +38,12 @@ public:
     void connect(MessageHandler handler);
     void close();
 
-    // Subscription management
+    // Connects to `host`:`port` instead of the feed's host, e.g. a local stand-in server.
+    // Takes effect on the next connect().
+    void set_endpoint(std::string host, std::string port = "443");
+
+    // Subscription management. While disconnected, changes are kept and sent on the next
+    // connect().
     void subscribe(const std::vector<std::string>& subscriptions);
     void unsubscribe(const std::vector<std::string>& subscriptions);
     void unsubscribe_all();
@@ -46,8 +52,9 @@ private:
     void ensure_connected();
     void authenticate();
     void reconcile_subscriptions();
-    void process_message(const std::string& message);
-    std::vector<WebSocketMessage> parse_messages(const std::string& json);
+    // `message` must be followed by SIMDJSON_PADDING readable bytes; it is parsed in place.
+    void process_message(std::string_view message);
+    void parse_messages(std::string_view json, std::vector<WebSocketMessage>& messages);
     
     std::string api_key_;
     Feed feed_;
@@ -55,6 +62,9 @@ private:
     bool raw_;
     bool verbose_;
     std::optional<int> max_reconnects_;
+    // Empty host means the feed's own.
+    std::string endpoint_host_;
+    std::string endpoint_port_{"443"};
     
     std::set<std::string> current_subscriptions_;
     std::set<std::string> scheduled_subscriptions_;
@@ -0,0 +1,203 @@
+#include "massive/core/bar_store.hpp"
+
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+#if defined(_WIN32)
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace massive::core {
+
+namespace {
+// File layout, in the host's byte order:
+//   8-byte magic, u32 byte-order mark, u32 reserved, u64 row count,
+//   then the columns timestamp, open, high, low, close, volume, vwap, transactions (8 bytes
+//   per row each) and flags (1 byte per row).
+// The header is 24 bytes, so every 8-byte column starts 8-byte aligned.
+constexpr std::string_view kMagic = "MASSBAR1";
+constexpr std::uint32_t kByteOrderMark = 0x01020304;
+constexpr std::size_t kHeaderSize = 24;
+constexpr std::size_t kRowSize = 8 * 8 + 1;
+
+// Tickers become directory names, so anything beyond letters, digits, '-' and '_' is
+// percent-encoded (X:BTCUSD, BRK.A).
+std::string encode_component(std::string_view value) {
+    static constexpr char kHex[] = "0123456789ABCDEF";
+    std::string encoded;
+    for (char c : value) {
+        const auto byte = static_cast<unsigned char>(c);
+        if (std::isalnum(byte) || c == '-' || c == '_') {
+            encoded += c;
+        } else {
+            encoded += '%';
+            encoded += kHex[byte >> 4];
+            encoded += kHex[byte & 0x0f];
+        }
+    }
+    return encoded;
+}
+
+template <typename T>
+void append_column(std::string &out, const std::vector<T> &column) {
+    out.append(reinterpret_cast<const char *>(column.data()), column.size() * sizeof(T));
+}
+
+template <typename T>
+void read_column(const char *&data, std::size_t rows, std::vector<T> &column) {
+    const auto offset = column.size();
+    column.resize(offset + rows);
+    std::memcpy(column.data() + offset, data, rows * sizeof(T));
+    data += rows * sizeof(T);
+}
+
+// Copies the columns of a validated file onto the end of `out`.
+bool decode(const char *data, std::size_t length, BarColumns &out) {
+    if (length < kHeaderSize || std::string_view(data, kMagic.size()) != kMagic) {
+        return false;
+    }
+    std::uint32_t mark = 0;
+    std::uint64_t rows = 0;
+    std::memcpy(&mark, data + 8, sizeof(mark));
+    std::memcpy(&rows, data + 16, sizeof(rows));
+    if (mark != kByteOrderMark || rows > (length - kHeaderSize) / kRowSize ||
+        length != kHeaderSize + rows * kRowSize) {
+        return false;
+    }
+    const auto count = static_cast<std::size_t>(rows);
+    data += kHeaderSize;
+    read_column(data, count, out.timestamp);
+    read_column(data, count, out.open);
+    read_column(data, count, out.high);
+    read_column(data, count, out.low);
+    read_column(data, count, out.close);
+    read_column(data, count, out.volume);
+    read_column(data, count, out.vwap);
+    read_column(data, count, out.transactions);
+    read_column(data, count, out.flags);
+    return true;
+}
+} // namespace
+
+BarStore::BarStore(std::string directory) : directory_(std::move(directory)) {
+    if (directory_.empty()) {
+        throw std::invalid_argument("BarStore needs a directory");
+    }
+}
+
+std::string BarStore::path_for(const BarKey &key, std::string_view day) const {
+    std::string series = std::to_string(key.multiplier) + encode_component(key.timespan);
+    if (!key.adjusted) {
+        series += "-unadjusted";
+    }
+    return (std::filesystem::path(directory_) / encode_component(key.ticker) / series /
+            (encode_component(day) + ".bars"))
+        .string();
+}
+
+bool BarStore::read(const BarKey &key, std::string_view day, BarColumns &out) {
+    const auto path = path_for(key, day);
+    const auto before = out.size();
+    bool ok = false;
+#if defined(_WIN32)
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+    const std::string contents((std::istreambuf_iterator<char>(in)),
+                               std::istreambuf_iterator<char>());
+    ok = decode(contents.data(), contents.size(), out);
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+    const auto length = static_cast<std::size_t>(info.st_size);
+    void *mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+    ok = decode(static_cast<const char *>(mapping), length, out);
+    ::munmap(mapping, length);
+#endif
+    if (!ok) {
+        return false;
+    }
+    days_read_.fetch_add(1, std::memory_order_relaxed);
+    bars_read_.fetch_add(out.size() - before, std::memory_order_relaxed);
+    return true;
+}
+
+void BarStore::write(const BarKey &key, std::string_view day, const BarColumns &bars) {
+    const auto rows = bars.size();
+    for (std::size_t size : {bars.open.size(), bars.high.size(), bars.low.size(),
+                             bars.close.size(), bars.volume.size(), bars.vwap.size(),
+                             bars.transactions.size(), bars.flags.size()}) {
+        if (size != rows) {
+            throw std::invalid_argument("BarStore::write: columns differ in length");
+        }
+    }
+
+    std::string contents;
+    contents.reserve(kHeaderSize + rows * kRowSize);
+    contents.append(kMagic);
+    const std::uint32_t mark = kByteOrderMark;
+    const std::uint32_t reserved = 0;
+    const std::uint64_t count = rows;
+    contents.append(reinterpret_cast<const char *>(&mark), sizeof(mark));
+    contents.append(reinterpret_cast<const char *>(&reserved), sizeof(reserved));
+    contents.append(reinterpret_cast<const char *>(&count), sizeof(count));
+    append_column(contents, bars.timestamp);
+    append_column(contents, bars.open);
+    append_column(contents, bars.high);
+    append_column(contents, bars.low);
+    append_column(contents, bars.close);
+    append_column(contents, bars.volume);
+    append_column(contents, bars.vwap);
+    append_column(contents, bars.transactions);
+    append_column(contents, bars.flags);
+
+    const std::filesystem::path path = path_for(key, day);
+    std::filesystem::create_directories(path.parent_path());
+    // Unique per writer, so processes filling the same day do not write into each other's file.
+    thread_local std::mt19937_64 rng{std::random_device{}()};
+    auto temporary = path;
+    temporary += ".tmp" + std::to_string(rng());
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        out.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+        if (!out) {
+            out.close();
+            std::filesystem::remove(temporary);
+            throw std::runtime_error("Failed to write bar store file: " + temporary.string());
+        }
+    }
+    std::filesystem::rename(temporary, path);
+    days_written_.fetch_add(1, std::memory_order_relaxed);
+}
+
+BarStoreStats BarStore::stats() const noexcept {
+    BarStoreStats stats;
+    stats.days_read = days_read_.load(std::memory_order_relaxed);
+    stats.bars_read = bars_read_.load(std::memory_order_relaxed);
+    stats.days_written = days_written_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace massive::core
@@ -0,0 +1,102 @@
+#include "massive/core/circuit_breaker.hpp"
+
+#include <algorithm>
+
+namespace massive::core {
+
+CircuitBreaker::CircuitBreaker(CircuitBreakerOptions options) : options_(options) {
+    options_.failure_threshold = std::max<std::size_t>(options_.failure_threshold, 1);
+    options_.half_open_probes = std::max<std::size_t>(options_.half_open_probes, 1);
+}
+
+bool CircuitBreaker::allow(const std::string &endpoint) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto &circuit = circuits_[endpoint];
+    switch (circuit.state) {
+        case CircuitState::Closed:
+            return true;
+        case CircuitState::Open:
+            if (Clock::now() < circuit.open_until) {
+                ++stats_.rejected;
+                return false;
+            }
+            circuit.state = CircuitState::HalfOpen;
+            circuit.probes = 0;
+            [[fallthrough]];
+        case CircuitState::HalfOpen:
+            if (circuit.probes >= options_.half_open_probes) {
+                ++stats_.rejected;
+                return false;
+            }
+            ++circuit.probes;
+            return true;
+    }
+    return true;
+}
+
+void CircuitBreaker::record_success(const std::string &endpoint) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto &circuit = circuits_[endpoint];
+    circuit.state = CircuitState::Closed;
+    circuit.failures = 0;
+    circuit.probes = 0;
+}
+
+void CircuitBreaker::record_failure(const std::string &endpoint) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto &circuit = circuits_[endpoint];
+    ++circuit.failures;
+    // A failed probe reopens at once; a closed circuit tolerates a run of failures first.
+    if (circuit.state == CircuitState::HalfOpen ||
+        (circuit.state == CircuitState::Closed &&
+         circuit.failures >= options_.failure_threshold)) {
+        circuit.state = CircuitState::Open;
+        circuit.open_until = Clock::now() + options_.open_duration;
+        circuit.probes = 0;
+        ++stats_.opened;
+    }
+}
+
+void CircuitBreaker::record_abandoned(const std::string &endpoint) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto &circuit = circuits_[endpoint];
+    if (circuit.state == CircuitState::HalfOpen && circuit.probes > 0) {
+        --circuit.probes;
+    }
+}
+
+CircuitState CircuitBreaker::state(const std::string &endpoint) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = circuits_.find(endpoint);
+    return it == circuits_.end() ? CircuitState::Closed : it->second.state;
+}
+
+std::chrono::milliseconds CircuitBreaker::retry_in(const std::string &endpoint) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = circuits_.find(endpoint);
+    if (it == circuits_.end() || it->second.state != CircuitState::Open) {
+        return std::chrono::milliseconds::zero();
+    }
+    const auto remaining = it->second.open_until - Clock::now();
+    return std::max(std::chrono::ceil<std::chrono::milliseconds>(remaining),
+                    std::chrono::milliseconds::zero());
+}
+
+CircuitBreakerStats CircuitBreaker::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+std::string circuit_endpoint(std::string_view path) {
+    std::size_t end = 0;
+    for (int segment = 0; segment < 2; ++segment) {
+        const auto start = path.find_first_not_of('/', end);
+        if (start == std::string_view::npos) {
+            break;
+        }
+        end = std::min(path.find('/', start), path.size());
+    }
+    return std::string(path.substr(0, end));
+}
+
+} // namespace massive::core
@@ -0,0 +1,124 @@
+#include "massive/core/concurrency_limiter.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace massive::core {
+
+namespace {
+// Weight of a new sample in the latency baseline. Small, so a spike stands out against it
+// while a lasting change in server latency is still adopted within a few dozen responses.
+constexpr double kBaselineWeight = 1.0 / 32;
+// Responses needed before latency alone can shrink the limit.
+constexpr std::uint64_t kMinBaselineSamples = 10;
+} // namespace
+
+ConcurrencyLimiter::Permit::Permit(ConcurrencyLimiter *limiter, std::uint64_t epoch)
+    : limiter_(limiter), epoch_(epoch), started_(std::chrono::steady_clock::now()) {}
+
+ConcurrencyLimiter::Permit::Permit(Permit &&other) noexcept
+    : limiter_(other.limiter_), epoch_(other.epoch_), started_(other.started_) {
+    other.limiter_ = nullptr;
+}
+
+ConcurrencyLimiter::Permit::~Permit() {
+    if (limiter_ != nullptr) {
+        limiter_->release(*this, Outcome::Abandoned);
+    }
+}
+
+void ConcurrencyLimiter::Permit::release(int status_code) {
+    if (limiter_ == nullptr) {
+        return;
+    }
+    const bool overloaded = status_code == 429 || status_code >= 500;
+    limiter_->release(*this, overloaded ? Outcome::Overloaded : Outcome::Success);
+    limiter_ = nullptr;
+}
+
+void ConcurrencyLimiter::Permit::release_failed() {
+    if (limiter_ == nullptr) {
+        return;
+    }
+    limiter_->release(*this, Outcome::Overloaded);
+    limiter_ = nullptr;
+}
+
+ConcurrencyLimiter::ConcurrencyLimiter(ConcurrencyLimiterOptions options)
+    : options_(options) {
+    options_.min_limit = std::max<std::size_t>(options_.min_limit, 1);
+    options_.max_limit = std::max(options_.max_limit, options_.min_limit);
+    limit_ = static_cast<double>(
+        std::clamp(options_.initial_limit, options_.min_limit, options_.max_limit));
+}
+
+std::size_t ConcurrencyLimiter::limit_locked() const {
+    return static_cast<std::size_t>(std::floor(limit_));
+}
+
+ConcurrencyLimiter::Permit ConcurrencyLimiter::acquire() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    const auto start = std::chrono::steady_clock::now();
+    slot_freed_.wait(lock, [this] { return in_flight_ < limit_locked(); });
+    stats_.waited += std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+    ++in_flight_;
+    return Permit(this, epoch_);
+}
+
+void ConcurrencyLimiter::release(const Permit &permit, Outcome outcome) {
+    const auto latency = std::chrono::duration<double, std::micro>(
+                             std::chrono::steady_clock::now() - permit.started_)
+                             .count();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const std::size_t in_flight = in_flight_--;
+
+        if (outcome == Outcome::Success) {
+            if (samples_ >= kMinBaselineSamples &&
+                latency > baseline_us_ * options_.latency_tolerance) {
+                outcome = Outcome::Overloaded;
+            }
+            baseline_us_ =
+                samples_ == 0 ? latency : baseline_us_ + (latency - baseline_us_) * kBaselineWeight;
+            ++samples_;
+        }
+
+        const auto min_limit = static_cast<double>(options_.min_limit);
+        const auto max_limit = static_cast<double>(options_.max_limit);
+        if (outcome == Outcome::Overloaded) {
+            // Requests issued before the last decrease saw the old limit; they say nothing new.
+            if (permit.epoch_ == epoch_ && limit_ > min_limit) {
+                limit_ = std::max(min_limit, limit_ * options_.backoff_ratio);
+                ++epoch_;
+                ++stats_.decreases;
+            }
+        } else if (outcome == Outcome::Success && limit_ < max_limit &&
+                   static_cast<double>(in_flight) * 2 >= limit_) {
+            // Only grow a limit that is being used; an idle client proves nothing about it.
+            const std::size_t before = limit_locked();
+            limit_ = std::min(max_limit, limit_ + 1.0 / limit_);
+            if (limit_locked() > before) {
+                ++stats_.increases;
+            }
+        }
+    }
+    slot_freed_.notify_all();
+}
+
+std::size_t ConcurrencyLimiter::limit() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return limit_locked();
+}
+
+ConcurrencyLimiterStats ConcurrencyLimiter::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ConcurrencyLimiterStats stats = stats_;
+    stats.limit = limit_locked();
+    stats.in_flight = in_flight_;
+    stats.baseline_latency =
+        std::chrono::microseconds(static_cast<std::int64_t>(std::llround(baseline_us_)));
+    return stats;
+}
+
+} // namespace massive::core
@@ -51,6 +51,26 @@ ClientConfig& ClientConfig::set_pagination(bool enabled) {
     return *this;
 }
 
+ClientConfig& ClientConfig::set_max_pages(std::size_t pages) {
+    max_pages_ = pages;
+    return *this;
+}
+
+ClientConfig& ClientConfig::set_max_items(std::size_t items) {
+    max_items_ = items;
+    return *this;
+}
+
+ClientConfig& ClientConfig::set_page_prefetch(std::size_t depth) {
+    page_prefetch_ = depth;
+    return *this;
+}
+
+ClientConfig& ClientConfig::set_http_version(HttpVersion version) {
+    http_version_ = version;
+    return *this;
+}
+
 ClientConfig& ClientConfig::set_verbose(bool enabled) {
     verbose_ = enabled;
     // Auto-configure logger level based on verbose flag
@@ -76,6 +96,46 @@ ClientConfig& ClientConfig::set_logger(std::shared_ptr<ILogger> logger) {
     return *this;
 }
 
+ClientConfig& ClientConfig::set_rate_limiter(std::shared_ptr<RateLimiter> limiter) {
+    rate_limiter_ = std::move(limiter);
+    return *this;
+}
+
+ClientConfig& ClientConfig::set_concurrency_limiter(std::shared_ptr<ConcurrencyLimiter> limiter) {
+    concurrency_limiter_ = std::move(limiter);
+    return *this;
+}
+
+ClientConfig& ClientConfig::set_retry_budget(std::shared_ptr<RetryBudget> budget) {
+    retry_budget_ = std::move(budget);
+    return *this;
+}
+
+ClientConfig& ClientConfig::set_circuit_breaker(std::shared_ptr<CircuitBreaker> breaker) {
+    circuit_breaker_ = std::move(breaker);
+    return *this;
+}
+
+ClientConfig& ClientConfig::set_request_observer(std::shared_ptr<IRequestObserver> observer) {
+    request_observer_ = std::move(observer);
+    return *this;
+}
+
+ClientConfig& ClientConfig::set_response_cache(std::shared_ptr<ResponseCache> cache) {
+    response_cache_ = std::move(cache);
+    return *this;
+}
+
+ClientConfig& ClientConfig::set_request_coalescer(std::shared_ptr<RequestCoalescer> coalescer) {
+    request_coalescer_ = std::move(coalescer);
+    return *this;
+}
+
+ClientConfig& ClientConfig::set_bar_store(std::shared_ptr<BarStore> store) {
+    bar_store_ = std::move(store);
+    return *this;
+}
+
 std::string_view ClientConfig::api_key() const noexcept {
     return api_key_;
 }
@@ -92,6 +152,22 @@ bool ClientConfig::pagination() const noexcept {
     return pagination_;
 }
 
+std::size_t ClientConfig::max_pages() const noexcept {
+    return max_pages_;
+}
+
+std::size_t ClientConfig::max_items() const noexcept {
+    return max_items_;
+}
+
+std::size_t ClientConfig::page_prefetch() const noexcept {
+    return page_prefetch_;
+}
+
+HttpVersion ClientConfig::http_version() const noexcept {
+    return http_version_;
+}
+
 bool ClientConfig::verbose() const noexcept {
     return verbose_;
 }
@@ -109,5 +185,37 @@ std::shared_ptr<ILogger> ClientConfig::logger() const noexcept {
     return null_logger;
 }
 
+const std::shared_ptr<RateLimiter>& ClientConfig::rate_limiter() const noexcept {
+    return rate_limiter_;
+}
+
+const std::shared_ptr<ConcurrencyLimiter>& ClientConfig::concurrency_limiter() const noexcept {
+    return concurrency_limiter_;
+}
+
+const std::shared_ptr<RetryBudget>& ClientConfig::retry_budget() const noexcept {
+    return retry_budget_;
+}
+
+const std::shared_ptr<CircuitBreaker>& ClientConfig::circuit_breaker() const noexcept {
+    return circuit_breaker_;
+}
+
+const std::shared_ptr<IRequestObserver>& ClientConfig::request_observer() const noexcept {
+    return request_observer_;
+}
+
+const std::shared_ptr<ResponseCache>& ClientConfig::response_cache() const noexcept {
+    return response_cache_;
+}
+
+const std::shared_ptr<RequestCoalescer>& ClientConfig::request_coalescer() const noexcept {
+    return request_coalescer_;
+}
+
+const std::shared_ptr<BarStore>& ClientConfig::bar_store() const noexcept {
+    return bar_store_;
+}
+
 }  // namespace massive::core
 
@@ -1,33 +1,128 @@
 #include "massive/core/http/beast_transport.hpp"
+#include "massive/core/http/content_decoder.hpp"
 
-#include <boost/asio/connect.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/asio/use_future.hpp>
 #include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/http/buffer_body.hpp>
 #include <boost/beast/http/empty_body.hpp>
 #include <boost/beast/http/string_body.hpp>
 #include <boost/beast/ssl.hpp>
 #include <boost/beast/version.hpp>
 #include <boost/url.hpp>
 
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <cstdlib>
+#include <limits>
+#include <memory>
+#include <optional>
 #include <stdexcept>
+#include <utility>
 
 namespace massive::core {
 
+namespace net = boost::asio;
 namespace ssl = boost::asio::ssl;
 namespace http = boost::beast::http;
 
-BeastHttpTransport::BeastHttpTransport() = default;
+namespace {
+using Clock = std::chrono::steady_clock;
 
-BeastHttpTransport::~BeastHttpTransport() = default;
+// Errors that mean a pooled connection was closed by the server while it sat idle.
+bool is_stale_connection_error(const boost::system::error_code &ec) {
+    return ec == http::error::end_of_stream || ec == boost::asio::error::eof ||
+           ec == boost::asio::error::connection_reset ||
+           ec == boost::asio::error::broken_pipe || ec == ssl::error::stream_truncated;
+}
+
+constexpr std::size_t kBodyChunkSize = 64 * 1024;
+// Identity bodies are read in steps of at most this size, so io_timeout bounds progress rather
+// than the whole body.
+constexpr std::size_t kBodyReadStep = 1024 * 1024;
+
+// Reports a failed operation, as a timeout or cancellation when the deadline closed the socket
+// under it.
+[[noreturn]] void throw_io_error(const RequestDeadline &deadline, const std::string &what,
+                                 const boost::system::error_code &ec) {
+    if (deadline.cancelled()) {
+        throw std::runtime_error("Request cancelled");
+    }
+    if (deadline.expired()) {
+        throw deadline.error();
+    }
+    throw std::runtime_error(what + ec.message());
+}
+
+// Time since `mark`, which then moves up to now.
+std::chrono::microseconds lap(Clock::time_point &mark) {
+    const auto now = Clock::now();
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(now - mark);
+    mark = now;
+    return elapsed;
+}
 
-void BeastHttpTransport::ensure_executor() {
-    if (io_.stopped()) {
-        io_.restart();
+// Makes sure the decoded body has simdjson padding behind it.
+void reserve_padding(std::string &body) {
+    if (body.capacity() < body.size() + kResponseBodyPadding) {
+        body.reserve(body.size() + kResponseBodyPadding);
     }
 }
+} // namespace
+
+BeastHttpTransport::BeastHttpTransport() : BeastHttpTransport(BeastTransportOptions{}) {}
+
+BeastHttpTransport::BeastHttpTransport(BeastTransportOptions options)
+    : options_(std::move(options)),
+      runtime_(options_.runtime ? options_.runtime : IoRuntime::shared()),
+      dns_(options_.dns ? options_.dns : DnsCache::shared()), pool_(options_.pool) {}
+
+BeastHttpTransport::~BeastHttpTransport() {
+    pool_.clear();
+}
 
 HttpResponse BeastHttpTransport::send(const HttpRequest &request) {
-    boost::system::error_code ec;
+    if (runtime_->running_in_this_thread()) {
+        // Blocking here would starve the thread that has to complete the request.
+        throw std::logic_error(
+            "BeastHttpTransport::send called from an I/O thread; use async_send instead");
+    }
+    return net::co_spawn(net::make_strand(runtime_->context()), do_send(request),
+                         net::use_future)
+        .get();
+}
+
+void BeastHttpTransport::async_send(HttpRequest request, HttpResponseHandler handler) {
+    // Keep the transport alive until the handler runs when it is shared-owned.
+    auto self = weak_from_this().lock();
+    net::co_spawn(net::make_strand(runtime_->context()), do_send(std::move(request)),
+                  [self, handler = std::move(handler)](std::exception_ptr error,
+                                                       HttpResponse response) {
+                      handler(error, std::move(response));
+                  });
+}
+
+net::awaitable<HttpResponse> BeastHttpTransport::co_send(HttpRequest request) {
+    co_return co_await net::co_spawn(net::make_strand(runtime_->context()),
+                                     do_send(std::move(request)), net::use_awaitable);
+}
+
+net::awaitable<HttpResponse> BeastHttpTransport::do_send(HttpRequest request) {
+    const auto started = Clock::now();
+    auto executor = co_await net::this_coro::executor;
+    RequestDeadline deadline(executor, request.timeout);
+    if (request.cancellation) {
+        request.cancellation->on_cancel(
+            [executor, cancel = deadline.canceller()] { net::post(executor, cancel); });
+    }
+
     auto parsed = boost::urls::parse_uri(request.url);
     if (!parsed) {
         throw std::invalid_argument("Invalid URL: " + request.url);
@@ -49,28 +144,6 @@ HttpResponse BeastHttpTransport::send(const HttpRequest &request) {
         throw std::runtime_error("Only HTTPS is supported at the moment.");
     }
 
-    ssl::context ctx{ssl::context::sslv23_client};
-    ctx.set_default_verify_paths();
-
-    ensure_executor();
-
-    boost::asio::ip::tcp::resolver resolver{io_};
-    auto const results = resolver.resolve(host, port, ec);
-    if (ec) {
-        throw std::runtime_error("Resolve failed: " + ec.message());
-    }
-
-    ssl::stream<boost::asio::ip::tcp::socket> stream{io_, ctx};
-    boost::asio::connect(stream.next_layer(), results.begin(), results.end(), ec);
-    if (ec) {
-        throw std::runtime_error("Connect failed: " + ec.message());
-    }
-
-    stream.handshake(ssl::stream_base::client, ec);
-    if (ec) {
-        throw std::runtime_error("TLS handshake failed: " + ec.message());
-    }
-
     http::request<http::string_body> req;
 
     switch (request.method) {
@@ -96,40 +169,236 @@ HttpResponse BeastHttpTransport::send(const HttpRequest &request) {
     req.set(http::field::host, host);
     req.set(http::field::user_agent, BOOST_BEAST_VERSION_STRING);
 
+    if (request.base_headers) {
+        for (const auto &[key, value] : *request.base_headers) {
+            req.set(key, value);
+        }
+    }
     for (const auto &[key, value] : request.headers) {
         req.set(key, value);
     }
 
-    req.body() = request.body;
+    req.body() = std::move(request.body);
+    req.keep_alive(true);
     req.prepare_payload();
 
-    http::write(stream, req, ec);
-    if (ec) {
-        throw std::runtime_error("HTTP write failed: " + ec.message());
-    }
+    const std::string key = host + ":" + port;
+    boost::system::error_code ec;
 
-    boost::beast::flat_buffer buffer;
-    http::response<http::string_body> res;
-    http::read(stream, buffer, res, ec);
-    if (ec) {
-        throw std::runtime_error("HTTP read failed: " + ec.message());
+    // A pooled connection may have been closed by the server since its last use. Such
+    // failures are retried on the next idle connection and finally on a fresh one, whose
+    // errors are reported to the caller. Once any of the request has gone out, the server may
+    // have acted on it, so only idempotent methods are sent again.
+    const bool idempotent = request.method == HttpMethod::Get ||
+                            request.method == HttpMethod::Put ||
+                            request.method == HttpMethod::Delete;
+    while (true) {
+        RequestTiming timing;
+        auto connection = pool_.acquire(key);
+        const bool reused = connection != nullptr;
+        if (!reused) {
+            connection = co_await open_connection(host, port, key, deadline, timing);
+        }
+        auto &socket = connection->stream.next_layer();
+
+        auto mark = Clock::now();
+        deadline.begin("write", options_.io_timeout);
+        deadline.watch(socket);
+        const std::size_t bytes_out = co_await http::async_write(
+            connection->stream, req, net::redirect_error(net::use_awaitable, ec));
+        deadline.end();
+        timing.request_write = lap(mark);
+        if (ec) {
+            if (reused && (bytes_out == 0 || idempotent) && !deadline.expired() &&
+                !deadline.cancelled() && is_stale_connection_error(ec)) {
+                continue;
+            }
+            throw_io_error(deadline, "HTTP write failed: ", ec);
+        }
+
+        http::response_parser<http::buffer_body> parser;
+        // Snapshot and trades pages can exceed Beast's 8MB default response limit.
+        parser.body_limit((std::numeric_limits<std::uint64_t>::max)());
+        deadline.begin("header read", options_.io_timeout);
+        deadline.watch(socket);
+        std::size_t bytes_in = co_await http::async_read_header(
+            connection->stream, connection->buffer, parser,
+            net::redirect_error(net::use_awaitable, ec));
+        deadline.end();
+        timing.time_to_first_byte = lap(mark);
+        if (ec) {
+            if (reused && idempotent && !deadline.expired() && !deadline.cancelled() &&
+                is_stale_connection_error(ec)) {
+                continue;
+            }
+            throw_io_error(deadline, "HTTP read failed: ", ec);
+        }
+
+        HttpResponse response;
+        const auto &header = parser.get();
+        response.status_code = static_cast<std::int32_t>(header.result_int());
+
+        std::unique_ptr<ContentDecoder> decoder;
+        const auto encoding_field = header.find(http::field::content_encoding);
+        if (encoding_field != header.end()) {
+            std::string encoding(encoding_field->value());
+            if (ContentDecoder::supports(encoding)) {
+                decoder = std::make_unique<ContentDecoder>(encoding);
+                response.content_encoding = std::move(encoding);
+            }
+        }
+        for (const auto &field : header) {
+            // The body handed back is decoded, so the encoding header no longer applies.
+            if (decoder && field.name() == http::field::content_encoding) {
+                continue;
+            }
+            response.headers.emplace(std::string(field.name_string()), std::string(field.value()));
+        }
+        std::optional<std::size_t> content_length;
+        if (parser.content_length()) {
+            content_length = static_cast<std::size_t>(*parser.content_length());
+        }
+        const bool streaming = request.on_body_chunk && response.status_code >= 200 &&
+                               response.status_code < 300;
+        // Content-Length is the server's word only: at most one read step is reserved up front,
+        // and the body grows as bytes actually arrive.
+        if (!streaming && !decoder && content_length) {
+            response.body.reserve(std::min(*content_length, kBodyReadStep) + kResponseBodyPadding);
+        }
+
+        // Compressed replies stream through a fixed chunk and are decoded as they arrive.
+        // Identity bodies are read straight into the response string, which the REST parsers
+        // then iterate in place, so the payload is never copied after it leaves the socket.
+        // Streamed bodies go through the fixed chunk and are handed on piece by piece.
+        std::array<char, kBodyChunkSize> chunk;
+        std::string decoded;
+        while (!parser.is_done()) {
+            char *destination = chunk.data();
+            std::size_t room = chunk.size();
+            const std::size_t offset = response.body.size();
+            if (!decoder && !streaming) {
+                room = content_length && *content_length > offset
+                           ? std::min(*content_length - offset, kBodyReadStep)
+                           : kBodyChunkSize;
+                if (offset + room + kResponseBodyPadding > response.body.capacity()) {
+                    response.body.reserve(std::max(offset + room + kResponseBodyPadding,
+                                                   response.body.capacity() * 2));
+                }
+                response.body.resize(offset + room);
+                destination = response.body.data() + offset;
+            }
+
+            auto &body = parser.get().body();
+            body.data = destination;
+            body.size = room;
+            deadline.begin("body read", options_.io_timeout);
+            deadline.watch(socket);
+            bytes_in += co_await http::async_read(connection->stream, connection->buffer, parser,
+                                                net::redirect_error(net::use_awaitable, ec));
+            deadline.end();
+            if (ec == http::error::need_buffer) {
+                ec = {};
+            }
+            if (ec) {
+                throw_io_error(deadline, "HTTP read failed: ", ec);
+            }
+
+            const std::size_t received = room - parser.get().body().size;
+            response.wire_body_bytes += received;
+            if (streaming) {
+                std::string_view piece(chunk.data(), received);
+                if (decoder) {
+                    decoded.clear();
+                    decoder->write(chunk.data(), received, decoded);
+                    piece = decoded;
+                }
+                response.decoded_body_bytes += piece.size();
+                if (!piece.empty()) {
+                    request.on_body_chunk(piece);
+                }
+            } else if (decoder) {
+                decoder->write(chunk.data(), received, response.body);
+            } else {
+                response.body.resize(offset + received);
+            }
+        }
+        if (decoder) {
+            decoder->finish();
+        }
+        if (!streaming) {
+            reserve_padding(response.body);
+            response.decoded_body_bytes = response.body.size();
+        }
+        timing.body_download = lap(mark);
+        ++connection->requests_served;
+
+        if (parser.keep_alive()) {
+            pool_.release(std::move(connection));
+        } else {
+            // The server is closing the connection; skip the close_notify exchange.
+            boost::system::error_code close_ec;
+            connection->stream.next_layer().close(close_ec);
+        }
+
+        timing.total = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() -
+                                                                             started);
+        response.timing = timing;
+        response.bytes_sent = bytes_out;
+        response.bytes_received = bytes_in;
+        response.connection_reused = reused;
+        co_return response;
     }
+}
+
+net::awaitable<std::unique_ptr<PooledConnection>>
+BeastHttpTransport::open_connection(const std::string &host, const std::string &port,
+                                    const std::string &key, RequestDeadline &deadline,
+                                    RequestTiming &timing) {
+    // Each step gets what is left of the connect budget.
+    const auto connect_started = Clock::now();
+    auto mark = connect_started;
+    auto remaining = [&] {
+        auto limit = options_.connect_timeout;
+        if (limit.count() > 0) {
+            const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - connect_started);
+            limit = std::max(limit - elapsed, std::chrono::milliseconds{1});
+        }
+        return limit;
+    };
 
-    boost::system::error_code shutdown_ec;
-    stream.shutdown(shutdown_ec);
+    const auto endpoints =
+        co_await dns_->co_resolve(host, port, deadline.begin("resolve", remaining()));
+    timing.dns = lap(mark);
 
-    HttpResponse response;
-    response.status_code = static_cast<std::int32_t>(res.result_int());
-    for (const auto &field : res) {
-        response.headers.emplace(std::string(field.name_string()), std::string(field.value()));
+    auto connection = std::make_unique<PooledConnection>(runtime_->context(), tls_.native(), key);
+    tls_.prepare(connection->stream.native_handle(), host, connection->key);
+
+    co_await async_connect_happy_eyeballs(connection->stream.next_layer(), endpoints,
+                                          options_.connect_attempt_delay,
+                                          deadline.begin("connect", remaining()));
+    timing.connect = lap(mark);
+
+    boost::system::error_code ec;
+    deadline.begin("TLS handshake", remaining());
+    deadline.watch(connection->stream.next_layer());
+    co_await connection->stream.async_handshake(ssl::stream_base::client,
+                                                net::redirect_error(net::use_awaitable, ec));
+    deadline.end();
+    if (ec) {
+        throw_io_error(deadline, "TLS handshake failed: ", ec);
     }
-    response.body = res.body();
-    return response;
+    timing.tls_handshake = lap(mark);
+    tls_.record_handshake(connection->stream.native_handle());
+    co_return connection;
 }
 
 std::shared_ptr<IHttpTransport> make_beast_transport() {
     return std::make_shared<BeastHttpTransport>();
 }
 
-} // namespace massive::core
+std::shared_ptr<IHttpTransport> make_beast_transport(BeastTransportOptions options) {
+    return std::make_shared<BeastHttpTransport>(std::move(options));
+}
 
+} // namespace massive::core
@@ -0,0 +1,341 @@
+#include "massive/core/http/cassette.hpp"
+
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#if defined(_WIN32)
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace massive::core {
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+// File layout: the magic, then one record after another. Integers are little-endian.
+//   u8 method, u32 status, u64 latency in microseconds,
+//   u32 length + request target,
+//   u32 header count, then u32 length + name and u32 length + value for each,
+//   u64 length + body.
+constexpr std::string_view kMagic = "MASSCAS1";
+
+// Replayed bodies are streamed in pieces of this size, like the network transports do.
+constexpr std::size_t kReplayChunkSize = 64 * 1024;
+
+// The request target (path and query) of an absolute URL.
+std::string_view request_target(std::string_view url) {
+    const auto scheme = url.find("://");
+    if (scheme == std::string_view::npos) {
+        return url;
+    }
+    const auto path = url.find('/', scheme + 3);
+    return path == std::string_view::npos ? std::string_view("/") : url.substr(path);
+}
+
+bool is_streamed(const HttpRequest &request, std::int32_t status) {
+    return request.on_body_chunk && status >= 200 && status < 300;
+}
+
+void put_uint(std::string &out, std::uint64_t value, std::size_t bytes) {
+    for (std::size_t i = 0; i < bytes; ++i) {
+        out += static_cast<char>((value >> (8 * i)) & 0xff);
+    }
+}
+
+void put_string(std::string &out, std::string_view value, std::size_t length_bytes) {
+    put_uint(out, value.size(), length_bytes);
+    out.append(value);
+}
+
+// Bounds-checked reads from the mapped cassette.
+class Reader {
+public:
+    Reader(const char *data, std::size_t length) : data_(data), length_(length) {}
+
+    [[nodiscard]] bool done() const noexcept { return position_ == length_; }
+
+    std::uint64_t uint(std::size_t bytes) {
+        const auto raw = take(bytes);
+        std::uint64_t value = 0;
+        for (std::size_t i = 0; i < bytes; ++i) {
+            value |= std::uint64_t{static_cast<unsigned char>(raw[i])} << (8 * i);
+        }
+        return value;
+    }
+
+    std::string_view string(std::size_t length_bytes) {
+        return take(uint(length_bytes));
+    }
+
+    std::string_view take(std::uint64_t count) {
+        if (count > length_ - position_) {
+            throw std::runtime_error("Corrupt cassette: record runs past the end of the file");
+        }
+        std::string_view bytes(data_ + position_, static_cast<std::size_t>(count));
+        position_ += static_cast<std::size_t>(count);
+        return bytes;
+    }
+
+private:
+    const char *data_;
+    std::size_t length_;
+    std::size_t position_{0};
+};
+} // namespace
+
+RecordingTransport::RecordingTransport(std::shared_ptr<IHttpTransport> inner,
+                                       const std::string &path)
+    : inner_(std::move(inner)) {
+    if (!inner_) {
+        throw std::invalid_argument("RecordingTransport needs a transport to record from");
+    }
+    // An existing cassette is appended to; anything else is left alone.
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    const bool fresh = !in || in.tellg() == 0;
+    if (!fresh) {
+        std::string magic(kMagic.size(), '\0');
+        in.seekg(0);
+        if (!in.read(magic.data(), static_cast<std::streamsize>(magic.size())) ||
+            magic != kMagic) {
+            throw std::runtime_error("Not a cassette: " + path);
+        }
+    }
+    in.close();
+
+    out_.open(path, std::ios::binary | std::ios::app);
+    if (!out_) {
+        throw std::runtime_error("Failed to open cassette for writing: " + path);
+    }
+    if (fresh) {
+        out_.write(kMagic.data(), static_cast<std::streamsize>(kMagic.size()));
+        out_.flush();
+    }
+}
+
+HttpRequest RecordingTransport::capture(HttpRequest request,
+                                        const std::shared_ptr<std::string> &body) const {
+    if (request.on_body_chunk) {
+        request.on_body_chunk = [body, forward = std::move(request.on_body_chunk)](
+                                    std::string_view chunk) {
+            body->append(chunk);
+            forward(chunk);
+        };
+    }
+    return request;
+}
+
+HttpResponse RecordingTransport::send(const HttpRequest &request) {
+    auto streamed_body = std::make_shared<std::string>();
+    const auto started = Clock::now();
+    HttpResponse response = inner_->send(capture(request, streamed_body));
+    const auto latency =
+        std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - started);
+    if (response.timing.total.count() == 0) {
+        response.timing.total = latency;
+    }
+    record(request, response, *streamed_body);
+    return response;
+}
+
+void RecordingTransport::async_send(HttpRequest request, HttpResponseHandler handler) {
+    auto streamed_body = std::make_shared<std::string>();
+    auto recorded_request = std::make_shared<HttpRequest>();
+    recorded_request->method = request.method;
+    recorded_request->url = request.url;
+    const auto started = Clock::now();
+    // Keep the recorder alive until the response is written when it is shared-owned.
+    auto self = weak_from_this().lock();
+    inner_->async_send(
+        capture(std::move(request), streamed_body),
+        [this, self, streamed_body, recorded_request, started, handler = std::move(handler)](
+            std::exception_ptr error, HttpResponse response) {
+            if (!error) {
+                if (response.timing.total.count() == 0) {
+                    response.timing.total = std::chrono::duration_cast<std::chrono::microseconds>(
+                        Clock::now() - started);
+                }
+                try {
+                    record(*recorded_request, response, *streamed_body);
+                } catch (...) {
+                    error = std::current_exception();
+                }
+            }
+            handler(error, std::move(response));
+        });
+}
+
+void RecordingTransport::record(const HttpRequest &request, const HttpResponse &response,
+                                const std::string &streamed_body) {
+    const std::string &body =
+        is_streamed(request, response.status_code) ? streamed_body : response.body;
+    std::string entry;
+    entry.reserve(64 + request.url.size() + body.size());
+    put_uint(entry, static_cast<std::uint64_t>(request.method), 1);
+    put_uint(entry, static_cast<std::uint32_t>(response.status_code), 4);
+    put_uint(entry, static_cast<std::uint64_t>(response.timing.total.count()), 8);
+    put_string(entry, request_target(request.url), 4);
+    put_uint(entry, response.headers.size(), 4);
+    for (const auto &[name, value] : response.headers) {
+        put_string(entry, name, 4);
+        put_string(entry, value, 4);
+    }
+    put_string(entry, body, 8);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    out_.write(entry.data(), static_cast<std::streamsize>(entry.size()));
+    out_.flush();
+    if (!out_) {
+        throw std::runtime_error("Failed to write cassette");
+    }
+    ++recorded_;
+}
+
+std::size_t RecordingTransport::recorded() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return recorded_;
+}
+
+ReplayTransport::ReplayTransport(const std::string &path, ReplayOptions options)
+    : options_(options) {
+#if defined(_WIN32)
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Failed to open cassette: " + path);
+    }
+    contents_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    data_ = contents_.data();
+    length_ = contents_.size();
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open cassette: " + path);
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Failed to stat cassette: " + path);
+    }
+    length_ = static_cast<std::size_t>(info.st_size);
+    if (length_ > 0) {
+        void *mapping = ::mmap(nullptr, length_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("Failed to map cassette: " + path);
+        }
+        data_ = static_cast<const char *>(mapping);
+    }
+    ::close(fd);
+#endif
+    try {
+        index();
+    } catch (...) {
+#if !defined(_WIN32)
+        if (data_ != nullptr) {
+            ::munmap(const_cast<char *>(data_), length_);
+        }
+#endif
+        throw;
+    }
+}
+
+ReplayTransport::~ReplayTransport() {
+#if !defined(_WIN32)
+    if (data_ != nullptr) {
+        ::munmap(const_cast<char *>(data_), length_);
+    }
+#endif
+}
+
+void ReplayTransport::index() {
+    Reader reader(data_, length_);
+    if (length_ < kMagic.size() || reader.take(kMagic.size()) != kMagic) {
+        throw std::runtime_error("Not a cassette");
+    }
+    while (!reader.done()) {
+        Exchange exchange;
+        const auto method = reader.uint(1);
+        if (method > static_cast<std::uint64_t>(HttpMethod::Delete)) {
+            throw std::runtime_error("Corrupt cassette: unknown method");
+        }
+        exchange.method = static_cast<HttpMethod>(method);
+        exchange.status_code = static_cast<std::int32_t>(reader.uint(4));
+        exchange.latency = std::chrono::microseconds(static_cast<std::int64_t>(reader.uint(8)));
+        const auto target = reader.string(4);
+        const auto header_count = reader.uint(4);
+        for (std::uint64_t i = 0; i < header_count; ++i) {
+            const auto name = reader.string(4);
+            exchange.headers.emplace_back(name, reader.string(4));
+        }
+        exchange.body = reader.string(8);
+        tracks_[target].exchanges.push_back(std::move(exchange));
+        ++size_;
+    }
+}
+
+HttpResponse ReplayTransport::send(const HttpRequest &request) {
+    if (request.cancellation && request.cancellation->cancelled()) {
+        throw std::runtime_error("Request cancelled");
+    }
+    const auto target = request_target(request.url);
+    auto track = tracks_.find(target);
+    const Exchange *exchange = nullptr;
+    if (track != tracks_.end()) {
+        const auto &exchanges = track->second.exchanges;
+        const std::size_t start = track->second.next.fetch_add(1, std::memory_order_relaxed);
+        for (std::size_t i = 0; i < exchanges.size() && exchange == nullptr; ++i) {
+            const auto &candidate = exchanges[(start + i) % exchanges.size()];
+            if (candidate.method == request.method) {
+                exchange = &candidate;
+            }
+        }
+    }
+    if (exchange == nullptr) {
+        throw std::runtime_error("No recorded response for " + std::string(target));
+    }
+
+    auto delay = options_.latency;
+    if (options_.recorded_latency) {
+        delay += exchange->latency;
+    }
+    if (delay.count() > 0) {
+        std::this_thread::sleep_for(delay);
+    }
+
+    HttpResponse response;
+    response.status_code = exchange->status_code;
+    for (const auto &[name, value] : exchange->headers) {
+        response.headers.emplace(name, value);
+    }
+    const auto body = exchange->body;
+    if (is_streamed(request, response.status_code)) {
+        for (std::size_t offset = 0; offset < body.size(); offset += kReplayChunkSize) {
+            request.on_body_chunk(body.substr(offset, kReplayChunkSize));
+        }
+    } else {
+        response.body.reserve(body.size() + kResponseBodyPadding);
+        response.body.assign(body);
+    }
+    response.wire_body_bytes = body.size();
+    response.decoded_body_bytes = body.size();
+    response.bytes_received = body.size();
+    response.timing.total = delay;
+    return response;
+}
+
+std::shared_ptr<IHttpTransport> make_recording_transport(std::shared_ptr<IHttpTransport> inner,
+                                                         const std::string &path) {
+    return std::make_shared<RecordingTransport>(std::move(inner), path);
+}
+
+std::shared_ptr<IHttpTransport> make_replay_transport(const std::string &path,
+                                                      ReplayOptions options) {
+    return std::make_shared<ReplayTransport>(path, options);
+}
+
+} // namespace massive::core
@@ -0,0 +1,91 @@
+#include "massive/core/http/connection_pool.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace massive::core {
+
+namespace ssl = boost::asio::ssl;
+
+namespace {
+void close_quietly(PooledConnection &connection) {
+    // Idle connections are dropped without a TLS close_notify round trip; the peer
+    // treats the TCP close as the end of the keep-alive session.
+    boost::system::error_code ec;
+    connection.stream.next_layer().close(ec);
+}
+} // namespace
+
+PooledConnection::PooledConnection(boost::asio::io_context &io, ssl::context &ctx,
+                                   std::string connection_key)
+    : key(std::move(connection_key)), stream(io, ctx),
+      last_used(std::chrono::steady_clock::now()) {}
+
+ConnectionPool::ConnectionPool(ConnectionPoolOptions options) : options_(options) {}
+
+std::unique_ptr<PooledConnection> ConnectionPool::acquire(const std::string &key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    evict_expired_locked(std::chrono::steady_clock::now());
+
+    auto it = idle_.find(key);
+    if (it == idle_.end() || it->second.empty()) {
+        return nullptr;
+    }
+
+    auto connection = std::move(it->second.back());
+    it->second.pop_back();
+    return connection;
+}
+
+void ConnectionPool::release(std::unique_ptr<PooledConnection> connection) {
+    if (!connection) {
+        return;
+    }
+    connection->last_used = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto &bucket = idle_[connection->key];
+    if (bucket.size() >= options_.max_idle_per_host) {
+        close_quietly(*connection);
+        return;
+    }
+    bucket.push_back(std::move(connection));
+}
+
+void ConnectionPool::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &[key, bucket] : idle_) {
+        for (auto &connection : bucket) {
+            close_quietly(*connection);
+        }
+    }
+    idle_.clear();
+}
+
+std::size_t ConnectionPool::idle_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::size_t total = 0;
+    for (const auto &[key, bucket] : idle_) {
+        total += bucket.size();
+    }
+    return total;
+}
+
+const ConnectionPoolOptions &ConnectionPool::options() const noexcept {
+    return options_;
+}
+
+void ConnectionPool::evict_expired_locked(std::chrono::steady_clock::time_point now) {
+    for (auto &[key, bucket] : idle_) {
+        auto expired = std::remove_if(bucket.begin(), bucket.end(), [&](const auto &connection) {
+            if (now - connection->last_used < options_.idle_timeout) {
+                return false;
+            }
+            close_quietly(*connection);
+            return true;
+        });
+        bucket.erase(expired, bucket.end());
+    }
+}
+
+} // namespace massive::core
@@ -0,0 +1,131 @@
+#include "massive/core/http/content_decoder.hpp"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+
+namespace massive::core {
+
+namespace {
+bool iequals(std::string_view lhs, std::string_view rhs) noexcept {
+    return lhs.size() == rhs.size() &&
+           std::equal(lhs.begin(), lhs.end(), rhs.begin(), [](char a, char b) {
+               return std::tolower(static_cast<unsigned char>(a)) ==
+                      std::tolower(static_cast<unsigned char>(b));
+           });
+}
+
+bool is_gzip(std::string_view encoding) noexcept {
+    return iequals(encoding, "gzip") || iequals(encoding, "x-gzip");
+}
+
+// "deflate" is supposed to be zlib-wrapped, but some servers send a raw deflate stream.
+bool looks_like_zlib_header(const char *data, std::size_t size) noexcept {
+    if (size < 2) {
+        return true;
+    }
+    const auto cmf = static_cast<unsigned char>(data[0]);
+    const auto flg = static_cast<unsigned char>(data[1]);
+    return (cmf & 0x0f) == Z_DEFLATED && ((cmf << 8) | flg) % 31 == 0;
+}
+
+constexpr std::size_t kMinOutputChunk = 16 * 1024;
+} // namespace
+
+struct ContentDecoder::State {
+    z_stream stream{};
+    bool gzip{false};
+    bool initialized{false};
+    bool finished{false};
+    // A first chunk too short to tell zlib from raw deflate, held until more arrives.
+    std::string lead;
+
+    ~State() {
+        if (initialized) {
+            inflateEnd(&stream);
+        }
+    }
+};
+
+ContentDecoder::ContentDecoder(std::string_view encoding) : state_(std::make_unique<State>()) {
+    if (!supports(encoding)) {
+        throw std::invalid_argument("Unsupported Content-Encoding: " + std::string(encoding));
+    }
+    state_->gzip = is_gzip(encoding);
+}
+
+ContentDecoder::~ContentDecoder() = default;
+
+bool ContentDecoder::supports(std::string_view encoding) noexcept {
+    return is_gzip(encoding) || iequals(encoding, "deflate");
+}
+
+void ContentDecoder::write(const char *data, std::size_t size, std::string &out) {
+    auto &zs = state_->stream;
+    if (size == 0 || state_->finished) {
+        return;
+    }
+
+    std::string joined;
+    if (!state_->initialized) {
+        if (!state_->gzip && state_->lead.size() + size < 2) {
+            state_->lead.append(data, size);
+            return;
+        }
+        if (!state_->lead.empty()) {
+            joined = std::move(state_->lead);
+            joined.append(data, size);
+            data = joined.data();
+            size = joined.size();
+        }
+        // 16 + MAX_WBITS expects a gzip wrapper, MAX_WBITS a zlib one, -MAX_WBITS raw deflate
+        const int window_bits = state_->gzip                       ? 16 + MAX_WBITS
+                                : looks_like_zlib_header(data, size) ? MAX_WBITS
+                                                                     : -MAX_WBITS;
+        if (inflateInit2(&zs, window_bits) != Z_OK) {
+            throw std::runtime_error("Failed to initialise zlib inflate stream");
+        }
+        state_->initialized = true;
+    }
+
+    zs.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+    zs.avail_in = static_cast<uInt>(size);
+
+    // A full output buffer can leave decoded bytes pending inside zlib even once all input
+    // is consumed, so keep going until inflate has room to spare.
+    do {
+        const std::size_t offset = out.size();
+        const std::size_t grow = std::max(size * 4, kMinOutputChunk);
+        out.resize(offset + grow);
+        zs.next_out = reinterpret_cast<Bytef *>(out.data() + offset);
+        zs.avail_out = static_cast<uInt>(grow);
+
+        const uInt avail_in = zs.avail_in;
+        const int rc = inflate(&zs, Z_NO_FLUSH);
+        out.resize(offset + grow - zs.avail_out);
+
+        if (rc == Z_STREAM_END) {
+            // Anything after the end of the compressed stream is ignored.
+            state_->finished = true;
+            return;
+        }
+        if (rc == Z_BUF_ERROR && zs.avail_in == avail_in && zs.avail_out == grow) {
+            // No progress possible until more input arrives.
+            return;
+        }
+        if (rc != Z_OK && rc != Z_BUF_ERROR) {
+            throw std::runtime_error(std::string("Failed to decode response body: ") +
+                                     (zs.msg != nullptr ? zs.msg : "zlib error"));
+        }
+    } while (zs.avail_in > 0 || zs.avail_out == 0);
+}
+
+void ContentDecoder::finish() const {
+    if ((state_->initialized && !state_->finished) || !state_->lead.empty()) {
+        throw std::runtime_error("Failed to decode response body: truncated compressed stream");
+    }
+}
+
+} // namespace massive::core
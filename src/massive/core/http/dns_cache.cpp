@@ -0,0 +1,203 @@
+#include "massive/core/http/dns_cache.hpp"
+#include "massive/exceptions.hpp"
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace massive::core {
+
+namespace net = boost::asio;
+using tcp = net::ip::tcp;
+
+namespace {
+DnsCache::Endpoints to_endpoints(const tcp::resolver::results_type &results) {
+    DnsCache::Endpoints endpoints;
+    endpoints.reserve(results.size());
+    for (const auto &entry : results) {
+        endpoints.push_back(entry.endpoint());
+    }
+    return endpoints;
+}
+
+// State shared by a lookup and the wait for it. Only touched on the race's strand, and kept
+// alive by the lookup, which may finish long after a timed-out wait has given up on it.
+struct Lookup {
+    explicit Lookup(const net::any_io_executor &executor) : resolver(executor), wake(executor) {}
+
+    tcp::resolver resolver;
+    // Cancelled when the lookup finishes.
+    net::steady_timer wake;
+    bool done{false};
+    boost::system::error_code ec;
+    tcp::resolver::results_type results;
+};
+
+net::awaitable<void> run_lookup(std::shared_ptr<Lookup> lookup, std::string host,
+                                std::string port) {
+    boost::system::error_code ec;
+    auto results = co_await lookup->resolver.async_resolve(
+        host, port, net::redirect_error(net::use_awaitable, ec));
+    lookup->done = true;
+    lookup->ec = ec;
+    lookup->results = std::move(results);
+    lookup->wake.cancel();
+}
+
+// Waits for a lookup until `timeout`. Cancelling the resolver cannot interrupt a getaddrinfo
+// call already blocking on asio's resolver thread, so the wait ends on its own timer and a
+// late result is dropped.
+net::awaitable<tcp::resolver::results_type> race_resolve(std::string host, std::string port,
+                                                         std::chrono::milliseconds timeout) {
+    auto executor = co_await net::this_coro::executor;
+    auto lookup = std::make_shared<Lookup>(executor);
+    net::co_spawn(executor, run_lookup(lookup, host, port), net::detached);
+
+    lookup->wake.expires_after(timeout);
+    if (!lookup->done) {
+        boost::system::error_code ec;
+        co_await lookup->wake.async_wait(net::redirect_error(net::use_awaitable, ec));
+    }
+    if (!lookup->done) {
+        lookup->resolver.cancel();
+        throw TimeoutError("resolve", timeout);
+    }
+    if (lookup->ec) {
+        throw std::runtime_error("Resolve failed: " + lookup->ec.message());
+    }
+    co_return lookup->results;
+}
+} // namespace
+
+DnsCache::DnsCache(DnsCacheOptions options, std::shared_ptr<IoRuntime> runtime)
+    : options_(options), runtime_(runtime ? std::move(runtime) : IoRuntime::shared()) {}
+
+std::shared_ptr<DnsCache> DnsCache::shared() {
+    static const auto cache = std::make_shared<DnsCache>();
+    return cache;
+}
+
+net::awaitable<DnsCache::Endpoints> DnsCache::co_resolve(std::string host, std::string port,
+                                                         std::chrono::milliseconds timeout) {
+    Endpoints endpoints;
+    if (lookup(host, port, endpoints)) {
+        co_return endpoints;
+    }
+
+    tcp::resolver::results_type results;
+    if (timeout.count() > 0) {
+        // The race runs on its own strand so the lookup and the wait can share state.
+        auto executor = co_await net::this_coro::executor;
+        results = co_await net::co_spawn(net::make_strand(executor),
+                                         race_resolve(host, port, timeout), net::use_awaitable);
+    } else {
+        boost::system::error_code ec;
+        tcp::resolver resolver{co_await net::this_coro::executor};
+        results = co_await resolver.async_resolve(host, port,
+                                                  net::redirect_error(net::use_awaitable, ec));
+        if (ec) {
+            throw std::runtime_error("Resolve failed: " + ec.message());
+        }
+    }
+    endpoints = to_endpoints(results);
+    store(host + ":" + port, endpoints);
+    co_return endpoints;
+}
+
+DnsCache::Endpoints DnsCache::resolve(const std::string &host, const std::string &port) {
+    Endpoints endpoints;
+    if (lookup(host, port, endpoints)) {
+        return endpoints;
+    }
+
+    boost::system::error_code ec;
+    tcp::resolver resolver{runtime_->context()};
+    auto const results = resolver.resolve(host, port, ec);
+    if (ec) {
+        throw std::runtime_error("Resolve failed: " + ec.message());
+    }
+    endpoints = to_endpoints(results);
+    store(host + ":" + port, endpoints);
+    return endpoints;
+}
+
+void DnsCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+}
+
+DnsCacheStats DnsCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+bool DnsCache::lookup(const std::string &host, const std::string &port, Endpoints &out) {
+    const auto now = std::chrono::steady_clock::now();
+    bool refresh = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(host + ":" + port);
+        if (it == entries_.end() || now >= it->second.expires + options_.stale_grace) {
+            ++stats_.misses;
+            return false;
+        }
+
+        auto &entry = it->second;
+        ++stats_.hits;
+        out = entry.endpoints;
+        if (!entry.refreshing && now + options_.refresh_ahead >= entry.expires) {
+            entry.refreshing = true;
+            refresh = true;
+        }
+    }
+    if (refresh) {
+        refresh_in_background(host, port);
+    }
+    return true;
+}
+
+void DnsCache::store(const std::string &key, const Endpoints &endpoints) {
+    if (endpoints.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto &entry = entries_[key];
+    entry.endpoints = endpoints;
+    entry.expires = std::chrono::steady_clock::now() + options_.ttl;
+    entry.refreshing = false;
+}
+
+void DnsCache::refresh_in_background(const std::string &host, const std::string &port) {
+    auto self = shared_from_this();
+    net::co_spawn(
+        runtime_->context(),
+        [self, host, port]() -> net::awaitable<void> {
+            boost::system::error_code ec;
+            tcp::resolver resolver{co_await net::this_coro::executor};
+            auto const results = co_await resolver.async_resolve(
+                host, port, net::redirect_error(net::use_awaitable, ec));
+
+            const std::string key = host + ":" + port;
+            if (!ec) {
+                self->store(key, to_endpoints(results));
+            }
+            std::lock_guard<std::mutex> lock(self->mutex_);
+            ++self->stats_.refreshes;
+            auto it = self->entries_.find(key);
+            if (it != self->entries_.end()) {
+                // On failure the old addresses keep being served until the grace period ends.
+                it->second.refreshing = false;
+            }
+        },
+        net::detached);
+}
+
+} // namespace massive::core
@@ -0,0 +1,154 @@
+#include "massive/core/http/happy_eyeballs.hpp"
+#include "massive/exceptions.hpp"
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace massive::core {
+
+namespace net = boost::asio;
+using tcp = net::ip::tcp;
+
+namespace {
+// Alternates address families, starting with the family the resolver preferred, while keeping
+// the resolver's order within each family.
+std::vector<tcp::endpoint> interleave_families(const std::vector<tcp::endpoint> &endpoints) {
+    const bool prefer_v6 = endpoints.front().address().is_v6();
+    std::vector<tcp::endpoint> preferred;
+    std::vector<tcp::endpoint> other;
+    for (const auto &endpoint : endpoints) {
+        (endpoint.address().is_v6() == prefer_v6 ? preferred : other).push_back(endpoint);
+    }
+
+    std::vector<tcp::endpoint> ordered;
+    ordered.reserve(endpoints.size());
+    for (std::size_t i = 0; i < std::max(preferred.size(), other.size()); ++i) {
+        if (i < preferred.size()) {
+            ordered.push_back(preferred[i]);
+        }
+        if (i < other.size()) {
+            ordered.push_back(other[i]);
+        }
+    }
+    return ordered;
+}
+
+// State shared by the attempts of one race. Only touched on the race's strand.
+struct Race {
+    explicit Race(const net::any_io_executor &executor) : wake(executor) {}
+
+    // Cancelled by every finished attempt so the coordinator can move on early.
+    net::steady_timer wake;
+    std::vector<std::shared_ptr<tcp::socket>> attempts;
+    std::shared_ptr<tcp::socket> winner;
+    std::size_t pending{0};
+    boost::system::error_code last_error;
+};
+
+net::awaitable<void> attempt(std::shared_ptr<Race> race, std::shared_ptr<tcp::socket> socket,
+                             tcp::endpoint endpoint) {
+    boost::system::error_code ec;
+    co_await socket->async_connect(endpoint, net::redirect_error(net::use_awaitable, ec));
+    --race->pending;
+    if (!ec && !race->winner) {
+        race->winner = socket;
+        for (auto &other : race->attempts) {
+            if (other != socket) {
+                boost::system::error_code ignored;
+                other->close(ignored);
+            }
+        }
+    } else if (ec && ec != net::error::operation_aborted) {
+        race->last_error = ec;
+    }
+    race->wake.cancel();
+}
+
+void abandon(Race &race) {
+    for (auto &socket : race.attempts) {
+        boost::system::error_code ignored;
+        socket->close(ignored);
+    }
+}
+
+net::awaitable<std::shared_ptr<tcp::socket>> race_connect(net::any_io_executor socket_executor,
+                                                         std::vector<tcp::endpoint> endpoints,
+                                                         std::chrono::milliseconds attempt_delay,
+                                                         std::chrono::milliseconds timeout) {
+    using Clock = net::steady_timer::clock_type;
+    const auto deadline =
+        timeout.count() > 0 ? Clock::now() + timeout : Clock::time_point::max();
+
+    auto executor = co_await net::this_coro::executor;
+    auto race = std::make_shared<Race>(executor);
+    boost::system::error_code ec;
+
+    for (const auto &endpoint : endpoints) {
+        auto socket = std::make_shared<tcp::socket>(socket_executor);
+        race->attempts.push_back(socket);
+        ++race->pending;
+        net::co_spawn(executor, attempt(race, socket, endpoint), net::detached);
+
+        race->wake.expires_at(std::min(Clock::now() + attempt_delay, deadline));
+        co_await race->wake.async_wait(net::redirect_error(net::use_awaitable, ec));
+        if (race->winner) {
+            co_return race->winner;
+        }
+        if (Clock::now() >= deadline) {
+            abandon(*race);
+            throw TimeoutError("connect", timeout);
+        }
+    }
+
+    while (!race->winner && race->pending > 0) {
+        race->wake.expires_at(deadline);
+        co_await race->wake.async_wait(net::redirect_error(net::use_awaitable, ec));
+        if (!race->winner && Clock::now() >= deadline) {
+            abandon(*race);
+            throw TimeoutError("connect", timeout);
+        }
+    }
+    if (!race->winner) {
+        throw std::runtime_error("Connect failed: " + race->last_error.message());
+    }
+    co_return race->winner;
+}
+} // namespace
+
+net::awaitable<void> async_connect_happy_eyeballs(tcp::socket &socket,
+                                                  const std::vector<tcp::endpoint> &endpoints,
+                                                  std::chrono::milliseconds attempt_delay,
+                                                  std::chrono::milliseconds timeout) {
+    if (endpoints.empty()) {
+        throw std::runtime_error("Connect failed: no addresses to try");
+    }
+    if (endpoints.size() == 1 && timeout.count() == 0) {
+        boost::system::error_code ec;
+        co_await socket.async_connect(endpoints.front(),
+                                      net::redirect_error(net::use_awaitable, ec));
+        if (ec) {
+            throw std::runtime_error("Connect failed: " + ec.message());
+        }
+        co_return;
+    }
+
+    // The race runs on its own strand so the attempts can share state without locking.
+    auto connected = co_await net::co_spawn(
+        net::make_strand(socket.get_executor()),
+        race_connect(socket.get_executor(), interleave_families(endpoints), attempt_delay,
+                     timeout),
+        net::use_awaitable);
+    socket = std::move(*connected);
+}
+
+} // namespace massive::core
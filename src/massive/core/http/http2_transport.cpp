@@ -0,0 +1,752 @@
+#include "massive/core/http/http2_transport.hpp"
+#include "massive/core/http/content_decoder.hpp"
+#include "massive/core/http/request_deadline.hpp"
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/ssl.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/url.hpp>
+
+#include <nghttp2/nghttp2.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace massive::core {
+
+namespace net = boost::asio;
+namespace ssl = boost::asio::ssl;
+using tcp = net::ip::tcp;
+
+namespace {
+constexpr std::size_t kReadChunkSize = 64 * 1024;
+// Most of a body reserved up front from its content-length; the rest is allocated as it
+// arrives, so a bogus header cannot make the client allocate any amount.
+constexpr std::size_t kMaxBodyReserve = 1024 * 1024;
+
+// ALPN protocol list in wire format: length-prefixed "h2".
+constexpr unsigned char kAlpnH2[] = {2, 'h', '2'};
+
+const char *method_name(HttpMethod method) {
+    switch (method) {
+    case HttpMethod::Get:
+        return "GET";
+    case HttpMethod::Post:
+        return "POST";
+    case HttpMethod::Put:
+        return "PUT";
+    case HttpMethod::Patch:
+        return "PATCH";
+    case HttpMethod::Delete:
+        return "DELETE";
+    }
+    return "GET";
+}
+
+// HTTP/1.1 connection-specific headers are not allowed in HTTP/2 requests.
+bool is_connection_header(std::string_view name) {
+    return name == "connection" || name == "host" || name == "keep-alive" ||
+           name == "proxy-connection" || name == "transfer-encoding" || name == "upgrade";
+}
+
+std::string to_lower(std::string_view value) {
+    std::string lowered(value);
+    for (auto &c : lowered) {
+        if (c >= 'A' && c <= 'Z') {
+            c = static_cast<char>(c - 'A' + 'a');
+        }
+    }
+    return lowered;
+}
+
+void reserve_padding(std::string &body) {
+    if (body.capacity() < body.size() + kResponseBodyPadding) {
+        body.reserve(body.size() + kResponseBodyPadding);
+    }
+}
+
+nghttp2_nv make_nv(const std::string &name, const std::string &value) {
+    nghttp2_nv nv;
+    nv.name = reinterpret_cast<std::uint8_t *>(const_cast<char *>(name.data()));
+    nv.namelen = name.size();
+    nv.value = reinterpret_cast<std::uint8_t *>(const_cast<char *>(value.data()));
+    nv.valuelen = value.size();
+    nv.flags = NGHTTP2_NV_FLAG_NONE;
+    return nv;
+}
+
+struct Target {
+    std::string host;
+    std::string port;
+    std::string authority;
+    std::string path;
+};
+
+Target parse_target(const std::string &url_string) {
+    auto parsed = boost::urls::parse_uri(url_string);
+    if (!parsed) {
+        throw std::invalid_argument("Invalid URL: " + url_string);
+    }
+    boost::urls::url url = parsed.value();
+    auto to_std_string = [](auto view) { return std::string(view.data(), view.size()); };
+
+    if (to_std_string(url.scheme()) != "https") {
+        throw std::runtime_error("HTTP/2 transport only supports HTTPS URLs");
+    }
+    Target target;
+    target.host = to_std_string(url.host());
+    target.port = url.has_port() ? to_std_string(url.port()) : "443";
+    target.authority = url.has_port() ? target.host + ":" + target.port : target.host;
+    const auto resource = url.encoded_resource();
+    target.path = resource.empty() ? "/" : std::string(resource.data(), resource.size());
+    return target;
+}
+} // namespace
+
+// One in-flight request. Owned by its connection until the stream closes.
+struct Http2Stream {
+    HttpRequest request;
+    std::string authority;
+    std::string path;
+    HttpResponseHandler handler;
+    // Keeps the transport (and the TLS context the connection borrows) alive until completion.
+    std::shared_ptr<Http2Transport> owner;
+
+    // Identifies the stream to its timeout and cancellation handlers, which may run after the
+    // stream is gone.
+    std::uint64_t serial{0};
+    // Armed when the request has a timeout; destroying the stream cancels it.
+    std::unique_ptr<net::steady_timer> deadline;
+
+    std::size_t body_offset{0};
+    HttpResponse response;
+    std::unique_ptr<ContentDecoder> decoder;
+    std::exception_ptr error;
+
+    // Whether the body goes to request.on_body_chunk; known once :status has arrived.
+    [[nodiscard]] bool streaming() const {
+        return request.on_body_chunk && response.status_code >= 200 &&
+               response.status_code < 300;
+    }
+};
+
+// A single TLS connection carrying an nghttp2 client session. Every member is touched only
+// on strand_, which serialises nghttp2 calls without a lock.
+class Http2Connection : public std::enable_shared_from_this<Http2Connection> {
+public:
+    Http2Connection(std::shared_ptr<IoRuntime> runtime, std::shared_ptr<TlsContext> tls,
+                    std::string host, std::string port, const Http2TransportOptions &options)
+        : runtime_(std::move(runtime)), tls_(std::move(tls)),
+          strand_(net::make_strand(runtime_->context())), stream_(strand_, tls_->native()),
+          host_(std::move(host)), port_(std::move(port)), key_(host_ + ":" + port_),
+          dns_(options.dns ? options.dns : DnsCache::shared()),
+          connect_attempt_delay_(options.connect_attempt_delay),
+          connect_timeout_(options.connect_timeout),
+          stream_window_size_(options.stream_window_size),
+          connection_window_size_(options.connection_window_size) {}
+
+    ~Http2Connection() {
+        if (session_ != nullptr) {
+            nghttp2_session_del(session_);
+        }
+    }
+
+    Http2Connection(const Http2Connection &) = delete;
+    Http2Connection &operator=(const Http2Connection &) = delete;
+
+    // False once the connection has failed or the server sent GOAWAY.
+    [[nodiscard]] bool accepting() const noexcept {
+        return accepting_.load(std::memory_order_acquire);
+    }
+
+    void submit(std::unique_ptr<Http2Stream> stream) {
+        net::post(strand_, [self = shared_from_this(), stream = std::move(stream)]() mutable {
+            self->on_submit(std::move(stream));
+        });
+    }
+
+    void shutdown() {
+        net::post(strand_, [self = shared_from_this()]() {
+            boost::system::error_code ec;
+            self->stream_.next_layer().close(ec);
+        });
+    }
+
+private:
+    enum class State { Idle, Connecting, Open, Closed };
+
+    void on_submit(std::unique_ptr<Http2Stream> stream) {
+        stream->serial = ++last_serial_;
+        if (stream->request.timeout && stream->request.timeout->count() > 0) {
+            stream->deadline = std::make_unique<net::steady_timer>(strand_);
+            stream->deadline->expires_after(*stream->request.timeout);
+            stream->deadline->async_wait(
+                [self = shared_from_this(), serial = stream->serial,
+                 timeout = *stream->request.timeout](const boost::system::error_code &ec) {
+                    if (!ec) {
+                        auto error = TimeoutError("request", timeout);
+                        self->abandon_stream(serial, std::make_exception_ptr(error));
+                    }
+                });
+        }
+        if (stream->request.cancellation) {
+            // Weak, since the request the stream owns holds on to this handler.
+            stream->request.cancellation->on_cancel(
+                [weak = weak_from_this(), serial = stream->serial] {
+                    if (auto self = weak.lock()) {
+                        net::post(self->strand_, [self, serial] {
+                            auto error = std::runtime_error("Request cancelled");
+                            self->abandon_stream(serial, std::make_exception_ptr(error));
+                        });
+                    }
+                });
+        }
+
+        switch (state_) {
+        case State::Idle:
+            state_ = State::Connecting;
+            queued_.push_back(std::move(stream));
+            net::co_spawn(strand_, run(shared_from_this()), net::detached);
+            break;
+        case State::Connecting:
+            queued_.push_back(std::move(stream));
+            break;
+        case State::Open:
+            start_stream(std::move(stream));
+            flush();
+            break;
+        case State::Closed:
+            stream->error = closed_error_ ? closed_error_
+                                          : std::make_exception_ptr(std::runtime_error(
+                                                "HTTP/2 connection is closed"));
+            complete(std::move(stream));
+            break;
+        }
+    }
+
+    // `self` keeps the connection alive for as long as the coroutine runs.
+    net::awaitable<void> run(std::shared_ptr<Http2Connection> self) {
+        std::exception_ptr error;
+        try {
+            co_await open();
+            state_ = State::Open;
+            auto queued = std::move(queued_);
+            for (auto &stream : queued) {
+                start_stream(std::move(stream));
+            }
+            flush();
+            co_await read_loop();
+        } catch (...) {
+            error = std::current_exception();
+        }
+        self->close(error);
+    }
+
+    // Fails a request that timed out or was cancelled. A stream already sent to the server is
+    // reset; the connection and its other streams carry on.
+    void abandon_stream(std::uint64_t serial, std::exception_ptr error) {
+        auto queued = std::find_if(queued_.begin(), queued_.end(), [serial](const auto &stream) {
+            return stream->serial == serial;
+        });
+        if (queued != queued_.end()) {
+            auto stream = std::move(*queued);
+            queued_.erase(queued);
+            stream->error = std::move(error);
+            complete(std::move(stream));
+            return;
+        }
+        for (auto &[stream_id, stream] : streams_) {
+            if (stream->serial == serial) {
+                // on_stream_close completes it with this error once the reset is sent.
+                stream->error = std::move(error);
+                nghttp2_submit_rst_stream(session_, NGHTTP2_FLAG_NONE, stream_id, NGHTTP2_CANCEL);
+                flush();
+                return;
+            }
+        }
+    }
+
+    net::awaitable<void> open() {
+        // Each step gets what is left of the connect budget.
+        const auto connect_started = std::chrono::steady_clock::now();
+        auto remaining = [&] {
+            auto limit = connect_timeout_;
+            if (limit.count() > 0) {
+                const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - connect_started);
+                limit = std::max(limit - elapsed, std::chrono::milliseconds{1});
+            }
+            return limit;
+        };
+        RequestDeadline deadline(strand_, std::nullopt);
+
+        const auto endpoints =
+            co_await dns_->co_resolve(host_, port_, deadline.begin("resolve", remaining()));
+
+        SSL *native = stream_.native_handle();
+        tls_->prepare(native, host_, key_);
+        if (SSL_set_alpn_protos(native, kAlpnH2, sizeof(kAlpnH2)) != 0) {
+            throw std::runtime_error("Failed to configure ALPN for HTTP/2");
+        }
+
+        co_await async_connect_happy_eyeballs(stream_.next_layer(), endpoints,
+                                              connect_attempt_delay_,
+                                              deadline.begin("connect", remaining()));
+        boost::system::error_code ec;
+        stream_.next_layer().set_option(tcp::no_delay(true), ec);
+
+        deadline.begin("TLS handshake", remaining());
+        deadline.watch(stream_.next_layer());
+        co_await stream_.async_handshake(ssl::stream_base::client,
+                                         net::redirect_error(net::use_awaitable, ec));
+        deadline.end();
+        if (ec) {
+            if (deadline.expired()) {
+                throw deadline.error();
+            }
+            throw std::runtime_error("TLS handshake failed: " + ec.message());
+        }
+        tls_->record_handshake(native);
+
+        const unsigned char *protocol = nullptr;
+        unsigned int protocol_len = 0;
+        SSL_get0_alpn_selected(native, &protocol, &protocol_len);
+        if (protocol_len != 2 || std::memcmp(protocol, "h2", 2) != 0) {
+            throw std::runtime_error("Server " + key_ + " did not negotiate HTTP/2 via ALPN");
+        }
+
+        init_session();
+    }
+
+    void init_session() {
+        nghttp2_session_callbacks *callbacks = nullptr;
+        nghttp2_session_callbacks_new(&callbacks);
+        nghttp2_session_callbacks_set_on_header_callback(callbacks, &on_header);
+        nghttp2_session_callbacks_set_on_data_chunk_recv_callback(callbacks, &on_data_chunk);
+        nghttp2_session_callbacks_set_on_stream_close_callback(callbacks, &on_stream_close);
+        nghttp2_session_callbacks_set_on_frame_recv_callback(callbacks, &on_frame_recv);
+        const int rv = nghttp2_session_client_new(&session_, callbacks, this);
+        nghttp2_session_callbacks_del(callbacks);
+        if (rv != 0) {
+            throw std::runtime_error(std::string("Failed to create HTTP/2 session: ") +
+                                     nghttp2_strerror(rv));
+        }
+
+        const std::array<nghttp2_settings_entry, 2> settings{{
+            {NGHTTP2_SETTINGS_ENABLE_PUSH, 0},
+            {NGHTTP2_SETTINGS_INITIAL_WINDOW_SIZE,
+             static_cast<std::uint32_t>(stream_window_size_)},
+        }};
+        nghttp2_submit_settings(session_, NGHTTP2_FLAG_NONE, settings.data(), settings.size());
+        nghttp2_session_set_local_window_size(session_, NGHTTP2_FLAG_NONE, 0,
+                                              connection_window_size_);
+    }
+
+    net::awaitable<void> read_loop() {
+        std::vector<std::uint8_t> buffer(kReadChunkSize);
+        while (nghttp2_session_want_read(session_) != 0 ||
+               nghttp2_session_want_write(session_) != 0) {
+            boost::system::error_code ec;
+            const std::size_t received = co_await stream_.async_read_some(
+                net::buffer(buffer), net::redirect_error(net::use_awaitable, ec));
+            if (ec) {
+                throw std::runtime_error("HTTP/2 read failed: " + ec.message());
+            }
+            const auto consumed = nghttp2_session_mem_recv(session_, buffer.data(), received);
+            if (consumed < 0) {
+                throw std::runtime_error(std::string("HTTP/2 protocol error: ") +
+                                         nghttp2_strerror(static_cast<int>(consumed)));
+            }
+            flush();
+        }
+    }
+
+    void start_stream(std::unique_ptr<Http2Stream> stream) {
+        if (nghttp2_session_check_request_allowed(session_) == 0) {
+            stream->error = std::make_exception_ptr(
+                std::runtime_error("HTTP/2 connection is going away"));
+            complete(std::move(stream));
+            return;
+        }
+
+        const std::string method = method_name(stream->request.method);
+        const std::string scheme = "https";
+        std::vector<std::pair<std::string, std::string>> fields;
+        const auto &request = stream->request;
+        fields.reserve(request.headers.size() +
+                       (request.base_headers ? request.base_headers->size() : 0));
+        if (request.base_headers) {
+            for (const auto &[name, value] : *request.base_headers) {
+                std::string lowered = to_lower(name);
+                if (!is_connection_header(lowered) && !find_header(request.headers, name)) {
+                    fields.emplace_back(std::move(lowered), value);
+                }
+            }
+        }
+        for (const auto &[name, value] : request.headers) {
+            std::string lowered = to_lower(name);
+            if (!is_connection_header(lowered)) {
+                fields.emplace_back(std::move(lowered), value);
+            }
+        }
+
+        static const std::string kMethod = ":method";
+        static const std::string kScheme = ":scheme";
+        static const std::string kAuthority = ":authority";
+        static const std::string kPath = ":path";
+        std::vector<nghttp2_nv> nva;
+        nva.reserve(fields.size() + 4);
+        nva.push_back(make_nv(kMethod, method));
+        nva.push_back(make_nv(kScheme, scheme));
+        nva.push_back(make_nv(kAuthority, stream->authority));
+        nva.push_back(make_nv(kPath, stream->path));
+        for (const auto &[name, value] : fields) {
+            nva.push_back(make_nv(name, value));
+        }
+
+        nghttp2_data_provider provider{};
+        provider.source.ptr = stream.get();
+        provider.read_callback = &read_request_body;
+        const bool has_body = !stream->request.body.empty();
+
+        const std::int32_t stream_id =
+            nghttp2_submit_request(session_, nullptr, nva.data(), nva.size(),
+                                   has_body ? &provider : nullptr, stream.get());
+        if (stream_id < 0) {
+            stream->error = std::make_exception_ptr(std::runtime_error(
+                std::string("Failed to submit HTTP/2 request: ") + nghttp2_strerror(stream_id)));
+            complete(std::move(stream));
+            return;
+        }
+        streams_.emplace(stream_id, std::move(stream));
+    }
+
+    // Serialises whatever nghttp2 has queued and writes it; one write is in flight at a time.
+    void flush() {
+        if (writing_ || session_ == nullptr || state_ != State::Open) {
+            return;
+        }
+        for (;;) {
+            const std::uint8_t *data = nullptr;
+            const auto size = nghttp2_session_mem_send(session_, &data);
+            if (size < 0) {
+                close(std::make_exception_ptr(std::runtime_error(
+                    std::string("HTTP/2 send failed: ") +
+                    nghttp2_strerror(static_cast<int>(size)))));
+                return;
+            }
+            if (size == 0) {
+                break;
+            }
+            outbox_.append(reinterpret_cast<const char *>(data), static_cast<std::size_t>(size));
+        }
+        if (outbox_.empty()) {
+            return;
+        }
+
+        writing_ = true;
+        net::async_write(stream_, net::buffer(outbox_),
+                         [self = shared_from_this()](const boost::system::error_code &ec,
+                                                     std::size_t) {
+                             self->writing_ = false;
+                             self->outbox_.clear();
+                             if (ec) {
+                                 self->close(std::make_exception_ptr(std::runtime_error(
+                                     "HTTP/2 write failed: " + ec.message())));
+                                 return;
+                             }
+                             self->flush();
+                         });
+    }
+
+    // Fails every outstanding stream and stops accepting new ones.
+    void close(std::exception_ptr error) {
+        accepting_.store(false, std::memory_order_release);
+        if (state_ == State::Closed) {
+            return;
+        }
+        state_ = State::Closed;
+        closed_error_ = error ? error
+                              : std::make_exception_ptr(
+                                    std::runtime_error("HTTP/2 connection closed by server"));
+
+        auto streams = std::move(streams_);
+        auto queued = std::move(queued_);
+        for (auto &entry : streams) {
+            entry.second->error = closed_error_;
+            complete(std::move(entry.second));
+        }
+        for (auto &stream : queued) {
+            stream->error = closed_error_;
+            complete(std::move(stream));
+        }
+
+        boost::system::error_code ec;
+        stream_.next_layer().close(ec);
+    }
+
+    // Handlers run from a fresh strand task so user code never executes inside nghttp2.
+    void complete(std::unique_ptr<Http2Stream> stream) {
+        net::post(strand_, [stream = std::move(stream)]() {
+            auto handler = std::move(stream->handler);
+            if (stream->error) {
+                handler(stream->error, HttpResponse{});
+            } else {
+                handler(nullptr, std::move(stream->response));
+            }
+        });
+    }
+
+    Http2Stream *find_stream(std::int32_t stream_id) {
+        auto it = streams_.find(stream_id);
+        return it == streams_.end() ? nullptr : it->second.get();
+    }
+
+    static int on_header(nghttp2_session *, const nghttp2_frame *frame, const std::uint8_t *name,
+                         std::size_t namelen, const std::uint8_t *value, std::size_t valuelen,
+                         std::uint8_t, void *user_data) {
+        if (frame->hd.type != NGHTTP2_HEADERS) {
+            return 0;
+        }
+        auto *self = static_cast<Http2Connection *>(user_data);
+        Http2Stream *stream = self->find_stream(frame->hd.stream_id);
+        if (stream == nullptr) {
+            return 0;
+        }
+
+        if (stream->error) {
+            return 0;
+        }
+
+        const std::string_view key(reinterpret_cast<const char *>(name), namelen);
+        const std::string_view val(reinterpret_cast<const char *>(value), valuelen);
+        auto &response = stream->response;
+        // Nothing may be thrown through nghttp2's C frames: a failure fails the stream.
+        try {
+            if (key == ":status") {
+                int status = 0;
+                std::from_chars(val.data(), val.data() + val.size(), status);
+                response.status_code = status;
+                return 0;
+            }
+            if (key == "content-encoding" && ContentDecoder::supports(val)) {
+                // The body handed back is decoded, so the encoding header no longer applies.
+                stream->decoder = std::make_unique<ContentDecoder>(val);
+                response.content_encoding = std::string(val);
+                return 0;
+            }
+            if (key == "content-length" && !stream->streaming()) {
+                std::size_t length = 0;
+                std::from_chars(val.data(), val.data() + val.size(), length);
+                response.body.reserve(std::min(length, kMaxBodyReserve) + kResponseBodyPadding);
+            }
+            response.headers.emplace(std::string(key), std::string(val));
+        } catch (...) {
+            stream->error = std::current_exception();
+            nghttp2_submit_rst_stream(self->session_, NGHTTP2_FLAG_NONE, frame->hd.stream_id,
+                                      NGHTTP2_CANCEL);
+        }
+        return 0;
+    }
+
+    static int on_data_chunk(nghttp2_session *, std::uint8_t, std::int32_t stream_id,
+                             const std::uint8_t *data, std::size_t len, void *user_data) {
+        auto *self = static_cast<Http2Connection *>(user_data);
+        Http2Stream *stream = self->find_stream(stream_id);
+        if (stream == nullptr || stream->error) {
+            return 0;
+        }
+        auto &response = stream->response;
+        response.wire_body_bytes += len;
+        try {
+            if (stream->streaming()) {
+                std::string_view piece(reinterpret_cast<const char *>(data), len);
+                if (stream->decoder) {
+                    response.body.clear();
+                    stream->decoder->write(piece.data(), piece.size(), response.body);
+                    piece = response.body;
+                }
+                response.decoded_body_bytes += piece.size();
+                if (!piece.empty()) {
+                    stream->request.on_body_chunk(piece);
+                }
+                response.body.clear();
+            } else if (stream->decoder) {
+                stream->decoder->write(reinterpret_cast<const char *>(data), len, response.body);
+            } else {
+                response.body.append(reinterpret_cast<const char *>(data), len);
+            }
+        } catch (...) {
+            // The rest of the body is of no use, so it is not downloaded.
+            stream->error = std::current_exception();
+            nghttp2_submit_rst_stream(self->session_, NGHTTP2_FLAG_NONE, stream_id, NGHTTP2_CANCEL);
+        }
+        return 0;
+    }
+
+    static int on_stream_close(nghttp2_session *, std::int32_t stream_id,
+                               std::uint32_t error_code, void *user_data) {
+        auto *self = static_cast<Http2Connection *>(user_data);
+        auto it = self->streams_.find(stream_id);
+        if (it == self->streams_.end()) {
+            return 0;
+        }
+        auto stream = std::move(it->second);
+        self->streams_.erase(it);
+
+        if (!stream->error && error_code != NGHTTP2_NO_ERROR) {
+            stream->error = std::make_exception_ptr(
+                std::runtime_error(std::string("HTTP/2 stream reset: ") +
+                                   nghttp2_http2_strerror(error_code)));
+        }
+        if (!stream->error) {
+            try {
+                if (stream->decoder) {
+                    stream->decoder->finish();
+                }
+                if (!stream->streaming()) {
+                    reserve_padding(stream->response.body);
+                    stream->response.decoded_body_bytes = stream->response.body.size();
+                }
+            } catch (...) {
+                stream->error = std::current_exception();
+            }
+        }
+        self->complete(std::move(stream));
+        return 0;
+    }
+
+    static int on_frame_recv(nghttp2_session *, const nghttp2_frame *frame, void *user_data) {
+        if (frame->hd.type == NGHTTP2_GOAWAY) {
+            // Streams already accepted finish; new requests go to a fresh connection.
+            static_cast<Http2Connection *>(user_data)->accepting_.store(
+                false, std::memory_order_release);
+        }
+        return 0;
+    }
+
+    static ssize_t read_request_body(nghttp2_session *, std::int32_t, std::uint8_t *buf,
+                                     std::size_t length, std::uint32_t *data_flags,
+                                     nghttp2_data_source *source, void *) {
+        auto *stream = static_cast<Http2Stream *>(source->ptr);
+        const std::string &body = stream->request.body;
+        const std::size_t count = std::min(length, body.size() - stream->body_offset);
+        std::memcpy(buf, body.data() + stream->body_offset, count);
+        stream->body_offset += count;
+        if (stream->body_offset == body.size()) {
+            *data_flags |= NGHTTP2_DATA_FLAG_EOF;
+        }
+        return static_cast<ssize_t>(count);
+    }
+
+    std::shared_ptr<IoRuntime> runtime_;
+    std::shared_ptr<TlsContext> tls_;
+    net::strand<net::io_context::executor_type> strand_;
+    ssl::stream<tcp::socket> stream_;
+    std::string host_;
+    std::string port_;
+    std::string key_;
+    std::shared_ptr<DnsCache> dns_;
+    std::chrono::milliseconds connect_attempt_delay_;
+    std::chrono::milliseconds connect_timeout_;
+    std::int32_t stream_window_size_;
+    std::int32_t connection_window_size_;
+
+    nghttp2_session *session_{nullptr};
+    State state_{State::Idle};
+    std::atomic<bool> accepting_{true};
+    std::exception_ptr closed_error_;
+    std::vector<std::unique_ptr<Http2Stream>> queued_;
+    std::unordered_map<std::int32_t, std::unique_ptr<Http2Stream>> streams_;
+    std::string outbox_;
+    bool writing_{false};
+    std::uint64_t last_serial_{0};
+};
+
+Http2Transport::Http2Transport() : Http2Transport(Http2TransportOptions{}) {}
+
+Http2Transport::Http2Transport(Http2TransportOptions options)
+    : options_(std::move(options)),
+      runtime_(options_.runtime ? options_.runtime : IoRuntime::shared()),
+      tls_(std::make_shared<TlsContext>()) {}
+
+Http2Transport::~Http2Transport() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &[key, connection] : connections_) {
+        connection->shutdown();
+    }
+}
+
+HttpResponse Http2Transport::send(const HttpRequest &request) {
+    if (runtime_->running_in_this_thread()) {
+        // Blocking here would starve the thread that has to complete the request.
+        throw std::logic_error(
+            "Http2Transport::send called from an I/O thread; use async_send instead");
+    }
+    return send_async(request).get();
+}
+
+void Http2Transport::async_send(HttpRequest request, HttpResponseHandler handler) {
+    Target target;
+    try {
+        target = parse_target(request.url);
+    } catch (...) {
+        handler(std::current_exception(), HttpResponse{});
+        return;
+    }
+
+    auto stream = std::make_unique<Http2Stream>();
+    stream->request = std::move(request);
+    stream->authority = std::move(target.authority);
+    stream->path = std::move(target.path);
+    stream->handler = std::move(handler);
+    stream->owner = weak_from_this().lock();
+    connection_for(target.host, target.port)->submit(std::move(stream));
+}
+
+std::size_t Http2Transport::connection_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::size_t count = 0;
+    for (const auto &[key, connection] : connections_) {
+        if (connection->accepting()) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+std::shared_ptr<Http2Connection> Http2Transport::connection_for(const std::string &host,
+                                                                const std::string &port) {
+    const std::string key = host + ":" + port;
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto &connection = connections_[key];
+    if (!connection || !connection->accepting()) {
+        connection = std::make_shared<Http2Connection>(runtime_, tls_, host, port, options_);
+    }
+    return connection;
+}
+
+std::shared_ptr<IHttpTransport> make_http2_transport() {
+    return std::make_shared<Http2Transport>();
+}
+
+std::shared_ptr<IHttpTransport> make_http2_transport(Http2TransportOptions options) {
+    return std::make_shared<Http2Transport>(std::move(options));
+}
+
+} // namespace massive::core
@@ -0,0 +1,87 @@
+#include "massive/core/http/request_deadline.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace massive::core {
+
+RequestDeadline::RequestDeadline(const boost::asio::any_io_executor &executor,
+                                 std::optional<std::chrono::milliseconds> overall)
+    : state_(std::make_shared<State>(executor)) {
+    if (overall && overall->count() > 0) {
+        overall_deadline_ = Clock::now() + *overall;
+        overall_limit_ = *overall;
+    }
+}
+
+RequestDeadline::~RequestDeadline() { end(); }
+
+std::chrono::milliseconds RequestDeadline::begin(const std::string &phase,
+                                                 std::chrono::milliseconds limit) {
+    if (state_->cancelled) {
+        throw std::runtime_error("Request cancelled");
+    }
+    const auto now = Clock::now();
+    phase_ = phase;
+    phase_limit_ = limit;
+    phase_deadline_ = limit.count() > 0 ? now + limit : Clock::time_point::max();
+    if (overall_deadline_ && *overall_deadline_ <= phase_deadline_) {
+        // The request as a whole runs out first, so that is what gets reported.
+        phase_ = "request";
+        phase_limit_ = overall_limit_;
+        phase_deadline_ = *overall_deadline_;
+    }
+
+    if (phase_deadline_ == Clock::time_point::max()) {
+        return std::chrono::milliseconds::zero();
+    }
+    if (phase_deadline_ <= now) {
+        throw error();
+    }
+    return std::max(std::chrono::ceil<std::chrono::milliseconds>(phase_deadline_ - now),
+                    std::chrono::milliseconds{1});
+}
+
+void RequestDeadline::watch(boost::asio::ip::tcp::socket &socket) {
+    end();
+    state_->socket = &socket;
+    if (phase_deadline_ == Clock::time_point::max()) {
+        return;
+    }
+
+    state_->timer.expires_at(phase_deadline_);
+    state_->timer.async_wait(
+        [state = state_, generation = state_->generation](const boost::system::error_code &ec) {
+            // A completion that was already queued when end() ran belongs to an older phase.
+            if (ec || state->generation != generation || state->socket == nullptr) {
+                return;
+            }
+            state->expired = true;
+            boost::system::error_code ignored;
+            state->socket->close(ignored);
+        });
+}
+
+void RequestDeadline::end() {
+    ++state_->generation;
+    state_->socket = nullptr;
+    state_->timer.cancel();
+}
+
+std::function<void()> RequestDeadline::canceller() const {
+    return [state = state_] {
+        state->cancelled = true;
+        if (state->socket != nullptr) {
+            boost::system::error_code ignored;
+            state->socket->close(ignored);
+        }
+    };
+}
+
+bool RequestDeadline::expired() const noexcept { return state_->expired; }
+
+bool RequestDeadline::cancelled() const noexcept { return state_->cancelled; }
+
+TimeoutError RequestDeadline::error() const { return TimeoutError(phase_, phase_limit_); }
+
+} // namespace massive::core
@@ -0,0 +1,102 @@
+#include "massive/core/http/tls_context.hpp"
+
+#include <stdexcept>
+
+namespace massive::core {
+
+namespace ssl = boost::asio::ssl;
+
+namespace {
+// ex_data slots: the owning TlsContext on the SSL_CTX and the session key on each SSL.
+int context_index() {
+    static const int index = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+    return index;
+}
+
+int key_index() {
+    static const int index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+    return index;
+}
+} // namespace
+
+TlsContext::TlsContext() : ctx_(ssl::context::sslv23_client) {
+    ctx_.set_default_verify_paths();
+
+    // Sessions are handed to on_new_session as they arrive (TLS 1.3 tickets come after
+    // the handshake) and kept in our own per-host map rather than OpenSSL's cache.
+    SSL_CTX *native_ctx = ctx_.native_handle();
+    SSL_CTX_set_ex_data(native_ctx, context_index(), this);
+    SSL_CTX_set_session_cache_mode(native_ctx,
+                                   SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+    SSL_CTX_sess_set_new_cb(native_ctx, &TlsContext::on_new_session);
+}
+
+TlsContext::~TlsContext() {
+    SSL_CTX_sess_set_new_cb(ctx_.native_handle(), nullptr);
+    clear_sessions();
+}
+
+void TlsContext::prepare(SSL *ssl, const std::string &host, const std::string &key) {
+    // SSL_set_tlsext_host_name, spelled out: the macro uses a C-style cast.
+    if (!SSL_ctrl(ssl, SSL_CTRL_SET_TLSEXT_HOSTNAME, TLSEXT_NAMETYPE_host_name,
+                  const_cast<char *>(host.c_str()))) {
+        throw std::runtime_error("Failed to set TLS SNI hostname: " + host);
+    }
+    SSL_set_ex_data(ssl, key_index(), const_cast<std::string *>(&key));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = sessions_.find(key);
+    if (it != sessions_.end()) {
+        SSL_set_session(ssl, it->second);
+    }
+}
+
+void TlsContext::record_handshake(SSL *ssl) {
+    if (SSL_session_reused(ssl)) {
+        resumed_handshakes_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        full_handshakes_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+TlsHandshakeStats TlsContext::handshake_stats() const noexcept {
+    TlsHandshakeStats stats;
+    stats.full = full_handshakes_.load(std::memory_order_relaxed);
+    stats.resumed = resumed_handshakes_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void TlsContext::clear_sessions() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &[key, session] : sessions_) {
+        SSL_SESSION_free(session);
+    }
+    sessions_.clear();
+}
+
+int TlsContext::on_new_session(SSL *ssl, SSL_SESSION *session) {
+    auto *self = static_cast<TlsContext *>(
+        SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), context_index()));
+    auto *key = static_cast<const std::string *>(SSL_get_ex_data(ssl, key_index()));
+    if (self == nullptr || key == nullptr || !SSL_SESSION_is_resumable(session)) {
+        return 0;
+    }
+    // Keep a private copy: OpenSSL marks the original non-resumable when its connection is
+    // dropped without close_notify, which is how idle pooled connections are discarded.
+    SSL_SESSION *copy = SSL_SESSION_dup(session);
+    if (copy != nullptr) {
+        self->store_session(*key, copy);
+    }
+    return 0;
+}
+
+void TlsContext::store_session(const std::string &key, SSL_SESSION *session) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto [it, inserted] = sessions_.try_emplace(key, session);
+    if (!inserted) {
+        SSL_SESSION_free(it->second);
+        it->second = session;
+    }
+}
+
+} // namespace massive::core
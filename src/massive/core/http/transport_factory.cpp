@@ -0,0 +1,27 @@
+#include "massive/core/http/transport_factory.hpp"
+
+#include "massive/core/http/beast_transport.hpp"
+#ifdef MASSIVE_HAS_HTTP2
+#include "massive/core/http/http2_transport.hpp"
+#endif
+
+#include <stdexcept>
+
+namespace massive::core {
+
+std::shared_ptr<IHttpTransport> make_transport(const ClientConfig &config) {
+    switch (config.http_version()) {
+    case HttpVersion::Http2:
+#ifdef MASSIVE_HAS_HTTP2
+        return make_http2_transport();
+#else
+        throw std::runtime_error(
+            "HTTP/2 transport is not available; rebuild with MASSIVE_ENABLE_HTTP2=ON");
+#endif
+    case HttpVersion::Http1_1:
+        break;
+    }
+    return make_beast_transport();
+}
+
+} // namespace massive::core
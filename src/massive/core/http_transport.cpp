@@ -1,8 +1,77 @@
 #include "massive/core/http_transport.hpp"
 
+#include <algorithm>
+#include <memory>
+#include <utility>
+
 namespace massive::core {
 
-// Intentionally left blank until concrete transports are implemented.
+std::optional<std::string_view> find_header(const std::map<std::string, std::string> &headers,
+                                            std::string_view name) {
+    auto lower = [](char c) { return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c; };
+    for (const auto &[key, value] : headers) {
+        if (key.size() == name.size() &&
+            std::equal(key.begin(), key.end(), name.begin(),
+                       [&](char a, char b) { return lower(a) == lower(b); })) {
+            return std::string_view(value);
+        }
+    }
+    return std::nullopt;
+}
 
-}  // namespace massive::core
+void RequestCancellation::cancel() {
+    std::function<void()> handler;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (cancelled_) {
+            return;
+        }
+        cancelled_ = true;
+        handler = std::move(handler_);
+    }
+    if (handler) {
+        handler();
+    }
+}
+
+bool RequestCancellation::cancelled() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cancelled_;
+}
+
+void RequestCancellation::on_cancel(std::function<void()> handler) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!cancelled_) {
+            handler_ = std::move(handler);
+            return;
+        }
+    }
+    handler();
+}
 
+void IHttpTransport::async_send(HttpRequest request, HttpResponseHandler handler) {
+    HttpResponse response;
+    try {
+        response = send(request);
+    } catch (...) {
+        handler(std::current_exception(), HttpResponse{});
+        return;
+    }
+    handler(nullptr, std::move(response));
+}
+
+std::future<HttpResponse> IHttpTransport::send_async(HttpRequest request) {
+    auto promise = std::make_shared<std::promise<HttpResponse>>();
+    auto future = promise->get_future();
+    async_send(std::move(request), [promise](std::exception_ptr error, HttpResponse response) {
+        if (error) {
+            promise->set_exception(error);
+        } else {
+            promise->set_value(std::move(response));
+        }
+    });
+    return future;
+}
+
+}  // namespace massive::core
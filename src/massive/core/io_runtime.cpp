@@ -0,0 +1,38 @@
+#include "massive/core/io_runtime.hpp"
+
+#include <algorithm>
+
+namespace massive::core {
+
+IoRuntime::IoRuntime(std::size_t threads) : work_(boost::asio::make_work_guard(io_)) {
+    threads = std::max<std::size_t>(threads, 1);
+    threads_.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+        threads_.emplace_back([this]() { io_.run(); });
+    }
+}
+
+IoRuntime::~IoRuntime() {
+    work_.reset();
+    io_.stop();
+    for (auto &thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+bool IoRuntime::running_in_this_thread() const noexcept {
+    return work_.get_executor().running_in_this_thread();
+}
+
+std::shared_ptr<IoRuntime> IoRuntime::shared() {
+    static auto runtime = std::make_shared<IoRuntime>();
+    return runtime;
+}
+
+std::size_t IoRuntime::default_thread_count() noexcept {
+    return std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+}  // namespace massive::core
@@ -0,0 +1,182 @@
+#include "massive/core/rate_limiter.hpp"
+#include "massive/core/http_transport.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+namespace massive::core {
+
+namespace {
+std::optional<double> parse_number(std::string_view value) {
+    while (!value.empty() && value.front() == ' ') {
+        value.remove_prefix(1);
+    }
+    double number = 0;
+    auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), number);
+    if (ec != std::errc{} || end == value.data()) {
+        return std::nullopt;
+    }
+    return number;
+}
+
+std::optional<std::string_view> find_either(const std::map<std::string, std::string> &headers,
+                                            std::string_view name, std::string_view alternative) {
+    auto value = find_header(headers, name);
+    return value ? value : find_header(headers, alternative);
+}
+
+// Reset headers carry either seconds until the window resets or an epoch timestamp.
+std::optional<double> seconds_until_reset(std::string_view value) {
+    auto reset = parse_number(value);
+    if (!reset) {
+        return std::nullopt;
+    }
+    constexpr double kEpochThreshold = 1e9;
+    if (*reset > kEpochThreshold) {
+        const auto now = std::chrono::duration<double>(
+            std::chrono::system_clock::now().time_since_epoch());
+        return std::max(0.0, *reset - now.count());
+    }
+    return *reset;
+}
+
+std::chrono::steady_clock::duration to_duration(double seconds) {
+    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(seconds));
+}
+} // namespace
+
+RateLimiter::RateLimiter(RateLimiterOptions options)
+    : options_(options), rate_(options.requests_per_second) {}
+
+RateLimiter::Clock::time_point RateLimiter::next_slot_locked(Clock::time_point now) const {
+    const auto ahead = to_duration(std::max(options_.burst - 1.0, 0.0) / rate_);
+    return std::max({now, paused_until_, schedule_ - ahead});
+}
+
+void RateLimiter::claim_locked(Clock::time_point slot) {
+    schedule_ = std::max(schedule_, slot) + to_duration(1.0 / rate_);
+    ++stats_.requests;
+}
+
+void RateLimiter::set_rate_locked(double rate, Clock::time_point now) {
+    // Requests already scheduled were spaced at the old rate; respace them at the new one.
+    if (schedule_ > now) {
+        schedule_ = now + to_duration(std::chrono::duration<double>(schedule_ - now).count() *
+                                      rate_ / rate);
+    }
+    rate_ = rate;
+}
+
+void RateLimiter::acquire() {
+    Clock::time_point slot;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto now = Clock::now();
+        slot = next_slot_locked(now);
+        claim_locked(slot);
+        if (slot > now) {
+            stats_.waited += std::chrono::duration_cast<std::chrono::milliseconds>(slot - now);
+        }
+    }
+    std::this_thread::sleep_until(slot);
+}
+
+bool RateLimiter::try_acquire() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto now = Clock::now();
+    const auto slot = next_slot_locked(now);
+    if (slot > now) {
+        return false;
+    }
+    claim_locked(slot);
+    return true;
+}
+
+void RateLimiter::observe(int status_code, const std::map<std::string, std::string> &headers) {
+    const auto now = Clock::now();
+    std::optional<std::chrono::milliseconds> retry_after;
+    if (auto value = find_header(headers, "Retry-After")) {
+        retry_after = parse_retry_after(*value);
+    }
+    std::optional<double> remaining;
+    std::optional<double> reset;
+    if (auto value = find_either(headers, "X-RateLimit-Remaining", "RateLimit-Remaining")) {
+        remaining = parse_number(*value);
+    }
+    if (auto value = find_either(headers, "X-RateLimit-Reset", "RateLimit-Reset")) {
+        reset = seconds_until_reset(*value);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (retry_after) {
+        paused_until_ = std::max(paused_until_, now + *retry_after);
+    }
+    if (status_code == 429) {
+        ++stats_.throttled;
+    }
+
+    if (remaining && reset && *reset > 0) {
+        if (*remaining >= 1) {
+            // Spread what is left of the quota evenly over the rest of the window.
+            set_rate_locked(*remaining / *reset, now);
+        } else {
+            paused_until_ = std::max(paused_until_, now + to_duration(*reset));
+        }
+        return;
+    }
+    if (status_code == 429) {
+        set_rate_locked(std::max(options_.min_requests_per_second, rate_ / 2), now);
+        if (!retry_after) {
+            paused_until_ = std::max(paused_until_, now + to_duration(1.0 / rate_));
+        }
+    } else if (status_code < 400) {
+        // Additive recovery: about twenty successes bring a halved rate back to the ceiling.
+        set_rate_locked(
+            std::min(options_.requests_per_second, rate_ + options_.requests_per_second / 20),
+            now);
+    }
+}
+
+double RateLimiter::rate() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return rate_;
+}
+
+RateLimiterStats RateLimiter::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+std::optional<std::chrono::milliseconds> parse_retry_after(std::string_view value) {
+    if (auto seconds = parse_number(value)) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::duration<double>(std::max(*seconds, 0.0)));
+    }
+
+    // IMF-fixdate, e.g. "Wed, 21 Oct 2015 07:28:00 GMT".
+    std::tm tm{};
+    std::istringstream in{std::string(value)};
+    in >> std::get_time(&tm, "%a, %d %b %Y %H:%M:%S");
+    if (in.fail()) {
+        return std::nullopt;
+    }
+    // From the UTC calendar fields directly: timegm is not available everywhere.
+    const std::chrono::year_month_day date{std::chrono::year(tm.tm_year + 1900),
+                                           std::chrono::month(static_cast<unsigned>(tm.tm_mon + 1)),
+                                           std::chrono::day(static_cast<unsigned>(tm.tm_mday))};
+    if (!date.ok()) {
+        return std::nullopt;
+    }
+    const auto at = std::chrono::sys_days(date) + std::chrono::hours(tm.tm_hour) +
+                    std::chrono::minutes(tm.tm_min) + std::chrono::seconds(tm.tm_sec);
+    const auto delay = at - std::chrono::system_clock::now();
+    return std::max(std::chrono::duration_cast<std::chrono::milliseconds>(delay),
+                    std::chrono::milliseconds::zero());
+}
+
+} // namespace massive::core
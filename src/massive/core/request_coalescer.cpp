@@ -0,0 +1,48 @@
+#include "massive/core/request_coalescer.hpp"
+
+#include <exception>
+#include <utility>
+
+namespace massive::core {
+
+HttpResponse RequestCoalescer::run(const std::string &key,
+                                   const std::function<HttpResponse()> &fetch) {
+    std::promise<HttpResponse> promise;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto it = in_flight_.find(key);
+        if (it != in_flight_.end()) {
+            auto pending = it->second;
+            ++stats_.coalesced;
+            lock.unlock();
+            return pending.get();
+        }
+        in_flight_.emplace(key, promise.get_future().share());
+        ++stats_.leaders;
+    }
+
+    // The key is released before waiters are woken, so a call arriving after the response
+    // was delivered sends a new request rather than reusing it.
+    auto release = [&]() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        in_flight_.erase(key);
+    };
+    HttpResponse response;
+    try {
+        response = fetch();
+    } catch (...) {
+        release();
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+    release();
+    promise.set_value(response);
+    return response;
+}
+
+RequestCoalescerStats RequestCoalescer::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+} // namespace massive::core
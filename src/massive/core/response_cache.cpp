@@ -0,0 +1,121 @@
+#include "massive/core/response_cache.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+namespace massive::core {
+
+ResponseCache::ResponseCache(ResponseCacheOptions options) : options_(std::move(options)) {
+    options_.shards = std::max<std::size_t>(options_.shards, 1);
+    max_entries_per_shard_ = std::max<std::size_t>(options_.max_entries / options_.shards, 1);
+    max_bytes_per_shard_ = std::max<std::size_t>(options_.max_bytes / options_.shards, 1);
+    shards_.reserve(options_.shards);
+    for (std::size_t i = 0; i < options_.shards; ++i) {
+        shards_.push_back(std::make_unique<Shard>());
+    }
+}
+
+std::chrono::seconds ResponseCache::ttl(std::string_view path) const {
+    std::chrono::seconds ttl = options_.default_ttl;
+    std::size_t longest = 0;
+    for (const auto &[prefix, prefix_ttl] : options_.ttls) {
+        if (prefix.size() >= longest && path.substr(0, prefix.size()) == prefix) {
+            longest = prefix.size();
+            ttl = prefix_ttl;
+        }
+    }
+    return ttl;
+}
+
+ResponseCache::Shard &ResponseCache::shard_for(const std::string &key) {
+    return *shards_[std::hash<std::string>{}(key) % shards_.size()];
+}
+
+std::shared_ptr<const CachedResponse> ResponseCache::find(const std::string &key) {
+    auto &shard = shard_for(key);
+    std::shared_ptr<const CachedResponse> entry;
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.index.find(key);
+        if (it != shard.index.end()) {
+            shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+            entry = it->second->second;
+        }
+    }
+    if (entry && Clock::now() < entry->expires) {
+        hits_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return entry;
+}
+
+void ResponseCache::store(const std::string &key, CachedResponse entry) {
+    auto &shard = shard_for(key);
+    auto shared = std::make_shared<const CachedResponse>(std::move(entry));
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(key);
+    if (it != shard.index.end()) {
+        shard.bytes -= it->second->second->bytes;
+        it->second->second = std::move(shared);
+        shard.bytes += it->second->second->bytes;
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+    } else {
+        shard.lru.emplace_front(key, std::move(shared));
+        shard.index.emplace(shard.lru.front().first, shard.lru.begin());
+        shard.bytes += shard.lru.front().second->bytes;
+    }
+    evict_locked(shard);
+}
+
+void ResponseCache::revalidate(const std::string &key, std::chrono::seconds ttl) {
+    auto &shard = shard_for(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(key);
+    if (it == shard.index.end()) {
+        return;
+    }
+    auto refreshed = std::make_shared<CachedResponse>(*it->second->second);
+    refreshed->expires = Clock::now() + ttl;
+    it->second->second = std::move(refreshed);
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+    revalidated_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ResponseCache::evict_locked(Shard &shard) {
+    // The newest entry stays even if it alone exceeds the byte limit.
+    while (shard.lru.size() > 1 &&
+           (shard.lru.size() > max_entries_per_shard_ || shard.bytes > max_bytes_per_shard_)) {
+        auto &oldest = shard.lru.back();
+        shard.bytes -= oldest.second->bytes;
+        shard.index.erase(oldest.first);
+        shard.lru.pop_back();
+        evictions_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void ResponseCache::clear() {
+    for (auto &shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        shard->index.clear();
+        shard->lru.clear();
+        shard->bytes = 0;
+    }
+}
+
+ResponseCacheStats ResponseCache::stats() const {
+    ResponseCacheStats stats;
+    stats.hits = hits_.load(std::memory_order_relaxed);
+    stats.misses = misses_.load(std::memory_order_relaxed);
+    stats.revalidated = revalidated_.load(std::memory_order_relaxed);
+    stats.evictions = evictions_.load(std::memory_order_relaxed);
+    for (const auto &shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        stats.entries += shard->lru.size();
+        stats.bytes += shard->bytes;
+    }
+    return stats;
+}
+
+} // namespace massive::core
@@ -0,0 +1,56 @@
+#include "massive/core/retry_budget.hpp"
+
+#include <algorithm>
+
+namespace massive::core {
+
+RetryBudget::RetryBudget(RetryBudgetOptions options) : options_(options) {}
+
+RetryBudget::Bucket &RetryBudget::current_locked() {
+    const auto second = std::chrono::duration_cast<std::chrono::seconds>(
+                            std::chrono::steady_clock::now().time_since_epoch())
+                            .count();
+    auto &bucket = buckets_[static_cast<std::size_t>(second) % kWindowSeconds];
+    if (bucket.second != second) {
+        bucket = Bucket{second, 0, 0};
+    }
+    return bucket;
+}
+
+void RetryBudget::record_request() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++current_locked().requests;
+    ++stats_.requests;
+}
+
+bool RetryBudget::try_retry() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto &current = current_locked();
+
+    std::uint64_t requests = 0;
+    std::uint64_t retries = 0;
+    for (const auto &bucket : buckets_) {
+        // Buckets older than the window still hold their counts until they are reused.
+        if (bucket.second > current.second - static_cast<std::int64_t>(kWindowSeconds)) {
+            requests += bucket.requests;
+            retries += bucket.retries;
+        }
+    }
+    const double allowed =
+        std::max(options_.ratio * static_cast<double>(requests),
+                 options_.min_retries_per_second * static_cast<double>(kWindowSeconds));
+    if (static_cast<double>(retries) >= allowed) {
+        ++stats_.rejected;
+        return false;
+    }
+    ++current.retries;
+    ++stats_.retries;
+    return true;
+}
+
+RetryBudgetStats RetryBudget::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+} // namespace massive::core
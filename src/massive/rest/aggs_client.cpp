@@ -1,44 +1,26 @@
 #include "massive/rest/client.hpp"
+#include "massive/core/logging.hpp"
+#include "massive/rest/json_parser.hpp"
 #include <simdjson/ondemand.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <map>
+#include <span>
 #include <stdexcept>
 
 namespace massive::rest {
 
-std::vector<Agg> RESTClient::list_aggs(const std::string &ticker, int multiplier,
-                                       const std::string &timespan, const std::string &from,
-                                       const std::string &to, std::optional<bool> adjusted,
-                                       std::optional<std::string> sort, std::optional<int> limit) {
-    std::map<std::string, std::string> params;
-    if (adjusted.has_value()) {
-        params["adjusted"] = adjusted.value() ? "true" : "false";
-    }
-    if (sort.has_value()) {
-        params["sort"] = sort.value();
-    }
-    if (limit.has_value()) {
-        params["limit"] = std::to_string(limit.value());
-    }
-
-    std::string path = "/v2/aggs/ticker/" + ticker + "/range/" + std::to_string(multiplier) + "/" +
-                       timespan + "/" + from + "/" + to;
-    auto response = send_request(core::HttpMethod::Get, path, params);
-
-    // Parse JSON response using simdjson
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
-    if (doc_result.error()) {
-        throw std::runtime_error("Failed to parse JSON response");
-    }
-    auto& doc = doc_result.value();
-    auto root_obj = doc.get_object();
-    if (root_obj.error()) {
-        throw std::runtime_error("Response is not a JSON object");
-    }
-
-    std::vector<Agg> results;
+namespace {
+// Requests one list_aggs call keeps in flight while filling the bar store. Kept small because
+// callers such as get_aggs_many already run many list_aggs calls side by side.
+constexpr std::size_t kBackfillRequests = 4;
 
-    auto results_field = root_obj.value().find_field_unordered("results");
+void parse_aggs_page(::simdjson::ondemand::object &root, std::vector<Agg> &results) {
+    auto results_field = root.find_field_unordered("results");
     if (!results_field.error()) {
         auto results_array = results_field.value().get_array();
         if (!results_array.error()) {
@@ -98,277 +80,273 @@ std::vector<Agg> RESTClient::list_aggs(const std::string &ticker, int multiplier
             }
         }
     }
-
-    return results;
 }
 
-std::vector<Trade> RESTClient::list_trades(const std::string &ticker,
-                                           const std::optional<std::string> &timestamp,
-                                           const std::optional<std::string> &timestamp_lt,
-                                           const std::optional<std::string> &timestamp_lte,
-                                           const std::optional<std::string> &timestamp_gt,
-                                           const std::optional<std::string> &timestamp_gte,
-                                           std::optional<int> limit,
-                                           const std::optional<std::string> &sort,
-                                           const std::optional<std::string> &order) {
-    std::map<std::string, std::string> params;
-    if (timestamp.has_value()) {
-        params["timestamp"] = timestamp.value();
-    }
-    if (timestamp_lt.has_value()) {
-        params["timestamp.lt"] = timestamp_lt.value();
-    }
-    if (timestamp_lte.has_value()) {
-        params["timestamp.lte"] = timestamp_lte.value();
-    }
-    if (timestamp_gt.has_value()) {
-        params["timestamp.gt"] = timestamp_gt.value();
-    }
-    if (timestamp_gte.has_value()) {
-        params["timestamp.gte"] = timestamp_gte.value();
-    }
-    if (limit.has_value()) {
-        params["limit"] = std::to_string(limit.value());
-    }
-    if (sort.has_value()) {
-        params["sort"] = sort.value();
-    }
-    if (order.has_value()) {
-        params["order"] = order.value();
-    }
-
-    std::string path = "/v3/trades/" + ticker;
-    auto response = send_request(core::HttpMethod::Get, path, params);
-
-    // Parse JSON response
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
-    if (doc_result.error()) {
-        throw std::runtime_error("Failed to parse JSON response");
-    }
-    auto& doc = doc_result.value();
-    auto root_obj = doc.get_object();
-    if (root_obj.error()) {
-        throw std::runtime_error("Response is not a JSON object");
-    }
-
-    std::vector<Trade> results;
-
-    auto results_field = root_obj.value().find_field_unordered("results");
-    if (!results_field.error()) {
-        auto results_array = results_field.value().get_array();
-        if (!results_array.error()) {
-            for (auto result : results_array.value()) {
-                Trade trade;
-                auto obj_result = result.get_object();
-                if (!obj_result.error()) {
-                    auto obj = obj_result.value();
+// Calendar days in the API's YYYY-MM-DD form; nullopt for anything else, such as timestamps.
+std::optional<std::chrono::sys_days> parse_day(const std::string &value) {
+    int year = 0;
+    unsigned month = 0;
+    unsigned day = 0;
+    if (value.size() != 10 || value[4] != '-' || value[7] != '-' ||
+        std::sscanf(value.c_str(), "%4d-%2u-%2u", &year, &month, &day) != 3) {
+        return std::nullopt;
+    }
+    const std::chrono::year_month_day date{std::chrono::year(year), std::chrono::month(month),
+                                           std::chrono::day(day)};
+    if (!date.ok()) {
+        return std::nullopt;
+    }
+    return std::chrono::sys_days(date);
+}
 
-                    auto price_field = obj.find_field_unordered("p");
-                    if (!price_field.error()) {
-                        trade.price = price_field.value().get_double().value();
-                    }
+std::string format_day(std::chrono::sys_days value) {
+    const std::chrono::year_month_day date(value);
+    char buffer[16];
+    std::snprintf(buffer, sizeof(buffer), "%04d-%02u-%02u", static_cast<int>(date.year()),
+                  static_cast<unsigned>(date.month()), static_cast<unsigned>(date.day()));
+    return buffer;
+}
 
-                    auto size_field = obj.find_field_unordered("s");
-                    if (!size_field.error()) {
-                        trade.size = size_field.value().get_int64().value();
-                    }
+// Tickers without a market prefix ("X:", "C:", "I:", "O:") are US stocks, whose ranges the
+// API cuts at New York midnight. Other markets may cut days elsewhere, such as at UTC midnight.
+bool has_new_york_days(const std::string &ticker) {
+    return ticker.find(':') == std::string::npos;
+}
 
-                    auto timestamp_field = obj.find_field_unordered("t");
-                    if (!timestamp_field.error()) {
-                        trade.timestamp = timestamp_field.value().get_int64().value();
-                    }
+// The New York calendar day of a bar starting at `timestamp` (ms since the epoch), or nullopt
+// before 1987, for which only the rules below are known. Daylight time runs from 2:00 local on
+// the second Sunday of March to 2:00 local on the first Sunday of November since 2007, and
+// from the first Sunday of April to the last Sunday of October from 1987 to 2006.
+std::optional<std::chrono::sys_days> market_day(std::int64_t timestamp) {
+    using namespace std::chrono;
+    const sys_time<milliseconds> at{milliseconds(timestamp)};
+    const year this_year = year_month_day(floor<days>(at)).year();
+    if (this_year < year(1987)) {
+        return std::nullopt;
+    }
+    const bool since_2007 = this_year >= year(2007);
+    const auto daylight_from =
+        sys_days(since_2007 ? this_year / March / Sunday[2] : this_year / April / Sunday[1]) +
+        hours(7);
+    const auto daylight_to = (since_2007 ? sys_days(this_year / November / Sunday[1])
+                                         : sys_days(this_year / October / Sunday[last])) +
+                             hours(6);
+    const auto offset = at >= daylight_from && at < daylight_to ? hours(-4) : hours(-5);
+    return floor<days>(at + offset);
+}
 
-                    results.push_back(trade);
-                }
+// Splits bars fetched for [from, to] in ascending order into one span per New York day, or
+// returns nothing when a bar falls outside those days or out of order: then the split would not
+// match what a request for each day returns, so none of it may be stored.
+std::vector<std::span<const Agg>> split_by_day(std::span<const Agg> aggs,
+                                               std::chrono::sys_days from,
+                                               std::chrono::sys_days to) {
+    std::vector<std::span<const Agg>> days;
+    std::size_t next = 0;
+    for (auto day = from; day <= to; day += std::chrono::days(1)) {
+        std::size_t end = next;
+        while (end < aggs.size()) {
+            const auto bar_day = market_day(aggs[end].timestamp.value_or(0));
+            if (!bar_day || *bar_day < day) {
+                return {};
             }
+            if (*bar_day > day) {
+                break;
+            }
+            ++end;
         }
+        days.push_back(aggs.subspan(next, end - next));
+        next = end;
     }
-
-    return results;
-}
-
-LastTrade RESTClient::get_last_trade(const std::string &ticker) {
-    std::string path = "/v2/last/trade/" + ticker;
-    auto response = send_request(core::HttpMethod::Get, path);
-
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
-    if (doc_result.error()) {
-        throw std::runtime_error("Failed to parse JSON response");
+    if (next != aggs.size()) {
+        return {};
     }
-    auto& doc = doc_result.value();
-    auto root_obj = doc.get_object();
-    if (root_obj.error()) {
-        throw std::runtime_error("Response is not a JSON object");
-    }
-
-    LastTrade last_trade;
-    auto result_field = root_obj.value().find_field_unordered("results");
-    if (!result_field.error()) {
-        auto obj_result = result_field.value().get_object();
-        if (!obj_result.error()) {
-            auto obj = obj_result.value();
-
-            auto ticker_field = obj.find_field_unordered("T");
-            if (!ticker_field.error()) {
-                last_trade.ticker = std::string(ticker_field.value().get_string().value());
-            }
-
-            auto price_field = obj.find_field_unordered("p");
-            if (!price_field.error()) {
-                last_trade.price = price_field.value().get_double().value();
-            }
+    return days;
+}
 
-            auto size_field = obj.find_field_unordered("s");
-            if (!size_field.error()) {
-                last_trade.size = size_field.value().get_int64().value();
-            }
+// Only bars that never straddle two days can be stored one day per file.
+bool is_storable(int multiplier, const std::string &timespan) {
+    return multiplier == 1 && (timespan == "second" || timespan == "minute" ||
+                               timespan == "hour" || timespan == "day");
+}
 
-            auto timestamp_field = obj.find_field_unordered("t");
-            if (!timestamp_field.error()) {
-                last_trade.timestamp = timestamp_field.value().get_int64().value();
+void append_bars(std::span<const Agg> aggs, core::BarColumns &bars) {
+    constexpr double kMissing = std::numeric_limits<double>::quiet_NaN();
+    for (const auto &agg : aggs) {
+        std::uint8_t flags = 0;
+        if (agg.transactions.has_value()) {
+            flags |= core::BarColumns::kHasTransactions;
+        }
+        if (agg.otc.has_value()) {
+            flags |= core::BarColumns::kHasOtc;
+            if (*agg.otc) {
+                flags |= core::BarColumns::kOtc;
             }
         }
+        bars.timestamp.push_back(agg.timestamp.value_or(0));
+        bars.open.push_back(agg.open.value_or(kMissing));
+        bars.high.push_back(agg.high.value_or(kMissing));
+        bars.low.push_back(agg.low.value_or(kMissing));
+        bars.close.push_back(agg.close.value_or(kMissing));
+        bars.volume.push_back(agg.volume.value_or(kMissing));
+        bars.vwap.push_back(agg.vwap.value_or(kMissing));
+        bars.transactions.push_back(agg.transactions.value_or(0));
+        bars.flags.push_back(flags);
     }
-
-    return last_trade;
 }
 
-std::vector<Quote> RESTClient::list_quotes(const std::string &ticker,
-                                           const std::optional<std::string> &timestamp,
-                                           const std::optional<std::string> &timestamp_lt,
-                                           const std::optional<std::string> &timestamp_lte,
-                                           const std::optional<std::string> &timestamp_gt,
-                                           const std::optional<std::string> &timestamp_gte,
-                                           std::optional<int> limit,
-                                           const std::optional<std::string> &sort,
-                                           const std::optional<std::string> &order) {
-    std::map<std::string, std::string> params;
-    if (timestamp.has_value()) {
-        params["timestamp"] = timestamp.value();
-    }
-    if (timestamp_lt.has_value()) {
-        params["timestamp.lt"] = timestamp_lt.value();
-    }
-    if (timestamp_lte.has_value()) {
-        params["timestamp.lte"] = timestamp_lte.value();
-    }
-    if (timestamp_gt.has_value()) {
-        params["timestamp.gt"] = timestamp_gt.value();
-    }
-    if (timestamp_gte.has_value()) {
-        params["timestamp.gte"] = timestamp_gte.value();
+void append_aggs(const core::BarColumns &bars, std::vector<Agg> &aggs) {
+    auto value = [](double column) {
+        return std::isnan(column) ? std::nullopt : std::optional<double>(column);
+    };
+    for (std::size_t i = 0; i < bars.size(); ++i) {
+        Agg agg;
+        agg.timestamp = bars.timestamp[i];
+        agg.open = value(bars.open[i]);
+        agg.high = value(bars.high[i]);
+        agg.low = value(bars.low[i]);
+        agg.close = value(bars.close[i]);
+        agg.volume = value(bars.volume[i]);
+        agg.vwap = value(bars.vwap[i]);
+        if (bars.flags[i] & core::BarColumns::kHasTransactions) {
+            agg.transactions = bars.transactions[i];
+        }
+        if (bars.flags[i] & core::BarColumns::kHasOtc) {
+            agg.otc = (bars.flags[i] & core::BarColumns::kOtc) != 0;
+        }
+        aggs.push_back(agg);
     }
-    if (limit.has_value()) {
-        params["limit"] = std::to_string(limit.value());
+}
+} // namespace
+
+std::vector<Agg> RESTClient::list_aggs(const std::string &ticker, int multiplier,
+                                       const std::string &timespan, const std::string &from,
+                                       const std::string &to, std::optional<bool> adjusted,
+                                       std::optional<std::string> sort, std::optional<int> limit) {
+    QueryParams params;
+    if (adjusted.has_value()) {
+        params["adjusted"] = adjusted.value() ? "true" : "false";
     }
     if (sort.has_value()) {
         params["sort"] = sort.value();
     }
-    if (order.has_value()) {
-        params["order"] = order.value();
-    }
-
-    std::string path = "/v3/quotes/" + ticker;
-    auto response = send_request(core::HttpMethod::Get, path, params);
-
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
-    if (doc_result.error()) {
-        throw std::runtime_error("Failed to parse JSON response");
-    }
-    auto& doc = doc_result.value();
-    auto root_obj = doc.get_object();
-    if (root_obj.error()) {
-        throw std::runtime_error("Response is not a JSON object");
+    if (limit.has_value()) {
+        params["limit"] = std::to_string(limit.value());
     }
 
-    std::vector<Quote> results;
-
-    auto results_field = root_obj.value().find_field_unordered("results");
-    if (!results_field.error()) {
-        auto results_array = results_field.value().get_array();
-        if (!results_array.error()) {
-            for (auto result : results_array.value()) {
-                Quote quote;
-                auto obj_result = result.get_object();
-                if (!obj_result.error()) {
-                    auto obj = obj_result.value();
-
-                    auto ask_field = obj.find_field_unordered("ap");
-                    if (!ask_field.error()) {
-                        quote.ask = ask_field.value().get_double().value();
-                    }
-
-                    auto bid_field = obj.find_field_unordered("bp");
-                    if (!bid_field.error()) {
-                        quote.bid = bid_field.value().get_double().value();
-                    }
-
-                    auto timestamp_field = obj.find_field_unordered("t");
-                    if (!timestamp_field.error()) {
-                        quote.timestamp = timestamp_field.value().get_int64().value();
-                    }
-
-                    results.push_back(quote);
-                }
-            }
+    auto fetch = [&](const std::string &range_from, const std::string &range_to,
+                     const QueryParams &query) {
+        std::string path = "/v2/aggs/ticker/" + ticker + "/range/" + std::to_string(multiplier) +
+                           "/" + timespan + "/" + range_from + "/" + range_to;
+        std::vector<Agg> results;
+        collect_pages(path, query, results, [&](::simdjson::ondemand::object &root) {
+            parse_aggs_page(root, results);
+        });
+        return results;
+    };
+
+    // A stored day must be complete, so the store is skipped when pages could be cut short.
+    const auto &store = config_.bar_store();
+    const auto first = parse_day(from);
+    const auto last = parse_day(to);
+    if (!store || !first || !last || *first > *last || !is_storable(multiplier, timespan) ||
+        !config_.pagination() || config_.max_pages() != 0 || config_.max_items() != 0) {
+        return fetch(from, to, params);
+    }
+
+    // Days are gathered oldest first; the requested order is applied at the end.
+    const core::BarKey key{ticker, multiplier, timespan, adjusted.value_or(true)};
+    QueryParams day_params = params;
+    day_params["sort"] = "asc";
+    const auto now = std::chrono::system_clock::now();
+    // Keyed by YYYY-MM-DD, so iteration is chronological.
+    std::map<std::string, std::vector<Agg>> by_day;
+    std::vector<std::string> missing;
+    auto day = *first;
+    for (; day <= *last; day += std::chrono::days(1)) {
+        // A day is final once it has ended in every market's time zone; later days, and the
+        // rest of the range after them, are always downloaded.
+        if (now < day + std::chrono::days(1) + std::chrono::hours(6)) {
+            break;
+        }
+        auto name = format_day(day);
+        core::BarColumns bars;
+        if (store->read(key, name, bars)) {
+            append_aggs(bars, by_day[name]);
+        } else {
+            missing.push_back(std::move(name));
         }
     }
 
-    return results;
-}
-
-LastQuote RESTClient::get_last_quote(const std::string &ticker) {
-    std::string path = "/v2/last/quote/" + ticker;
-    auto response = send_request(core::HttpMethod::Get, path);
-
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
-    if (doc_result.error()) {
-        throw std::runtime_error("Failed to parse JSON response");
-    }
-    auto& doc = doc_result.value();
-    auto root_obj = doc.get_object();
-    if (root_obj.error()) {
-        throw std::runtime_error("Response is not a JSON object");
+    // Missing days are downloaded a few requests at a time. For US stocks, each run of
+    // consecutive missing days is one range request, keyed by its first day, and its bars are
+    // split by New York day. Elsewhere the day boundary is unknown, so each day is requested
+    // on its own and stored exactly as returned.
+    const bool combine_days = has_new_york_days(ticker);
+    const auto first_known_day =
+        std::chrono::sys_days(std::chrono::year(1987) / std::chrono::January / 1);
+    std::map<std::string, std::chrono::sys_days> runs;
+    std::vector<std::string> run_starts;
+    for (std::size_t i = 0; i < missing.size(); ++i) {
+        const auto missing_day = *parse_day(missing[i]);
+        if (combine_days && i != 0 && *parse_day(run_starts.back()) >= first_known_day &&
+            missing_day == runs[run_starts.back()] + std::chrono::days(1)) {
+            runs[run_starts.back()] = missing_day;
+        } else {
+            run_starts.push_back(missing[i]);
+            runs[missing[i]] = missing_day;
+        }
     }
-
-    LastQuote last_quote;
-    auto result_field = root_obj.value().find_field_unordered("results");
-    if (!result_field.error()) {
-        auto obj_result = result_field.value().get_object();
-        if (!obj_result.error()) {
-            auto obj = obj_result.value();
-
-            auto ticker_field = obj.find_field_unordered("T");
-            if (!ticker_field.error()) {
-                last_quote.ticker = std::string(ticker_field.value().get_string().value());
-            }
-
-            auto ask_field = obj.find_field_unordered("ap");
-            if (!ask_field.error()) {
-                last_quote.ask = ask_field.value().get_double().value();
+    run_batch<std::vector<Agg>>(
+        run_starts,
+        [&](const std::string &run_first) {
+            const auto run_from = *parse_day(run_first);
+            const auto run_to = runs.at(run_first);
+            auto fetched = fetch(run_first, format_day(run_to), day_params);
+            std::vector<std::span<const Agg>> days{std::span<const Agg>(fetched)};
+            if (run_to != run_from) {
+                days = split_by_day(fetched, run_from, run_to);
+                if (days.empty()) {
+                    MASSIVE_LOG_WARN(config_.logger(), "Not storing " << ticker << " bars for "
+                                                                      << run_first << " to "
+                                                                      << format_day(run_to)
+                                                                      << ": bars outside the "
+                                                                         "requested days");
+                }
             }
-
-            auto bid_field = obj.find_field_unordered("bp");
-            if (!bid_field.error()) {
-                last_quote.bid = bid_field.value().get_double().value();
+            auto run_day = run_from;
+            for (const auto &day_bars : days) {
+                const auto name = format_day(run_day);
+                run_day += std::chrono::days(1);
+                core::BarColumns bars;
+                append_bars(day_bars, bars);
+                try {
+                    store->write(key, name, bars);
+                } catch (const std::exception &e) {
+                    MASSIVE_LOG_WARN(config_.logger(), "Failed to store " << ticker
+                                                                          << " bars for " << name
+                                                                          << ": " << e.what());
+                }
             }
+            return fetched;
+        },
+        [&](const std::string &run_first, BatchResult<std::vector<Agg>> result) {
+            by_day[run_first] = result.get();
+        },
+        BatchOptions{kBackfillRequests});
 
-            auto timestamp_field = obj.find_field_unordered("t");
-            if (!timestamp_field.error()) {
-                last_quote.timestamp = timestamp_field.value().get_int64().value();
-            }
-        }
+    std::vector<Agg> results;
+    for (const auto &[name, aggs] : by_day) {
+        results.insert(results.end(), aggs.begin(), aggs.end());
     }
-
-    return last_quote;
+    if (day <= *last) {
+        auto recent = fetch(format_day(day), to, day_params);
+        results.insert(results.end(), recent.begin(), recent.end());
+    }
+    if (sort.has_value() && *sort == "desc") {
+        std::reverse(results.begin(), results.end());
+    }
+    return results;
 }
 
 std::vector<GroupedDailyAgg> RESTClient::get_grouped_daily_aggs(const std::string &date,
@@ -376,7 +354,7 @@ std::vector<GroupedDailyAgg> RESTClient::get_grouped_daily_aggs(const std::strin
                                                                 const std::string &locale,
                                                                 const std::string &market_type,
                                                                 bool include_otc) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
     if (adjusted.has_value()) {
         params["adjusted"] = adjusted.value() ? "true" : "false";
     }
@@ -387,9 +365,7 @@ std::vector<GroupedDailyAgg> RESTClient::get_grouped_daily_aggs(const std::strin
     std::string path = "/v2/aggs/grouped/locale/" + locale + "/market/" + market_type + "/" + date;
     auto response = send_request(core::HttpMethod::Get, path, params);
 
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
+    auto doc_result = iterate_json(response.body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
@@ -473,7 +449,7 @@ std::vector<GroupedDailyAgg> RESTClient::get_grouped_daily_aggs(const std::strin
 DailyOpenCloseAgg RESTClient::get_daily_open_close_agg(const std::string &ticker,
                                                        const std::string &date,
                                                        std::optional<bool> adjusted) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
     if (adjusted.has_value()) {
         params["adjusted"] = adjusted.value() ? "true" : "false";
     }
@@ -481,9 +457,7 @@ DailyOpenCloseAgg RESTClient::get_daily_open_close_agg(const std::string &ticker
     std::string path = "/v1/open-close/" + ticker + "/" + date;
     auto response = send_request(core::HttpMethod::Get, path, params);
 
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
+    auto doc_result = iterate_json(response.body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
@@ -555,18 +529,17 @@ DailyOpenCloseAgg RESTClient::get_daily_open_close_agg(const std::string &ticker
 }
 
 PreviousCloseAgg RESTClient::get_previous_close_agg(const std::string &ticker,
-                                                    std::optional<bool> adjusted) {
-    std::map<std::string, std::string> params;
+                                                    std::optional<bool> adjusted,
+                                                    const std::optional<RequestOptions> &options) {
+    QueryParams params;
     if (adjusted.has_value()) {
         params["adjusted"] = adjusted.value() ? "true" : "false";
     }
 
     std::string path = "/v2/aggs/ticker/" + ticker + "/prev";
-    auto response = send_request(core::HttpMethod::Get, path, params);
+    auto response = send_request(core::HttpMethod::Get, path, params, options);
 
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
+    auto doc_result = iterate_json(response.body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
@@ -638,7 +611,7 @@ std::vector<Agg> RESTClient::get_aggs(
     std::optional<bool> adjusted,
     std::optional<std::string> sort,
     std::optional<int> limit) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
     if (adjusted.has_value()) {
         params["adjusted"] = adjusted.value() ? "true" : "false";
     }
@@ -652,9 +625,7 @@ std::vector<Agg> RESTClient::get_aggs(
     std::string path = "/v2/aggs/ticker/" + ticker + "/range/" + std::to_string(multiplier) + "/" + timespan + "/" + from + "/" + to;
     auto response = send_request(core::HttpMethod::Get, path, params);
 
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
+    auto doc_result = iterate_json(response.body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
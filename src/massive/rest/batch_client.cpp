@@ -0,0 +1,70 @@
+#include "massive/rest/client.hpp"
+
+namespace massive::rest {
+
+std::map<std::string, BatchResult<std::vector<Agg>>>
+RESTClient::get_aggs_many(const std::vector<std::string> &tickers, int multiplier,
+                          const std::string &timespan, const std::string &from,
+                          const std::string &to, std::optional<bool> adjusted,
+                          const BatchOptions &options) {
+    return collect_batch<std::vector<Agg>>(
+        tickers,
+        [&](const std::string &ticker) {
+            return list_aggs(ticker, multiplier, timespan, from, to, adjusted);
+        },
+        options);
+}
+
+void RESTClient::get_aggs_many(const std::vector<std::string> &tickers, int multiplier,
+                               const std::string &timespan, const std::string &from,
+                               const std::string &to,
+                               const BatchCallback<std::vector<Agg>> &on_result,
+                               std::optional<bool> adjusted, const BatchOptions &options) {
+    run_batch<std::vector<Agg>>(
+        tickers,
+        [&](const std::string &ticker) {
+            return list_aggs(ticker, multiplier, timespan, from, to, adjusted);
+        },
+        on_result, options);
+}
+
+std::map<std::string, BatchResult<LastTrade>>
+RESTClient::get_last_trade_many(const std::vector<std::string> &tickers,
+                                const BatchOptions &options) {
+    return collect_batch<LastTrade>(
+        tickers, [this](const std::string &ticker) { return get_last_trade(ticker); }, options);
+}
+
+void RESTClient::get_last_trade_many(const std::vector<std::string> &tickers,
+                                     const BatchCallback<LastTrade> &on_result,
+                                     const BatchOptions &options) {
+    run_batch<LastTrade>(
+        tickers, [this](const std::string &ticker) { return get_last_trade(ticker); },
+        on_result, options);
+}
+
+std::map<std::string, BatchResult<TickerSnapshot>>
+RESTClient::get_snapshot_ticker_many(SnapshotMarketType market_type,
+                                     const std::vector<std::string> &tickers,
+                                     const BatchOptions &options) {
+    return collect_batch<TickerSnapshot>(
+        tickers,
+        [this, market_type](const std::string &ticker) {
+            return get_snapshot_ticker(market_type, ticker);
+        },
+        options);
+}
+
+void RESTClient::get_snapshot_ticker_many(SnapshotMarketType market_type,
+                                          const std::vector<std::string> &tickers,
+                                          const BatchCallback<TickerSnapshot> &on_result,
+                                          const BatchOptions &options) {
+    run_batch<TickerSnapshot>(
+        tickers,
+        [this, market_type](const std::string &ticker) {
+            return get_snapshot_ticker(market_type, ticker);
+        },
+        on_result, options);
+}
+
+} // namespace massive::rest
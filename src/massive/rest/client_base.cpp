@@ -1,14 +1,19 @@
 #include "massive/rest/client.hpp"
 
 #include "massive/core/http/beast_transport.hpp"
+#include "massive/core/http/transport_factory.hpp"
 #include "massive/core/logging.hpp"
 #include "massive/exceptions.hpp"
+#include <array>
 #include <cctype>
-#include <iomanip>
+#include <condition_variable>
+#include <exception>
 #include <sstream>
 #include <stdexcept>
+#include <string_view>
 #include <thread>
-#include <cmath>
+#include <mutex>
+#include <random>
 
 namespace massive::rest {
 
@@ -25,19 +30,55 @@ void ensure_success(int status, std::string_view context, const std::string &bod
     throw BadResponse(status, body);
 }
 
-std::string url_encode(const std::string &value) {
-    std::ostringstream encoded;
-    encoded.fill('0');
-    encoded << std::hex;
-
+// Appends `value` percent-encoded to `out`, so a URL is built in a single buffer.
+void append_url_encoded(std::string &out, std::string_view value) {
+    static constexpr char kHex[] = "0123456789abcdef";
     for (char c : value) {
-        if (std::isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~') {
-            encoded << c;
+        const auto byte = static_cast<unsigned char>(c);
+        if (std::isalnum(byte) || c == '-' || c == '_' || c == '.' || c == '~') {
+            out += c;
         } else {
-            encoded << '%' << std::setw(2) << static_cast<int>(static_cast<unsigned char>(c));
+            out += '%';
+            out += kHex[byte >> 4];
+            out += kHex[byte & 0x0f];
+        }
+    }
+}
+
+// Upper bound on the encoded size of a key=value pair, including the separator.
+std::size_t encoded_size(std::string_view key, std::string_view value) {
+    return 3 * (key.size() + value.size()) + 2;
+}
+
+int hex_value(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+std::string url_decode(std::string_view value) {
+    std::string decoded;
+    decoded.reserve(value.size());
+    for (std::size_t i = 0; i < value.size(); ++i) {
+        if (value[i] == '%' && i + 2 < value.size()) {
+            int high = hex_value(value[i + 1]);
+            int low = hex_value(value[i + 2]);
+            if (high >= 0 && low >= 0) {
+                decoded += static_cast<char>(high * 16 + low);
+                i += 2;
+                continue;
+            }
         }
+        decoded += value[i] == '+' ? ' ' : value[i];
     }
-    return encoded.str();
+    return decoded;
 }
 
 std::string method_to_string(core::HttpMethod method) {
@@ -57,94 +98,270 @@ bool should_retry(int status_code) {
     return status_code >= 500 || status_code == 429;
 }
 
-// Calculate exponential backoff delay
-std::chrono::milliseconds calculate_backoff(
-    std::size_t attempt,
-    std::chrono::milliseconds initial_backoff,
-    std::chrono::milliseconds max_backoff) {
-    // Exponential backoff: initial_backoff * 2^(attempt-1)
-    auto delay_ms = static_cast<std::int64_t>(
-        initial_backoff.count() * std::pow(2.0, static_cast<double>(attempt - 1))
-    );
-    auto delay = std::chrono::milliseconds(delay_ms);
-    
-    // Cap at max_backoff
-    if (delay > max_backoff) {
-        delay = max_backoff;
+// Decorrelated jitter: a random delay between the initial backoff and three times the
+// previous one, capped at max_backoff. Clients that failed together do not retry together.
+std::chrono::milliseconds next_backoff(std::chrono::milliseconds previous,
+                                       const core::RetryPolicy &policy) {
+    thread_local std::mt19937_64 rng{std::random_device{}()};
+    const auto low = policy.initial_backoff.count();
+    const auto high = std::max(low, previous.count() * 3);
+    std::uniform_int_distribution<std::chrono::milliseconds::rep> pick(low, high);
+    return std::min(std::chrono::milliseconds(pick(rng)), policy.max_backoff);
+}
+
+// Sleeps for `delay`, or less if `cancellation` is cancelled meanwhile.
+void wait_backoff(std::chrono::milliseconds delay,
+                  const std::shared_ptr<core::RequestCancellation> &cancellation) {
+    if (!cancellation) {
+        std::this_thread::sleep_for(delay);
+        return;
     }
-    
-    return delay;
+    struct Wake {
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool cancelled{false};
+    };
+    // Shared with the handler, which the next attempt's transport replaces.
+    auto wake = std::make_shared<Wake>();
+    cancellation->on_cancel([wake] {
+        std::lock_guard<std::mutex> lock(wake->mutex);
+        wake->cancelled = true;
+        wake->cv.notify_all();
+    });
+    std::unique_lock<std::mutex> lock(wake->mutex);
+    wake->cv.wait_for(lock, delay, [&wake] { return wake->cancelled; });
+}
+
+// Requests coalesce only if everything that could change the response or how long a caller
+// waits for it matches: the URL, per-call headers, whether default headers are sent and the
+// timeout.
+std::string coalesce_key(const std::string &url, const std::optional<RequestOptions> &options) {
+    std::string key = url;
+    if (!options.has_value()) {
+        return key;
+    }
+    key += options->skip_default_headers ? "\n-" : "\n+";
+    if (options->timeout.has_value()) {
+        key += std::to_string(options->timeout->count());
+    }
+    for (const auto &[name, value] : options->headers) {
+        key += '\n';
+        key += name;
+        key += ": ";
+        key += value;
+    }
+    return key;
 }
 } // namespace
 
 RESTClient::RESTClient(core::ClientConfig config, std::shared_ptr<core::IHttpTransport> transport)
     : config_(std::move(config)), transport_(std::move(transport)),
-      json_codec_(core::make_passthrough_json_codec()) {
+      json_codec_(core::make_passthrough_json_codec()),
+      hedge_tracker_(std::make_shared<HedgeTracker>()) {
     if (config_.api_key().empty()) {
         throw std::runtime_error("API key is required");
     }
+    default_headers_ = std::make_shared<const std::map<std::string, std::string>>(
+        std::map<std::string, std::string>{
+            {"Authorization", "Bearer " + std::string(config_.api_key())},
+            {"Accept-Encoding", "gzip, deflate"},
+            {"User-Agent", "Massive.com C++Client/0.1.0"},
+            {"Content-Type", "application/json"},
+        });
 }
 
-std::map<std::string, std::string> RESTClient::build_headers(const std::optional<RequestOptions>& options) const {
-    std::map<std::string, std::string> headers;
-    
-    if (!options.has_value() || !options->skip_default_headers) {
-        headers["Authorization"] = "Bearer " + std::string(config_.api_key());
-        headers["Accept-Encoding"] = "gzip";
-        headers["User-Agent"] = "Massive.com C++Client/0.1.0";
-        headers["Content-Type"] = "application/json";
+RESTClient::RESTClient(core::ClientConfig config)
+    : RESTClient(config, core::make_transport(config)) {}
+
+HedgeStats RESTClient::hedge_stats() const { return hedge_tracker_->stats(); }
+
+std::string RESTClient::build_url(const std::string &path, const QueryParams &params,
+                                  const std::optional<RequestOptions>& options) const {
+    static const std::map<std::string, std::string> kNoParams;
+    const auto &extra = options.has_value() ? options->query_params : kNoParams;
+
+    const std::string_view base_url = config_.base_url();
+    std::size_t size = base_url.size() + path.size();
+    for (const auto &[key, value] : params) {
+        size += encoded_size(key, value);
     }
-    
-    // Merge custom headers (override defaults if present)
-    if (options.has_value()) {
-        for (const auto& [key, value] : options->headers) {
-            headers[key] = value;
+    for (const auto &[key, value] : extra) {
+        size += encoded_size(key, value);
+    }
+
+    std::string full_url;
+    full_url.reserve(size);
+    full_url += base_url;
+    full_url += path;
+
+    // Both sides are sorted by key, so they are merged in one pass; options win on a tie.
+    char separator = '?';
+    auto append = [&](const std::string &key, const std::string &value) {
+        full_url += separator;
+        separator = '&';
+        full_url += key;
+        full_url += '=';
+        append_url_encoded(full_url, value);
+    };
+    auto param = params.begin();
+    auto option = extra.begin();
+    while (param != params.end() || option != extra.end()) {
+        if (option == extra.end() || (param != params.end() && param->first < option->first)) {
+            append(param->first, param->second);
+            ++param;
+            continue;
+        }
+        if (param != params.end() && param->first == option->first) {
+            ++param;
         }
+        append(option->first, option->second);
+        ++option;
     }
-    
-    return headers;
+
+    return full_url;
 }
 
-std::string RESTClient::build_url(const std::string &path,
-                                  const std::map<std::string, std::string> &params,
-                                  const std::optional<RequestOptions>& options) const {
-    std::string base_url = std::string(config_.base_url());
-    std::string full_url = base_url + path;
+void RESTClient::follow_next_url(const std::string &next_url, std::string &path,
+                                 QueryParams &params) const {
+    // next_url is absolute; keep only the path and query so build_url applies our base_url.
+    std::string_view url = next_url;
+    if (auto scheme = url.find("://"); scheme != std::string_view::npos) {
+        auto path_start = url.find('/', scheme + 3);
+        url = path_start == std::string_view::npos ? std::string_view("/") : url.substr(path_start);
+    }
 
-    // Merge params with query params from options
-    std::map<std::string, std::string> all_params = params;
-    if (options.has_value()) {
-        for (const auto& [key, value] : options->query_params) {
-            all_params[key] = value;
+    // The cursor in the query carries the original filters, so no other params are kept.
+    // Values are decoded here because build_url encodes them again.
+    params.clear();
+    auto query_pos = url.find('?');
+    path = std::string(url.substr(0, query_pos));
+    if (query_pos == std::string_view::npos) {
+        return;
+    }
+    std::string_view query = url.substr(query_pos + 1);
+    while (!query.empty()) {
+        auto amp = query.find('&');
+        std::string_view pair = query.substr(0, amp);
+        query = amp == std::string_view::npos ? std::string_view() : query.substr(amp + 1);
+        if (pair.empty()) {
+            continue;
+        }
+        auto eq = pair.find('=');
+        if (eq == std::string_view::npos) {
+            params[url_decode(pair)] = "";
+        } else {
+            params[url_decode(pair.substr(0, eq))] = url_decode(pair.substr(eq + 1));
         }
     }
+}
 
-    if (!all_params.empty()) {
-        full_url += "?";
-        bool first = true;
-        for (const auto &[key, value] : all_params) {
-            if (!first) {
-                full_url += "&";
+core::HttpResponse RESTClient::send_hedged(const core::HttpRequest &request,
+                                           std::string_view endpoint,
+                                           const HedgePolicy &policy) {
+    // Shared with the transport callbacks, which may run after this call has returned.
+    struct Race {
+        std::mutex mutex;
+        std::condition_variable settled;
+        std::optional<core::HttpResponse> response;
+        std::size_t winner{0};
+        std::size_t failed{0};
+        std::exception_ptr error;
+    };
+    auto race = std::make_shared<Race>();
+    std::array<std::shared_ptr<core::RequestCancellation>, 2> cancellations;
+    std::size_t launched = 0;
+
+    // Called without the race lock held: transports may complete inline.
+    auto launch = [&]() {
+        const std::size_t index = launched++;
+        core::HttpRequest attempt = request;
+        cancellations[index] = std::make_shared<core::RequestCancellation>();
+        attempt.cancellation = cancellations[index];
+        transport_->async_send(std::move(attempt), [race, index](std::exception_ptr error,
+                                                                 core::HttpResponse response) {
+            {
+                std::lock_guard<std::mutex> lock(race->mutex);
+                if (error) {
+                    ++race->failed;
+                    if (!race->error) {
+                        race->error = error;
+                    }
+                } else if (!race->response) {
+                    race->response = std::move(response);
+                    race->winner = index;
+                }
             }
-            first = false;
-            full_url += key + "=" + url_encode(value);
+            race->settled.notify_all();
+        });
+    };
+    auto done = [&]() { return race->response.has_value() || race->failed == launched; };
+
+    const auto started = std::chrono::steady_clock::now();
+    launch();
+    std::unique_lock<std::mutex> lock(race->mutex);
+    if (!race->settled.wait_for(lock, hedge_tracker_->delay(endpoint, policy), done)) {
+        // A duplicate is optional load, so it is skipped rather than queued behind the limiter.
+        const auto &limiter = config_.rate_limiter();
+        if (!limiter || limiter->try_acquire()) {
+            lock.unlock();
+            hedge_tracker_->record_hedge_sent();
+            launch();
+            lock.lock();
         }
     }
+    race->settled.wait(lock, done);
 
-    return full_url;
+    if (!race->response) {
+        std::rethrow_exception(race->error);
+    }
+    core::HttpResponse response = std::move(*race->response);
+    const std::size_t winner = race->winner;
+    lock.unlock();
+
+    for (std::size_t i = 0; i < launched; ++i) {
+        if (i != winner) {
+            cancellations[i]->cancel();
+        }
+    }
+    hedge_tracker_->record_response(endpoint,
+                                    std::chrono::duration_cast<std::chrono::microseconds>(
+                                        std::chrono::steady_clock::now() - started),
+                                    winner != 0);
+    return response;
 }
 
 core::HttpResponse RESTClient::send_request(core::HttpMethod method, const std::string &path,
-                                            const std::map<std::string, std::string> &params,
-                                            const std::optional<RequestOptions>& options) {
+                                            const QueryParams &params,
+                                            const std::optional<RequestOptions>& options,
+                                            const core::BodyChunkHandler &on_body_chunk,
+                                            const std::function<void()> &on_restart) {
+    const auto &coalescer = config_.request_coalescer();
+    // A streamed body goes to one caller's handler, so only buffered GETs can be shared.
+    if (!coalescer || method != core::HttpMethod::Get || on_body_chunk ||
+        (options.has_value() && options->cancellation)) {
+        return perform_request(method, path, params, options, on_body_chunk, on_restart);
+    }
+    return coalescer->run(coalesce_key(build_url(path, params, options), options), [&]() {
+        return perform_request(method, path, params, options, nullptr, nullptr);
+    });
+}
+
+core::HttpResponse RESTClient::perform_request(core::HttpMethod method, const std::string &path,
+                                               const QueryParams &params,
+                                               const std::optional<RequestOptions>& options,
+                                               const core::BodyChunkHandler &on_body_chunk,
+                                               const std::function<void()> &on_restart) {
     auto logger = config_.logger();
-    std::string full_url = build_url(path, params, options);
+    core::HttpRequest request;
+    request.method = method;
+    request.url = build_url(path, params, options);
+    const std::string &full_url = request.url;
     
     MASSIVE_LOG_DEBUG(logger, "Sending " << method_to_string(method) << " request to " << full_url);
     
     if (config_.trace()) {
         // Merge params for logging
-        std::map<std::string, std::string> all_params = params;
+        std::map<std::string, std::string> all_params(params.begin(), params.end());
         if (options.has_value()) {
             for (const auto& [key, value] : options->query_params) {
                 all_params[key] = value;
@@ -163,10 +380,13 @@ core::HttpResponse RESTClient::send_request(core::HttpMethod method, const std::
         }
     }
     
-    core::HttpRequest request;
-    request.method = method;
-    request.url = full_url;
-    request.headers = build_headers(options);
+    // The shared default block is sent first; per-call headers add to or replace it.
+    if (!options.has_value() || !options->skip_default_headers) {
+        request.base_headers = default_headers_;
+    }
+    if (options.has_value()) {
+        request.headers = options->headers;
+    }
     
     // Set timeout from options
     if (options.has_value() && options->timeout.has_value()) {
@@ -178,18 +398,135 @@ core::HttpResponse RESTClient::send_request(core::HttpMethod method, const std::
         request.body = options->body.value();
     }
 
-    // Retry logic with exponential backoff
+    const std::shared_ptr<core::RequestCancellation> cancellation =
+        options.has_value() ? options->cancellation : nullptr;
+    request.cancellation = cancellation;
+
+    // Once part of a streamed body has been handed on, a retry would deliver it twice, unless
+    // on_restart takes it back first.
+    bool streamed = false;
+    // An exception from on_body_chunk is the caller's (a result it could not parse), not a
+    // transport failure. It is held while the rest of the body is drained unread, then
+    // rethrown as is, without a retry. The response still reaches the rate limiter and the
+    // breaker, which must hear back about every attempt it allowed, but not the observer.
+    std::exception_ptr handler_error;
+    if (on_body_chunk) {
+        request.on_body_chunk = [&streamed, &handler_error, &on_body_chunk](
+                                    std::string_view chunk) {
+            if (handler_error) {
+                return;
+            }
+            streamed = true;
+            try {
+                on_body_chunk(chunk);
+            } catch (...) {
+                handler_error = std::current_exception();
+            }
+        };
+    }
+
+    // Retry logic with decorrelated jitter
     const auto& retry_policy = config_.retry_policy();
+    const auto& limiter = config_.rate_limiter();
+    const auto& concurrency = config_.concurrency_limiter();
+    const auto& budget = config_.retry_budget();
+    const auto& breaker = config_.circuit_breaker();
+    const auto& observer = config_.request_observer();
+    const bool hedged = options.has_value() && options->hedge.has_value() &&
+                        method == core::HttpMethod::Get && !on_body_chunk && !cancellation;
+    const std::string endpoint =
+        breaker || observer || hedged ? core::circuit_endpoint(path) : std::string();
     core::HttpResponse response;
     std::size_t attempt = 0;
+    std::chrono::milliseconds backoff = retry_policy.initial_backoff;
     bool success = false;
+
+    if (budget) {
+        budget->record_request();
+    }
+    // Claims a retry from the budget, if there are attempts left.
+    auto may_retry = [&]() {
+        if (attempt >= retry_policy.max_attempts) {
+            return false;
+        }
+        if (budget && !budget->try_retry()) {
+            MASSIVE_LOG_WARN(logger, "Retry budget exhausted, not retrying " << full_url);
+            return false;
+        }
+        return true;
+    };
+    // Reports one attempt; `result` is null when it failed without a response.
+    auto observe = [&](const core::HttpResponse *result, std::string_view error,
+                       std::chrono::steady_clock::time_point started) {
+        if (!observer) {
+            return;
+        }
+        core::RequestMetrics metrics;
+        metrics.method = method;
+        metrics.path = path;
+        metrics.endpoint = endpoint;
+        metrics.attempt = attempt;
+        metrics.error = error;
+        if (result != nullptr) {
+            metrics.status_code = result->status_code;
+            metrics.timing = result->timing;
+            metrics.bytes_sent = result->bytes_sent;
+            metrics.bytes_received = result->bytes_received;
+            metrics.connection_reused = result->connection_reused;
+        }
+        if (metrics.timing.total.count() == 0) {
+            metrics.timing.total = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - started);
+        }
+        observer->on_request(metrics);
+    };
     
     while (attempt < retry_policy.max_attempts && !success) {
         attempt++;
-        
+
+        if (cancellation && cancellation->cancelled()) {
+            throw std::runtime_error("Request cancelled");
+        }
+
+        // Fails fast while the endpoint is known to be down, without touching the limiters.
+        if (breaker && !breaker->allow(endpoint)) {
+            throw CircuitOpenError(endpoint, breaker->retry_in(endpoint));
+        }
+        if (limiter) {
+            limiter->acquire();
+        }
+        // Held for this attempt only, so retry backoff does not occupy a slot.
+        std::optional<core::ConcurrencyLimiter::Permit> permit;
+        if (concurrency) {
+            permit.emplace(concurrency->acquire());
+        }
         auto start_time = std::chrono::steady_clock::now();
+        // Whether the breaker has heard about this attempt.
+        bool recorded = false;
         try {
-            response = transport_->send(request);
+            if (hedged) {
+                response = send_hedged(request, endpoint, *options->hedge);
+            } else {
+                response = transport_->send(request);
+            }
+            if (limiter) {
+                limiter->observe(response.status_code, response.headers);
+            }
+            if (breaker) {
+                if (response.status_code >= 500) {
+                    breaker->record_failure(endpoint);
+                } else {
+                    breaker->record_success(endpoint);
+                }
+                recorded = true;
+            }
+            if (handler_error) {
+                std::rethrow_exception(handler_error);
+            }
+            if (permit) {
+                permit->release(response.status_code);
+            }
+            observe(&response, {}, start_time);
             auto end_time = std::chrono::steady_clock::now();
             auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
             
@@ -197,11 +534,21 @@ core::HttpResponse RESTClient::send_request(core::HttpMethod method, const std::
                           << " (" << duration.count() << "ms) [Attempt " << attempt << "/" << retry_policy.max_attempts << "]");
             
             // Check if we should retry
-            if (should_retry(response.status_code) && attempt < retry_policy.max_attempts) {
-                auto backoff = calculate_backoff(attempt, retry_policy.initial_backoff, retry_policy.max_backoff);
+            if (should_retry(response.status_code) && may_retry()) {
+                backoff = next_backoff(backoff, retry_policy);
+                auto delay = backoff;
+                if (response.status_code == 429) {
+                    if (limiter) {
+                        // The limiter has slowed down already and paces the retry itself.
+                        delay = std::chrono::milliseconds::zero();
+                    } else if (auto retry_after =
+                                   core::find_header(response.headers, "Retry-After")) {
+                        delay = core::parse_retry_after(*retry_after).value_or(delay);
+                    }
+                }
                 MASSIVE_LOG_WARN(logger, "Request failed with status " << response.status_code 
-                              << ", retrying in " << backoff.count() << "ms (attempt " << attempt << "/" << retry_policy.max_attempts << ")");
-                std::this_thread::sleep_for(backoff);
+                              << ", retrying in " << delay.count() << "ms (attempt " << attempt << "/" << retry_policy.max_attempts << ")");
+                wait_backoff(delay, cancellation);
                 continue;
             }
             
@@ -217,20 +564,53 @@ core::HttpResponse RESTClient::send_request(core::HttpMethod method, const std::
                 MASSIVE_LOG_DEBUG(logger, "Response body: " << body_preview);
             }
         } catch (const std::exception& e) {
+            if (handler_error) {
+                // Released as abandoned, which leaves the limit alone.
+                permit.reset();
+                if (breaker && !recorded) {
+                    // The transport failed after the handler did.
+                    breaker->record_failure(endpoint);
+                }
+                std::rethrow_exception(handler_error);
+            }
+            if (cancellation && cancellation->cancelled()) {
+                // Given up by the caller: neither the limit nor the breaker learn from it.
+                permit.reset();
+                if (breaker && !recorded) {
+                    breaker->record_abandoned(endpoint);
+                }
+                throw;
+            }
+            if (permit) {
+                permit->release_failed();
+            }
+            if (breaker && !recorded) {
+                breaker->record_failure(endpoint);
+            }
+            observe(nullptr, e.what(), start_time);
             // Network/transport errors - retry if we have attempts left
-            if (attempt < retry_policy.max_attempts) {
-                auto backoff = calculate_backoff(attempt, retry_policy.initial_backoff, retry_policy.max_backoff);
+            if ((!streamed || on_restart) && may_retry()) {
+                if (streamed) {
+                    on_restart();
+                    streamed = false;
+                }
+                backoff = next_backoff(backoff, retry_policy);
                 MASSIVE_LOG_WARN(logger, "Request failed with exception: " << e.what() 
                               << ", retrying in " << backoff.count() << "ms (attempt " << attempt << "/" << retry_policy.max_attempts << ")");
-                std::this_thread::sleep_for(backoff);
+                wait_backoff(backoff, cancellation);
                 continue;
             } else {
-                // Out of retries, rethrow
+                // Out of retries (or retry budget), rethrow
                 throw;
             }
         }
     }
     
+    // A conditional request's 304 goes back to the caller, which still holds the parsed value.
+    if (response.status_code == 304 && core::find_header(request.headers, "If-None-Match")) {
+        return response;
+    }
+
     // Check final response status
     ensure_success(response.status_code, "HTTP request", response.body);
     return response;
@@ -1,4 +1,5 @@
 #include "massive/rest/client.hpp"
+#include "massive/rest/json_parser.hpp"
 #include <simdjson/ondemand.h>
 #include <stdexcept>
 #include <sstream>
@@ -12,7 +13,7 @@ ForexConversion RESTClient::get_forex_conversion(
     double amount,
     const std::optional<std::string>& date,
     const std::optional<std::string>& precision) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
     params["from"] = from;
     params["to"] = to;
     params["amount"] = std::to_string(amount);
@@ -26,9 +27,7 @@ ForexConversion RESTClient::get_forex_conversion(
     std::string path = "/v1/conversion/" + from + "/" + to;
     auto response = send_request(core::HttpMethod::Get, path, params);
 
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
+    auto doc_result = iterate_json(response.body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
@@ -76,7 +75,7 @@ CryptoConversion RESTClient::get_crypto_conversion(
     double amount,
     const std::optional<std::string>& date,
     const std::optional<std::string>& precision) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
     params["from"] = from;
     params["to"] = to;
     params["amount"] = std::to_string(amount);
@@ -90,9 +89,7 @@ CryptoConversion RESTClient::get_crypto_conversion(
     std::string path = "/v1/conversion/crypto/" + from + "/" + to;
     auto response = send_request(core::HttpMethod::Get, path, params);
 
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
+    auto doc_result = iterate_json(response.body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
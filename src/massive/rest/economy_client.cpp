@@ -1,4 +1,5 @@
 #include "massive/rest/client.hpp"
+#include "massive/rest/json_parser.hpp"
 #include <simdjson/ondemand.h>
 #include <stdexcept>
 
@@ -10,7 +11,7 @@ std::vector<EconomicIndicator> RESTClient::list_economic_indicators(
     std::optional<int> limit, const std::optional<std::string> &date_gte,
     const std::optional<std::string> &date_lte, const std::optional<std::string> &sort,
     const std::optional<std::string> &order) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
     if (indicator.has_value()) {
         params["indicator"] = indicator.value();
     }
@@ -34,66 +35,60 @@ std::vector<EconomicIndicator> RESTClient::list_economic_indicators(
     }
 
     std::string path = "/v1/economic";
-    auto response = send_request(core::HttpMethod::Get, path, params);
-
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
-    if (doc_result.error()) {
-        throw std::runtime_error("Failed to parse JSON response");
-    }
-    auto& doc = doc_result.value();
-    auto root_obj = doc.get_object();
-    if (root_obj.error()) {
-        throw std::runtime_error("Response is not a JSON object");
-    }
 
     std::vector<EconomicIndicator> results;
-    auto results_field = root_obj.value().find_field_unordered("results");
-    if (!results_field.error()) {
-        auto results_array = results_field.value().get_array();
-        if (!results_array.error()) {
-            for (auto result_elem : results_array.value()) {
-                auto obj_result = result_elem.get_object();
-                if (!obj_result.error()) {
-                    auto obj = obj_result.value();
-                    EconomicIndicator economic_indicator;
-
-                    auto id_field = obj.find_field_unordered("id");
-                    if (!id_field.error()) {
-                        economic_indicator.id = std::string(id_field.value().get_string().value());
-                    }
-
-                    auto name_field = obj.find_field_unordered("name");
-                    if (!name_field.error()) {
-                        economic_indicator.name = std::string(name_field.value().get_string().value());
-                    }
-
-                    auto country_field = obj.find_field_unordered("country");
-                    if (!country_field.error()) {
-                        economic_indicator.country = std::string(country_field.value().get_string().value());
-                    }
-
-                    auto value_field = obj.find_field_unordered("value");
-                    if (!value_field.error()) {
-                        economic_indicator.value = value_field.value().get_double().value();
-                    }
-
-                    auto date_field = obj.find_field_unordered("date");
-                    if (!date_field.error()) {
-                        economic_indicator.date = std::string(date_field.value().get_string().value());
-                    }
-
-                    auto change_percent_field = obj.find_field_unordered("change_percent");
-                    if (!change_percent_field.error()) {
-                        economic_indicator.change_percent = change_percent_field.value().get_double().value();
+    collect_pages(path, params, results, [&](::simdjson::ondemand::object &root) {
+        auto results_field = root.find_field_unordered("results");
+        if (!results_field.error()) {
+            auto results_array = results_field.value().get_array();
+            if (!results_array.error()) {
+                for (auto result_elem : results_array.value()) {
+                    auto obj_result = result_elem.get_object();
+                    if (!obj_result.error()) {
+                        auto obj = obj_result.value();
+                        EconomicIndicator economic_indicator;
+
+                        auto id_field = obj.find_field_unordered("id");
+                        if (!id_field.error()) {
+                            economic_indicator.id =
+                                std::string(id_field.value().get_string().value());
+                        }
+
+                        auto name_field = obj.find_field_unordered("name");
+                        if (!name_field.error()) {
+                            economic_indicator.name =
+                                std::string(name_field.value().get_string().value());
+                        }
+
+                        auto country_field = obj.find_field_unordered("country");
+                        if (!country_field.error()) {
+                            economic_indicator.country =
+                                std::string(country_field.value().get_string().value());
+                        }
+
+                        auto value_field = obj.find_field_unordered("value");
+                        if (!value_field.error()) {
+                            economic_indicator.value = value_field.value().get_double().value();
+                        }
+
+                        auto date_field = obj.find_field_unordered("date");
+                        if (!date_field.error()) {
+                            economic_indicator.date =
+                                std::string(date_field.value().get_string().value());
+                        }
+
+                        auto change_percent_field = obj.find_field_unordered("change_percent");
+                        if (!change_percent_field.error()) {
+                            economic_indicator.change_percent =
+                                change_percent_field.value().get_double().value();
+                        }
+
+                        results.push_back(economic_indicator);
                     }
-
-                    results.push_back(economic_indicator);
                 }
             }
         }
-    }
+    });
 
     return results;
 }
@@ -104,7 +99,7 @@ std::vector<EconomicCalendarEvent> RESTClient::list_economic_calendar_events(
     std::optional<int> limit, const std::optional<std::string> &date_gte,
     const std::optional<std::string> &date_lte, const std::optional<std::string> &sort,
     const std::optional<std::string> &order) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
     if (country.has_value()) {
         params["country"] = country.value();
     }
@@ -128,71 +123,60 @@ std::vector<EconomicCalendarEvent> RESTClient::list_economic_calendar_events(
     }
 
     std::string path = "/v1/economic/calendar";
-    auto response = send_request(core::HttpMethod::Get, path, params);
-
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
-    if (doc_result.error()) {
-        throw std::runtime_error("Failed to parse JSON response");
-    }
-    auto& doc = doc_result.value();
-    auto root_obj = doc.get_object();
-    if (root_obj.error()) {
-        throw std::runtime_error("Response is not a JSON object");
-    }
 
     std::vector<EconomicCalendarEvent> results;
-    auto results_field = root_obj.value().find_field_unordered("results");
-    if (!results_field.error()) {
-        auto results_array = results_field.value().get_array();
-        if (!results_array.error()) {
-            for (auto result_elem : results_array.value()) {
-                auto obj_result = result_elem.get_object();
-                if (!obj_result.error()) {
-                    auto obj = obj_result.value();
-                    EconomicCalendarEvent event;
-
-                    auto id_field = obj.find_field_unordered("id");
-                    if (!id_field.error()) {
-                        event.id = std::string(id_field.value().get_string().value());
-                    }
-
-                    auto name_field = obj.find_field_unordered("name");
-                    if (!name_field.error()) {
-                        event.name = std::string(name_field.value().get_string().value());
-                    }
-
-                    auto country_field = obj.find_field_unordered("country");
-                    if (!country_field.error()) {
-                        event.country = std::string(country_field.value().get_string().value());
+    collect_pages(path, params, results, [&](::simdjson::ondemand::object &root) {
+        auto results_field = root.find_field_unordered("results");
+        if (!results_field.error()) {
+            auto results_array = results_field.value().get_array();
+            if (!results_array.error()) {
+                for (auto result_elem : results_array.value()) {
+                    auto obj_result = result_elem.get_object();
+                    if (!obj_result.error()) {
+                        auto obj = obj_result.value();
+                        EconomicCalendarEvent event;
+
+                        auto id_field = obj.find_field_unordered("id");
+                        if (!id_field.error()) {
+                            event.id = std::string(id_field.value().get_string().value());
+                        }
+
+                        auto name_field = obj.find_field_unordered("name");
+                        if (!name_field.error()) {
+                            event.name = std::string(name_field.value().get_string().value());
+                        }
+
+                        auto country_field = obj.find_field_unordered("country");
+                        if (!country_field.error()) {
+                            event.country = std::string(country_field.value().get_string().value());
+                        }
+
+                        auto date_field = obj.find_field_unordered("date");
+                        if (!date_field.error()) {
+                            event.date = std::string(date_field.value().get_string().value());
+                        }
+
+                        auto actual_field = obj.find_field_unordered("actual");
+                        if (!actual_field.error()) {
+                            event.actual = actual_field.value().get_double().value();
+                        }
+
+                        auto forecast_field = obj.find_field_unordered("forecast");
+                        if (!forecast_field.error()) {
+                            event.forecast = forecast_field.value().get_double().value();
+                        }
+
+                        auto previous_field = obj.find_field_unordered("previous");
+                        if (!previous_field.error()) {
+                            event.previous = previous_field.value().get_double().value();
+                        }
+
+                        results.push_back(event);
                     }
-
-                    auto date_field = obj.find_field_unordered("date");
-                    if (!date_field.error()) {
-                        event.date = std::string(date_field.value().get_string().value());
-                    }
-
-                    auto actual_field = obj.find_field_unordered("actual");
-                    if (!actual_field.error()) {
-                        event.actual = actual_field.value().get_double().value();
-                    }
-
-                    auto forecast_field = obj.find_field_unordered("forecast");
-                    if (!forecast_field.error()) {
-                        event.forecast = forecast_field.value().get_double().value();
-                    }
-
-                    auto previous_field = obj.find_field_unordered("previous");
-                    if (!previous_field.error()) {
-                        event.previous = previous_field.value().get_double().value();
-                    }
-
-                    results.push_back(event);
                 }
             }
         }
-    }
+    });
 
     return results;
 }
@@ -203,7 +187,7 @@ std::vector<EconomicDataPoint> RESTClient::get_economic_data_series(
     std::optional<int> limit, const std::optional<std::string> &date_gte,
     const std::optional<std::string> &date_lte, const std::optional<std::string> &sort,
     const std::optional<std::string> &order) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
     params["indicator"] = indicator;
     if (country.has_value()) {
         params["country"] = country.value();
@@ -227,9 +211,7 @@ std::vector<EconomicDataPoint> RESTClient::get_economic_data_series(
     std::string path = "/v1/economic/series";
     auto response = send_request(core::HttpMethod::Get, path, params);
 
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
+    auto doc_result = iterate_json(response.body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
@@ -291,7 +273,7 @@ std::vector<TreasuryYield> RESTClient::list_treasury_yields(
     std::optional<int> limit,
     const std::optional<std::string>& sort,
     const std::optional<std::string>& order) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
     if (date.has_value()) {
         params["date"] = date.value();
     }
@@ -321,96 +303,85 @@ std::vector<TreasuryYield> RESTClient::list_treasury_yields(
     }
 
     std::string path = "/fed/v1/treasury-yields";
-    auto response = send_request(core::HttpMethod::Get, path, params);
-
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
-    if (doc_result.error()) {
-        throw std::runtime_error("Failed to parse JSON response");
-    }
-    auto& doc = doc_result.value();
-    auto root_obj = doc.get_object();
-    if (root_obj.error()) {
-        throw std::runtime_error("Response is not a JSON object");
-    }
 
     std::vector<TreasuryYield> results;
-    auto results_field = root_obj.value().find_field_unordered("results");
-    if (!results_field.error()) {
-        auto results_array = results_field.value().get_array();
-        if (!results_array.error()) {
-            for (auto result_elem : results_array.value()) {
-                auto obj_result = result_elem.get_object();
-                if (!obj_result.error()) {
-                    auto obj = obj_result.value();
-                    TreasuryYield yield;
-
-                    auto date_field = obj.find_field_unordered("date");
-                    if (!date_field.error()) {
-                        yield.date = std::string(date_field.value().get_string().value());
-                    }
-
-                    auto yield_1_month_field = obj.find_field_unordered("yield_1_month");
-                    if (!yield_1_month_field.error()) {
-                        yield.yield_1_month = yield_1_month_field.value().get_double().value();
+    collect_pages(path, params, results, [&](::simdjson::ondemand::object &root) {
+        auto results_field = root.find_field_unordered("results");
+        if (!results_field.error()) {
+            auto results_array = results_field.value().get_array();
+            if (!results_array.error()) {
+                for (auto result_elem : results_array.value()) {
+                    auto obj_result = result_elem.get_object();
+                    if (!obj_result.error()) {
+                        auto obj = obj_result.value();
+                        TreasuryYield yield;
+
+                        auto date_field = obj.find_field_unordered("date");
+                        if (!date_field.error()) {
+                            yield.date = std::string(date_field.value().get_string().value());
+                        }
+
+                        auto yield_1_month_field = obj.find_field_unordered("yield_1_month");
+                        if (!yield_1_month_field.error()) {
+                            yield.yield_1_month = yield_1_month_field.value().get_double().value();
+                        }
+
+                        auto yield_3_month_field = obj.find_field_unordered("yield_3_month");
+                        if (!yield_3_month_field.error()) {
+                            yield.yield_3_month = yield_3_month_field.value().get_double().value();
+                        }
+
+                        auto yield_6_month_field = obj.find_field_unordered("yield_6_month");
+                        if (!yield_6_month_field.error()) {
+                            yield.yield_6_month = yield_6_month_field.value().get_double().value();
+                        }
+
+                        auto yield_1_year_field = obj.find_field_unordered("yield_1_year");
+                        if (!yield_1_year_field.error()) {
+                            yield.yield_1_year = yield_1_year_field.value().get_double().value();
+                        }
+
+                        auto yield_2_year_field = obj.find_field_unordered("yield_2_year");
+                        if (!yield_2_year_field.error()) {
+                            yield.yield_2_year = yield_2_year_field.value().get_double().value();
+                        }
+
+                        auto yield_3_year_field = obj.find_field_unordered("yield_3_year");
+                        if (!yield_3_year_field.error()) {
+                            yield.yield_3_year = yield_3_year_field.value().get_double().value();
+                        }
+
+                        auto yield_5_year_field = obj.find_field_unordered("yield_5_year");
+                        if (!yield_5_year_field.error()) {
+                            yield.yield_5_year = yield_5_year_field.value().get_double().value();
+                        }
+
+                        auto yield_7_year_field = obj.find_field_unordered("yield_7_year");
+                        if (!yield_7_year_field.error()) {
+                            yield.yield_7_year = yield_7_year_field.value().get_double().value();
+                        }
+
+                        auto yield_10_year_field = obj.find_field_unordered("yield_10_year");
+                        if (!yield_10_year_field.error()) {
+                            yield.yield_10_year = yield_10_year_field.value().get_double().value();
+                        }
+
+                        auto yield_20_year_field = obj.find_field_unordered("yield_20_year");
+                        if (!yield_20_year_field.error()) {
+                            yield.yield_20_year = yield_20_year_field.value().get_double().value();
+                        }
+
+                        auto yield_30_year_field = obj.find_field_unordered("yield_30_year");
+                        if (!yield_30_year_field.error()) {
+                            yield.yield_30_year = yield_30_year_field.value().get_double().value();
+                        }
+
+                        results.push_back(yield);
                     }
-
-                    auto yield_3_month_field = obj.find_field_unordered("yield_3_month");
-                    if (!yield_3_month_field.error()) {
-                        yield.yield_3_month = yield_3_month_field.value().get_double().value();
-                    }
-
-                    auto yield_6_month_field = obj.find_field_unordered("yield_6_month");
-                    if (!yield_6_month_field.error()) {
-                        yield.yield_6_month = yield_6_month_field.value().get_double().value();
-                    }
-
-                    auto yield_1_year_field = obj.find_field_unordered("yield_1_year");
-                    if (!yield_1_year_field.error()) {
-                        yield.yield_1_year = yield_1_year_field.value().get_double().value();
-                    }
-
-                    auto yield_2_year_field = obj.find_field_unordered("yield_2_year");
-                    if (!yield_2_year_field.error()) {
-                        yield.yield_2_year = yield_2_year_field.value().get_double().value();
-                    }
-
-                    auto yield_3_year_field = obj.find_field_unordered("yield_3_year");
-                    if (!yield_3_year_field.error()) {
-                        yield.yield_3_year = yield_3_year_field.value().get_double().value();
-                    }
-
-                    auto yield_5_year_field = obj.find_field_unordered("yield_5_year");
-                    if (!yield_5_year_field.error()) {
-                        yield.yield_5_year = yield_5_year_field.value().get_double().value();
-                    }
-
-                    auto yield_7_year_field = obj.find_field_unordered("yield_7_year");
-                    if (!yield_7_year_field.error()) {
-                        yield.yield_7_year = yield_7_year_field.value().get_double().value();
-                    }
-
-                    auto yield_10_year_field = obj.find_field_unordered("yield_10_year");
-                    if (!yield_10_year_field.error()) {
-                        yield.yield_10_year = yield_10_year_field.value().get_double().value();
-                    }
-
-                    auto yield_20_year_field = obj.find_field_unordered("yield_20_year");
-                    if (!yield_20_year_field.error()) {
-                        yield.yield_20_year = yield_20_year_field.value().get_double().value();
-                    }
-
-                    auto yield_30_year_field = obj.find_field_unordered("yield_30_year");
-                    if (!yield_30_year_field.error()) {
-                        yield.yield_30_year = yield_30_year_field.value().get_double().value();
-                    }
-
-                    results.push_back(yield);
                 }
             }
         }
-    }
+    });
 
     return results;
 }
@@ -425,7 +396,7 @@ std::vector<FedInflation> RESTClient::list_inflation(
     const std::optional<std::string>& date_lte,
     std::optional<int> limit,
     const std::optional<std::string>& sort) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
     if (date.has_value()) {
         params["date"] = date.value();
     }
@@ -452,71 +423,63 @@ std::vector<FedInflation> RESTClient::list_inflation(
     }
 
     std::string path = "/fed/v1/inflation";
-    auto response = send_request(core::HttpMethod::Get, path, params);
-
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
-    if (doc_result.error()) {
-        throw std::runtime_error("Failed to parse JSON response");
-    }
-    auto& doc = doc_result.value();
-    auto root_obj = doc.get_object();
-    if (root_obj.error()) {
-        throw std::runtime_error("Response is not a JSON object");
-    }
 
     std::vector<FedInflation> results;
-    auto results_field = root_obj.value().find_field_unordered("results");
-    if (!results_field.error()) {
-        auto results_array = results_field.value().get_array();
-        if (!results_array.error()) {
-            for (auto result_elem : results_array.value()) {
-                auto obj_result = result_elem.get_object();
-                if (!obj_result.error()) {
-                    auto obj = obj_result.value();
-                    FedInflation inflation;
-
-                    auto date_field = obj.find_field_unordered("date");
-                    if (!date_field.error()) {
-                        inflation.date = std::string(date_field.value().get_string().value());
-                    }
-
-                    auto cpi_field = obj.find_field_unordered("cpi");
-                    if (!cpi_field.error()) {
-                        inflation.cpi = cpi_field.value().get_double().value();
-                    }
-
-                    auto cpi_core_field = obj.find_field_unordered("cpi_core");
-                    if (!cpi_core_field.error()) {
-                        inflation.cpi_core = cpi_core_field.value().get_double().value();
+    collect_pages(path, params, results, [&](::simdjson::ondemand::object &root) {
+        auto results_field = root.find_field_unordered("results");
+        if (!results_field.error()) {
+            auto results_array = results_field.value().get_array();
+            if (!results_array.error()) {
+                for (auto result_elem : results_array.value()) {
+                    auto obj_result = result_elem.get_object();
+                    if (!obj_result.error()) {
+                        auto obj = obj_result.value();
+                        FedInflation inflation;
+
+                        auto date_field = obj.find_field_unordered("date");
+                        if (!date_field.error()) {
+                            inflation.date = std::string(date_field.value().get_string().value());
+                        }
+
+                        auto cpi_field = obj.find_field_unordered("cpi");
+                        if (!cpi_field.error()) {
+                            inflation.cpi = cpi_field.value().get_double().value();
+                        }
+
+                        auto cpi_core_field = obj.find_field_unordered("cpi_core");
+                        if (!cpi_core_field.error()) {
+                            inflation.cpi_core = cpi_core_field.value().get_double().value();
+                        }
+
+                        auto cpi_year_over_year_field =
+                            obj.find_field_unordered("cpi_year_over_year");
+                        if (!cpi_year_over_year_field.error()) {
+                            inflation.cpi_year_over_year =
+                                cpi_year_over_year_field.value().get_double().value();
+                        }
+
+                        auto pce_field = obj.find_field_unordered("pce");
+                        if (!pce_field.error()) {
+                            inflation.pce = pce_field.value().get_double().value();
+                        }
+
+                        auto pce_core_field = obj.find_field_unordered("pce_core");
+                        if (!pce_core_field.error()) {
+                            inflation.pce_core = pce_core_field.value().get_double().value();
+                        }
+
+                        auto pce_spending_field = obj.find_field_unordered("pce_spending");
+                        if (!pce_spending_field.error()) {
+                            inflation.pce_spending =
+                                pce_spending_field.value().get_double().value();
+                        }
+
+                        results.push_back(inflation);
                     }
-
-                    auto cpi_year_over_year_field = obj.find_field_unordered("cpi_year_over_year");
-                    if (!cpi_year_over_year_field.error()) {
-                        inflation.cpi_year_over_year = cpi_year_over_year_field.value().get_double().value();
-                    }
-
-                    auto pce_field = obj.find_field_unordered("pce");
-                    if (!pce_field.error()) {
-                        inflation.pce = pce_field.value().get_double().value();
-                    }
-
-                    auto pce_core_field = obj.find_field_unordered("pce_core");
-                    if (!pce_core_field.error()) {
-                        inflation.pce_core = pce_core_field.value().get_double().value();
-                    }
-
-                    auto pce_spending_field = obj.find_field_unordered("pce_spending");
-                    if (!pce_spending_field.error()) {
-                        inflation.pce_spending = pce_spending_field.value().get_double().value();
-                    }
-
-                    results.push_back(inflation);
                 }
             }
         }
-    }
+    });
 
     return results;
 }
@@ -531,7 +494,7 @@ std::vector<FedInflationExpectations> RESTClient::list_inflation_expectations(
     const std::optional<std::string>& date_lte,
     std::optional<int> limit,
     const std::optional<std::string>& sort) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
     if (date.has_value()) {
         params["date"] = date.value();
     }
@@ -558,76 +521,74 @@ std::vector<FedInflationExpectations> RESTClient::list_inflation_expectations(
     }
 
     std::string path = "/fed/v1/inflation-expectations";
-    auto response = send_request(core::HttpMethod::Get, path, params);
-
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
-    if (doc_result.error()) {
-        throw std::runtime_error("Failed to parse JSON response");
-    }
-    auto& doc = doc_result.value();
-    auto root_obj = doc.get_object();
-    if (root_obj.error()) {
-        throw std::runtime_error("Response is not a JSON object");
-    }
 
     std::vector<FedInflationExpectations> results;
-    auto results_field = root_obj.value().find_field_unordered("results");
-    if (!results_field.error()) {
-        auto results_array = results_field.value().get_array();
-        if (!results_array.error()) {
-            for (auto result_elem : results_array.value()) {
-                auto obj_result = result_elem.get_object();
-                if (!obj_result.error()) {
-                    auto obj = obj_result.value();
-                    FedInflationExpectations expectations;
-
-                    auto date_field = obj.find_field_unordered("date");
-                    if (!date_field.error()) {
-                        expectations.date = std::string(date_field.value().get_string().value());
-                    }
-
-                    auto forward_years_5_to_10_field = obj.find_field_unordered("forward_years_5_to_10");
-                    if (!forward_years_5_to_10_field.error()) {
-                        expectations.forward_years_5_to_10 = forward_years_5_to_10_field.value().get_double().value();
+    collect_pages(path, params, results, [&](::simdjson::ondemand::object &root) {
+        auto results_field = root.find_field_unordered("results");
+        if (!results_field.error()) {
+            auto results_array = results_field.value().get_array();
+            if (!results_array.error()) {
+                for (auto result_elem : results_array.value()) {
+                    auto obj_result = result_elem.get_object();
+                    if (!obj_result.error()) {
+                        auto obj = obj_result.value();
+                        FedInflationExpectations expectations;
+
+                        auto date_field = obj.find_field_unordered("date");
+                        if (!date_field.error()) {
+                            expectations.date =
+                                std::string(date_field.value().get_string().value());
+                        }
+
+                        auto forward_years_5_to_10_field =
+                            obj.find_field_unordered("forward_years_5_to_10");
+                        if (!forward_years_5_to_10_field.error()) {
+                            expectations.forward_years_5_to_10 =
+                                forward_years_5_to_10_field.value().get_double().value();
+                        }
+
+                        auto market_10_year_field = obj.find_field_unordered("market_10_year");
+                        if (!market_10_year_field.error()) {
+                            expectations.market_10_year =
+                                market_10_year_field.value().get_double().value();
+                        }
+
+                        auto market_5_year_field = obj.find_field_unordered("market_5_year");
+                        if (!market_5_year_field.error()) {
+                            expectations.market_5_year =
+                                market_5_year_field.value().get_double().value();
+                        }
+
+                        auto model_10_year_field = obj.find_field_unordered("model_10_year");
+                        if (!model_10_year_field.error()) {
+                            expectations.model_10_year =
+                                model_10_year_field.value().get_double().value();
+                        }
+
+                        auto model_1_year_field = obj.find_field_unordered("model_1_year");
+                        if (!model_1_year_field.error()) {
+                            expectations.model_1_year =
+                                model_1_year_field.value().get_double().value();
+                        }
+
+                        auto model_30_year_field = obj.find_field_unordered("model_30_year");
+                        if (!model_30_year_field.error()) {
+                            expectations.model_30_year =
+                                model_30_year_field.value().get_double().value();
+                        }
+
+                        auto model_5_year_field = obj.find_field_unordered("model_5_year");
+                        if (!model_5_year_field.error()) {
+                            expectations.model_5_year =
+                                model_5_year_field.value().get_double().value();
+                        }
+
+                        results.push_back(expectations);
                     }
-
-                    auto market_10_year_field = obj.find_field_unordered("market_10_year");
-                    if (!market_10_year_field.error()) {
-                        expectations.market_10_year = market_10_year_field.value().get_double().value();
-                    }
-
-                    auto market_5_year_field = obj.find_field_unordered("market_5_year");
-                    if (!market_5_year_field.error()) {
-                        expectations.market_5_year = market_5_year_field.value().get_double().value();
-                    }
-
-                    auto model_10_year_field = obj.find_field_unordered("model_10_year");
-                    if (!model_10_year_field.error()) {
-                        expectations.model_10_year = model_10_year_field.value().get_double().value();
-                    }
-
-                    auto model_1_year_field = obj.find_field_unordered("model_1_year");
-                    if (!model_1_year_field.error()) {
-                        expectations.model_1_year = model_1_year_field.value().get_double().value();
-                    }
-
-                    auto model_30_year_field = obj.find_field_unordered("model_30_year");
-                    if (!model_30_year_field.error()) {
-                        expectations.model_30_year = model_30_year_field.value().get_double().value();
-                    }
-
-                    auto model_5_year_field = obj.find_field_unordered("model_5_year");
-                    if (!model_5_year_field.error()) {
-                        expectations.model_5_year = model_5_year_field.value().get_double().value();
-                    }
-
-                    results.push_back(expectations);
                 }
             }
         }
-    }
+    });
 
     return results;
 }
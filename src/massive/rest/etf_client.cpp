@@ -1,4 +1,5 @@
 #include "massive/rest/client.hpp"
+#include "massive/rest/json_parser.hpp"
 #include <simdjson/ondemand.h>
 #include <stdexcept>
 
@@ -11,7 +12,7 @@ std::vector<EtfListItem> RESTClient::list_etfs(const std::optional<std::string>
                                                std::optional<int> limit,
                                                const std::optional<std::string> &sort,
                                                const std::optional<std::string> &order) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
     if (ticker.has_value()) {
         params["ticker"] = ticker.value();
     }
@@ -32,66 +33,55 @@ std::vector<EtfListItem> RESTClient::list_etfs(const std::optional<std::string>
     }
 
     std::string path = "/v3/reference/etfs";
-    auto response = send_request(core::HttpMethod::Get, path, params);
-
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
-    if (doc_result.error()) {
-        throw std::runtime_error("Failed to parse JSON response");
-    }
-    auto& doc = doc_result.value();
-    auto root_obj = doc.get_object();
-    if (root_obj.error()) {
-        throw std::runtime_error("Response is not a JSON object");
-    }
 
     std::vector<EtfListItem> results;
-    auto results_field = root_obj.value().find_field_unordered("results");
-    if (!results_field.error()) {
-        auto results_array = results_field.value().get_array();
-        if (!results_array.error()) {
-            for (auto result_elem : results_array.value()) {
-                auto obj_result = result_elem.get_object();
-                if (!obj_result.error()) {
-                    auto obj = obj_result.value();
-                    EtfListItem etf;
-
-                    auto ticker_field = obj.find_field_unordered("ticker");
-                    if (!ticker_field.error()) {
-                        etf.ticker = std::string(ticker_field.value().get_string().value());
-                    }
-
-                    auto name_field = obj.find_field_unordered("name");
-                    if (!name_field.error()) {
-                        etf.name = std::string(name_field.value().get_string().value());
-                    }
-
-                    auto exchange_field = obj.find_field_unordered("exchange");
-                    if (!exchange_field.error()) {
-                        etf.exchange = std::string(exchange_field.value().get_string().value());
-                    }
-
-                    auto total_assets_field = obj.find_field_unordered("total_assets");
-                    if (!total_assets_field.error()) {
-                        etf.total_assets = total_assets_field.value().get_double().value();
+    collect_pages(path, params, results, [&](::simdjson::ondemand::object &root) {
+        auto results_field = root.find_field_unordered("results");
+        if (!results_field.error()) {
+            auto results_array = results_field.value().get_array();
+            if (!results_array.error()) {
+                for (auto result_elem : results_array.value()) {
+                    auto obj_result = result_elem.get_object();
+                    if (!obj_result.error()) {
+                        auto obj = obj_result.value();
+                        EtfListItem etf;
+
+                        auto ticker_field = obj.find_field_unordered("ticker");
+                        if (!ticker_field.error()) {
+                            etf.ticker = std::string(ticker_field.value().get_string().value());
+                        }
+
+                        auto name_field = obj.find_field_unordered("name");
+                        if (!name_field.error()) {
+                            etf.name = std::string(name_field.value().get_string().value());
+                        }
+
+                        auto exchange_field = obj.find_field_unordered("exchange");
+                        if (!exchange_field.error()) {
+                            etf.exchange = std::string(exchange_field.value().get_string().value());
+                        }
+
+                        auto total_assets_field = obj.find_field_unordered("total_assets");
+                        if (!total_assets_field.error()) {
+                            etf.total_assets = total_assets_field.value().get_double().value();
+                        }
+
+                        auto nav_field = obj.find_field_unordered("nav");
+                        if (!nav_field.error()) {
+                            etf.nav = nav_field.value().get_double().value();
+                        }
+
+                        auto expense_ratio_field = obj.find_field_unordered("expense_ratio");
+                        if (!expense_ratio_field.error()) {
+                            etf.expense_ratio = expense_ratio_field.value().get_double().value();
+                        }
+
+                        results.push_back(etf);
                     }
-
-                    auto nav_field = obj.find_field_unordered("nav");
-                    if (!nav_field.error()) {
-                        etf.nav = nav_field.value().get_double().value();
-                    }
-
-                    auto expense_ratio_field = obj.find_field_unordered("expense_ratio");
-                    if (!expense_ratio_field.error()) {
-                        etf.expense_ratio = expense_ratio_field.value().get_double().value();
-                    }
-
-                    results.push_back(etf);
                 }
             }
         }
-    }
+    });
 
     return results;
 }
@@ -101,9 +91,7 @@ EtfDetails RESTClient::get_etf_details(const std::string &ticker) {
     std::string path = "/v3/reference/etfs/" + ticker;
     auto response = send_request(core::HttpMethod::Get, path);
 
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
+    auto doc_result = iterate_json(response.body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
@@ -171,7 +159,7 @@ EtfDetails RESTClient::get_etf_details(const std::string &ticker) {
 std::vector<EtfHolding> RESTClient::list_etf_holdings(const std::string &ticker,
                                                       std::optional<int> limit,
                                                       const std::optional<std::string> &date) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
     if (limit.has_value()) {
         params["limit"] = std::to_string(limit.value());
     }
@@ -180,61 +168,50 @@ std::vector<EtfHolding> RESTClient::list_etf_holdings(const std::string &ticker,
     }
 
     std::string path = "/v3/reference/etfs/" + ticker + "/holdings";
-    auto response = send_request(core::HttpMethod::Get, path, params);
-
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
-    if (doc_result.error()) {
-        throw std::runtime_error("Failed to parse JSON response");
-    }
-    auto& doc = doc_result.value();
-    auto root_obj = doc.get_object();
-    if (root_obj.error()) {
-        throw std::runtime_error("Response is not a JSON object");
-    }
 
     std::vector<EtfHolding> results;
-    auto results_field = root_obj.value().find_field_unordered("results");
-    if (!results_field.error()) {
-        auto results_array = results_field.value().get_array();
-        if (!results_array.error()) {
-            for (auto result_elem : results_array.value()) {
-                auto obj_result = result_elem.get_object();
-                if (!obj_result.error()) {
-                    auto obj = obj_result.value();
-                    EtfHolding holding;
-
-                    auto ticker_field = obj.find_field_unordered("ticker");
-                    if (!ticker_field.error()) {
-                        holding.ticker = std::string(ticker_field.value().get_string().value());
-                    }
-
-                    auto name_field = obj.find_field_unordered("name");
-                    if (!name_field.error()) {
-                        holding.name = std::string(name_field.value().get_string().value());
-                    }
-
-                    auto weight_field = obj.find_field_unordered("weight");
-                    if (!weight_field.error()) {
-                        holding.weight = weight_field.value().get_double().value();
+    collect_pages(path, params, results, [&](::simdjson::ondemand::object &root) {
+        auto results_field = root.find_field_unordered("results");
+        if (!results_field.error()) {
+            auto results_array = results_field.value().get_array();
+            if (!results_array.error()) {
+                for (auto result_elem : results_array.value()) {
+                    auto obj_result = result_elem.get_object();
+                    if (!obj_result.error()) {
+                        auto obj = obj_result.value();
+                        EtfHolding holding;
+
+                        auto ticker_field = obj.find_field_unordered("ticker");
+                        if (!ticker_field.error()) {
+                            holding.ticker = std::string(ticker_field.value().get_string().value());
+                        }
+
+                        auto name_field = obj.find_field_unordered("name");
+                        if (!name_field.error()) {
+                            holding.name = std::string(name_field.value().get_string().value());
+                        }
+
+                        auto weight_field = obj.find_field_unordered("weight");
+                        if (!weight_field.error()) {
+                            holding.weight = weight_field.value().get_double().value();
+                        }
+
+                        auto shares_field = obj.find_field_unordered("shares");
+                        if (!shares_field.error()) {
+                            holding.shares = shares_field.value().get_int64().value();
+                        }
+
+                        auto market_value_field = obj.find_field_unordered("market_value");
+                        if (!market_value_field.error()) {
+                            holding.market_value = market_value_field.value().get_double().value();
+                        }
+
+                        results.push_back(holding);
                     }
-
-                    auto shares_field = obj.find_field_unordered("shares");
-                    if (!shares_field.error()) {
-                        holding.shares = shares_field.value().get_int64().value();
-                    }
-
-                    auto market_value_field = obj.find_field_unordered("market_value");
-                    if (!market_value_field.error()) {
-                        holding.market_value = market_value_field.value().get_double().value();
-                    }
-
-                    results.push_back(holding);
                 }
             }
         }
-    }
+    });
 
     return results;
 }
@@ -244,7 +221,7 @@ std::vector<EtfPerformance> RESTClient::get_etf_performance(
     const std::string &ticker, const std::optional<std::string> &date_gte,
     const std::optional<std::string> &date_lte, std::optional<int> limit,
     const std::optional<std::string> &sort, const std::optional<std::string> &order) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
     if (date_gte.has_value()) {
         params["date.gte"] = date_gte.value();
     }
@@ -264,9 +241,7 @@ std::vector<EtfPerformance> RESTClient::get_etf_performance(
     std::string path = "/v3/reference/etfs/" + ticker + "/performance";
     auto response = send_request(core::HttpMethod::Get, path, params);
 
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
+    auto doc_result = iterate_json(response.body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
@@ -329,7 +304,7 @@ std::vector<EtfGlobalAnalytics> RESTClient::get_etf_global_analytics(
     const std::optional<std::string>& effective_date,
     std::optional<int> limit,
     const std::optional<std::string>& sort) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
     if (composite_ticker.has_value()) {
         params["composite_ticker"] = composite_ticker.value();
     }
@@ -352,9 +327,7 @@ std::vector<EtfGlobalAnalytics> RESTClient::get_etf_global_analytics(
     std::string path = "/etf-global/v1/analytics";
     auto response = send_request(core::HttpMethod::Get, path, params);
 
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
+    auto doc_result = iterate_json(response.body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
@@ -377,22 +350,26 @@ std::vector<EtfGlobalAnalytics> RESTClient::get_etf_global_analytics(
 
                     auto composite_ticker_field = obj.find_field_unordered("composite_ticker");
                     if (!composite_ticker_field.error()) {
-                        analytics.composite_ticker = std::string(composite_ticker_field.value().get_string().value());
+                        analytics.composite_ticker =
+                            std::string(composite_ticker_field.value().get_string().value());
                     }
 
                     auto effective_date_field = obj.find_field_unordered("effective_date");
                     if (!effective_date_field.error()) {
-                        analytics.effective_date = std::string(effective_date_field.value().get_string().value());
+                        analytics.effective_date =
+                            std::string(effective_date_field.value().get_string().value());
                     }
 
                     auto processed_date_field = obj.find_field_unordered("processed_date");
                     if (!processed_date_field.error()) {
-                        analytics.processed_date = std::string(processed_date_field.value().get_string().value());
+                        analytics.processed_date =
+                            std::string(processed_date_field.value().get_string().value());
                     }
 
                     auto quant_total_score_field = obj.find_field_unordered("quant_total_score");
                     if (!quant_total_score_field.error()) {
-                        analytics.quant_total_score = quant_total_score_field.value().get_double().value();
+                        analytics.quant_total_score =
+                            quant_total_score_field.value().get_double().value();
                     }
 
                     auto reward_score_field = obj.find_field_unordered("reward_score");
@@ -402,12 +379,14 @@ std::vector<EtfGlobalAnalytics> RESTClient::get_etf_global_analytics(
 
                     auto risk_total_score_field = obj.find_field_unordered("risk_total_score");
                     if (!risk_total_score_field.error()) {
-                        analytics.risk_total_score = risk_total_score_field.value().get_double().value();
+                        analytics.risk_total_score =
+                            risk_total_score_field.value().get_double().value();
                     }
 
                     auto quant_grade_field = obj.find_field_unordered("quant_grade");
                     if (!quant_grade_field.error()) {
-                        analytics.quant_grade = std::string(quant_grade_field.value().get_string().value());
+                        analytics.quant_grade =
+                            std::string(quant_grade_field.value().get_string().value());
                     }
 
                     results.push_back(analytics);
@@ -428,7 +407,7 @@ std::vector<EtfGlobalConstituent> RESTClient::get_etf_global_constituents(
     const std::optional<std::string>& processed_date,
     std::optional<int> limit,
     const std::optional<std::string>& sort) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
     if (composite_ticker.has_value()) {
         params["composite_ticker"] = composite_ticker.value();
     }
@@ -454,9 +433,7 @@ std::vector<EtfGlobalConstituent> RESTClient::get_etf_global_constituents(
     std::string path = "/etf-global/v1/constituents";
     auto response = send_request(core::HttpMethod::Get, path, params);
 
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
+    auto doc_result = iterate_json(response.body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
@@ -479,17 +456,20 @@ std::vector<EtfGlobalConstituent> RESTClient::get_etf_global_constituents(
 
                     auto composite_ticker_field = obj.find_field_unordered("composite_ticker");
                     if (!composite_ticker_field.error()) {
-                        constituent.composite_ticker = std::string(composite_ticker_field.value().get_string().value());
+                        constituent.composite_ticker =
+                            std::string(composite_ticker_field.value().get_string().value());
                     }
 
                     auto constituent_ticker_field = obj.find_field_unordered("constituent_ticker");
                     if (!constituent_ticker_field.error()) {
-                        constituent.constituent_ticker = std::string(constituent_ticker_field.value().get_string().value());
+                        constituent.constituent_ticker =
+                            std::string(constituent_ticker_field.value().get_string().value());
                     }
 
                     auto constituent_name_field = obj.find_field_unordered("constituent_name");
                     if (!constituent_name_field.error()) {
-                        constituent.constituent_name = std::string(constituent_name_field.value().get_string().value());
+                        constituent.constituent_name =
+                            std::string(constituent_name_field.value().get_string().value());
                     }
 
                     auto weight_field = obj.find_field_unordered("weight");
@@ -524,7 +504,7 @@ std::vector<EtfGlobalFundFlow> RESTClient::get_etf_global_fund_flows(
     const std::optional<std::string>& effective_date,
     std::optional<int> limit,
     const std::optional<std::string>& sort) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
     if (composite_ticker.has_value()) {
         params["composite_ticker"] = composite_ticker.value();
     }
@@ -547,9 +527,7 @@ std::vector<EtfGlobalFundFlow> RESTClient::get_etf_global_fund_flows(
     std::string path = "/etf-global/v1/fund-flows";
     auto response = send_request(core::HttpMethod::Get, path, params);
 
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
+    auto doc_result = iterate_json(response.body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
@@ -572,17 +550,20 @@ std::vector<EtfGlobalFundFlow> RESTClient::get_etf_global_fund_flows(
 
                     auto composite_ticker_field = obj.find_field_unordered("composite_ticker");
                     if (!composite_ticker_field.error()) {
-                        fund_flow.composite_ticker = std::string(composite_ticker_field.value().get_string().value());
+                        fund_flow.composite_ticker =
+                            std::string(composite_ticker_field.value().get_string().value());
                     }
 
                     auto effective_date_field = obj.find_field_unordered("effective_date");
                     if (!effective_date_field.error()) {
-                        fund_flow.effective_date = std::string(effective_date_field.value().get_string().value());
+                        fund_flow.effective_date =
+                            std::string(effective_date_field.value().get_string().value());
                     }
 
                     auto processed_date_field = obj.find_field_unordered("processed_date");
                     if (!processed_date_field.error()) {
-                        fund_flow.processed_date = std::string(processed_date_field.value().get_string().value());
+                        fund_flow.processed_date =
+                            std::string(processed_date_field.value().get_string().value());
                     }
 
                     auto fund_flow_field = obj.find_field_unordered("fund_flow");
@@ -597,7 +578,8 @@ std::vector<EtfGlobalFundFlow> RESTClient::get_etf_global_fund_flows(
 
                     auto shares_outstanding_field = obj.find_field_unordered("shares_outstanding");
                     if (!shares_outstanding_field.error()) {
-                        fund_flow.shares_outstanding = shares_outstanding_field.value().get_double().value();
+                        fund_flow.shares_outstanding =
+                            shares_outstanding_field.value().get_double().value();
                     }
 
                     results.push_back(fund_flow);
@@ -617,7 +599,7 @@ std::vector<EtfGlobalProfile> RESTClient::get_etf_global_profiles(
     const std::optional<std::string>& effective_date,
     std::optional<int> limit,
     const std::optional<std::string>& sort) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
     if (composite_ticker.has_value()) {
         params["composite_ticker"] = composite_ticker.value();
     }
@@ -640,9 +622,7 @@ std::vector<EtfGlobalProfile> RESTClient::get_etf_global_profiles(
     std::string path = "/etf-global/v1/profiles";
     auto response = send_request(core::HttpMethod::Get, path, params);
 
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
+    auto doc_result = iterate_json(response.body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
@@ -665,22 +645,26 @@ std::vector<EtfGlobalProfile> RESTClient::get_etf_global_profiles(
 
                     auto composite_ticker_field = obj.find_field_unordered("composite_ticker");
                     if (!composite_ticker_field.error()) {
-                        profile.composite_ticker = std::string(composite_ticker_field.value().get_string().value());
+                        profile.composite_ticker =
+                            std::string(composite_ticker_field.value().get_string().value());
                     }
 
                     auto effective_date_field = obj.find_field_unordered("effective_date");
                     if (!effective_date_field.error()) {
-                        profile.effective_date = std::string(effective_date_field.value().get_string().value());
+                        profile.effective_date =
+                            std::string(effective_date_field.value().get_string().value());
                     }
 
                     auto processed_date_field = obj.find_field_unordered("processed_date");
                     if (!processed_date_field.error()) {
-                        profile.processed_date = std::string(processed_date_field.value().get_string().value());
+                        profile.processed_date =
+                            std::string(processed_date_field.value().get_string().value());
                     }
 
                     auto asset_class_field = obj.find_field_unordered("asset_class");
                     if (!asset_class_field.error()) {
-                        profile.asset_class = std::string(asset_class_field.value().get_string().value());
+                        profile.asset_class =
+                            std::string(asset_class_field.value().get_string().value());
                     }
 
                     auto category_field = obj.find_field_unordered("category");
@@ -690,7 +674,8 @@ std::vector<EtfGlobalProfile> RESTClient::get_etf_global_profiles(
 
                     auto description_field = obj.find_field_unordered("description");
                     if (!description_field.error()) {
-                        profile.description = std::string(description_field.value().get_string().value());
+                        profile.description =
+                            std::string(description_field.value().get_string().value());
                     }
 
                     auto aum_field = obj.find_field_unordered("aum");
@@ -720,7 +705,7 @@ std::vector<EtfGlobalTaxonomy> RESTClient::get_etf_global_taxonomies(
     const std::optional<std::string>& effective_date,
     std::optional<int> limit,
     const std::optional<std::string>& sort) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
     if (composite_ticker.has_value()) {
         params["composite_ticker"] = composite_ticker.value();
     }
@@ -743,9 +728,7 @@ std::vector<EtfGlobalTaxonomy> RESTClient::get_etf_global_taxonomies(
     std::string path = "/etf-global/v1/taxonomies";
     auto response = send_request(core::HttpMethod::Get, path, params);
 
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
+    auto doc_result = iterate_json(response.body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
@@ -768,27 +751,32 @@ std::vector<EtfGlobalTaxonomy> RESTClient::get_etf_global_taxonomies(
 
                     auto composite_ticker_field = obj.find_field_unordered("composite_ticker");
                     if (!composite_ticker_field.error()) {
-                        taxonomy.composite_ticker = std::string(composite_ticker_field.value().get_string().value());
+                        taxonomy.composite_ticker =
+                            std::string(composite_ticker_field.value().get_string().value());
                     }
 
                     auto effective_date_field = obj.find_field_unordered("effective_date");
                     if (!effective_date_field.error()) {
-                        taxonomy.effective_date = std::string(effective_date_field.value().get_string().value());
+                        taxonomy.effective_date =
+                            std::string(effective_date_field.value().get_string().value());
                     }
 
                     auto processed_date_field = obj.find_field_unordered("processed_date");
                     if (!processed_date_field.error()) {
-                        taxonomy.processed_date = std::string(processed_date_field.value().get_string().value());
+                        taxonomy.processed_date =
+                            std::string(processed_date_field.value().get_string().value());
                     }
 
                     auto asset_class_field = obj.find_field_unordered("asset_class");
                     if (!asset_class_field.error()) {
-                        taxonomy.asset_class = std::string(asset_class_field.value().get_string().value());
+                        taxonomy.asset_class =
+                            std::string(asset_class_field.value().get_string().value());
                     }
 
                     auto category_field = obj.find_field_unordered("category");
                     if (!category_field.error()) {
-                        taxonomy.category = std::string(category_field.value().get_string().value());
+                        taxonomy.category =
+                            std::string(category_field.value().get_string().value());
                     }
 
                     auto country_field = obj.find_field_unordered("country");
@@ -798,17 +786,20 @@ std::vector<EtfGlobalTaxonomy> RESTClient::get_etf_global_taxonomies(
 
                     auto description_field = obj.find_field_unordered("description");
                     if (!description_field.error()) {
-                        taxonomy.description = std::string(description_field.value().get_string().value());
+                        taxonomy.description =
+                            std::string(description_field.value().get_string().value());
                     }
 
                     auto objective_field = obj.find_field_unordered("objective");
                     if (!objective_field.error()) {
-                        taxonomy.objective = std::string(objective_field.value().get_string().value());
+                        taxonomy.objective =
+                            std::string(objective_field.value().get_string().value());
                     }
 
                     auto product_type_field = obj.find_field_unordered("product_type");
                     if (!product_type_field.error()) {
-                        taxonomy.product_type = std::string(product_type_field.value().get_string().value());
+                        taxonomy.product_type =
+                            std::string(product_type_field.value().get_string().value());
                     }
 
                     results.push_back(taxonomy);
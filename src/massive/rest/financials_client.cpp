@@ -6,7 +6,7 @@
 namespace massive::rest {
 
 // Helper function to add optional string parameter
-static void add_param(std::map<std::string, std::string> &params, const std::string &key,
+static void add_param(QueryParams &params, std::string_view key,
                       const std::optional<std::string> &value) {
     if (value.has_value()) {
         params[key] = value.value();
@@ -14,7 +14,7 @@ static void add_param(std::map<std::string, std::string> &params, const std::str
 }
 
 // Helper function to add optional double parameter
-static void add_param(std::map<std::string, std::string> &params, const std::string &key,
+static void add_param(QueryParams &params, std::string_view key,
                       const std::optional<double> &value) {
     if (value.has_value()) {
         params[key] = std::to_string(value.value());
@@ -22,7 +22,7 @@ static void add_param(std::map<std::string, std::string> &params, const std::str
 }
 
 // Helper function to add optional int parameter
-static void add_param(std::map<std::string, std::string> &params, const std::string &key,
+static void add_param(QueryParams &params, std::string_view key,
                       const std::optional<int> &value) {
     if (value.has_value()) {
         params[key] = std::to_string(value.value());
@@ -53,7 +53,7 @@ std::vector<BalanceSheet> RESTClient::list_balance_sheets(
     const std::optional<std::string> &timeframe_gt, const std::optional<std::string> &timeframe_gte,
     const std::optional<std::string> &timeframe_lt, const std::optional<std::string> &timeframe_lte,
     std::optional<int> limit, const std::optional<std::string> &sort) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
 
     add_param(params, "cik", cik);
     add_param(params, "cik.any_of", cik_any_of);
@@ -94,100 +94,90 @@ std::vector<BalanceSheet> RESTClient::list_balance_sheets(
     add_param(params, "sort", sort);
 
     std::string path = "/stocks/financials/v1/balance-sheets";
-    auto response = send_request(core::HttpMethod::Get, path, params);
-
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
-    if (doc_result.error()) {
-        throw std::runtime_error("Failed to parse JSON response");
-    }
-    auto& doc = doc_result.value();
-    auto root_obj = doc.get_object();
-    if (root_obj.error()) {
-        throw std::runtime_error("Response is not a JSON object");
-    }
 
     std::vector<BalanceSheet> results;
-    auto results_field = root_obj.value().find_field_unordered("results");
-    if (!results_field.error()) {
-        auto results_array = results_field.value().get_array();
-        if (!results_array.error()) {
-            for (auto result_elem : results_array.value()) {
-                auto obj_result = result_elem.get_object();
-                if (!obj_result.error()) {
-                    auto obj = obj_result.value();
-                    BalanceSheet sheet;
-
-                    // Parse basic fields - full implementation would parse all DataPoint fields
-                    auto ticker_field = obj.find_field_unordered("ticker");
-                    if (!ticker_field.error()) {
-                        sheet.ticker = std::string(ticker_field.value().get_string().value());
-                    }
+    collect_pages(path, params, results, [&](::simdjson::ondemand::object &root) {
+        auto results_field = root.find_field_unordered("results");
+        if (!results_field.error()) {
+            auto results_array = results_field.value().get_array();
+            if (!results_array.error()) {
+                for (auto result_elem : results_array.value()) {
+                    auto obj_result = result_elem.get_object();
+                    if (!obj_result.error()) {
+                        auto obj = obj_result.value();
+                        BalanceSheet sheet;
+
+                        // Parse basic fields - full implementation would parse all DataPoint fields
+                        auto ticker_field = obj.find_field_unordered("ticker");
+                        if (!ticker_field.error()) {
+                            sheet.ticker = std::string(ticker_field.value().get_string().value());
+                        }
 
-                    auto period_field = obj.find_field_unordered("period");
-                    if (!period_field.error()) {
-                        sheet.period = std::string(period_field.value().get_string().value());
-                    }
+                        auto period_field = obj.find_field_unordered("period");
+                        if (!period_field.error()) {
+                            sheet.period = std::string(period_field.value().get_string().value());
+                        }
 
-                    auto calendar_date_field = obj.find_field_unordered("calendar_date");
-                    if (!calendar_date_field.error()) {
-                        sheet.calendar_date =
-                            std::string(calendar_date_field.value().get_string().value());
-                    }
+                        auto calendar_date_field = obj.find_field_unordered("calendar_date");
+                        if (!calendar_date_field.error()) {
+                            sheet.calendar_date =
+                                std::string(calendar_date_field.value().get_string().value());
+                        }
 
-                    auto report_period_field = obj.find_field_unordered("report_period");
-                    if (!report_period_field.error()) {
-                        sheet.report_period =
-                            std::string(report_period_field.value().get_string().value());
-                    }
+                        auto report_period_field = obj.find_field_unordered("report_period");
+                        if (!report_period_field.error()) {
+                            sheet.report_period =
+                                std::string(report_period_field.value().get_string().value());
+                        }
 
-                    auto updated_utc_field = obj.find_field_unordered("updated_utc");
-                    if (!updated_utc_field.error()) {
-                        sheet.updated_utc =
-                            std::string(updated_utc_field.value().get_string().value());
-                    }
+                        auto updated_utc_field = obj.find_field_unordered("updated_utc");
+                        if (!updated_utc_field.error()) {
+                            sheet.updated_utc =
+                                std::string(updated_utc_field.value().get_string().value());
+                        }
 
-                    // Parse numeric fields (simplified - would need to parse all DataPoint fields)
-                    auto assets_field = obj.find_field_unordered("assets");
-                    if (!assets_field.error()) {
-                        auto assets_obj = assets_field.value().get_object();
-                        if (!assets_obj.error()) {
-                            auto value_field = assets_obj.value().find_field_unordered("value");
-                            if (!value_field.error()) {
-                                sheet.assets = value_field.value().get_int64().value();
+                        // Parse numeric fields (simplified - would need to parse all DataPoint
+                        // fields)
+                        auto assets_field = obj.find_field_unordered("assets");
+                        if (!assets_field.error()) {
+                            auto assets_obj = assets_field.value().get_object();
+                            if (!assets_obj.error()) {
+                                auto value_field = assets_obj.value().find_field_unordered("value");
+                                if (!value_field.error()) {
+                                    sheet.assets = value_field.value().get_int64().value();
+                                }
                             }
                         }
-                    }
 
-                    auto liabilities_field = obj.find_field_unordered("liabilities");
-                    if (!liabilities_field.error()) {
-                        auto liabilities_obj = liabilities_field.value().get_object();
-                        if (!liabilities_obj.error()) {
-                            auto value_field =
-                                liabilities_obj.value().find_field_unordered("value");
-                            if (!value_field.error()) {
-                                sheet.liabilities = value_field.value().get_int64().value();
+                        auto liabilities_field = obj.find_field_unordered("liabilities");
+                        if (!liabilities_field.error()) {
+                            auto liabilities_obj = liabilities_field.value().get_object();
+                            if (!liabilities_obj.error()) {
+                                auto value_field =
+                                    liabilities_obj.value().find_field_unordered("value");
+                                if (!value_field.error()) {
+                                    sheet.liabilities = value_field.value().get_int64().value();
+                                }
                             }
                         }
-                    }
 
-                    auto equity_field = obj.find_field_unordered("equity");
-                    if (!equity_field.error()) {
-                        auto equity_obj = equity_field.value().get_object();
-                        if (!equity_obj.error()) {
-                            auto value_field = equity_obj.value().find_field_unordered("value");
-                            if (!value_field.error()) {
-                                sheet.equity = value_field.value().get_int64().value();
+                        auto equity_field = obj.find_field_unordered("equity");
+                        if (!equity_field.error()) {
+                            auto equity_obj = equity_field.value().get_object();
+                            if (!equity_obj.error()) {
+                                auto value_field = equity_obj.value().find_field_unordered("value");
+                                if (!value_field.error()) {
+                                    sheet.equity = value_field.value().get_int64().value();
+                                }
                             }
                         }
-                    }
 
-                    results.push_back(sheet);
+                        results.push_back(sheet);
+                    }
                 }
             }
         }
-    }
+    });
 
     return results;
 }
@@ -216,7 +206,7 @@ std::vector<IncomeStatement> RESTClient::list_income_statements(
     const std::optional<std::string> &timeframe_gt, const std::optional<std::string> &timeframe_gte,
     const std::optional<std::string> &timeframe_lt, const std::optional<std::string> &timeframe_lte,
     std::optional<int> limit, const std::optional<std::string> &sort) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
 
     add_param(params, "cik", cik);
     add_param(params, "cik.any_of", cik_any_of);
@@ -257,74 +247,67 @@ std::vector<IncomeStatement> RESTClient::list_income_statements(
     add_param(params, "sort", sort);
 
     std::string path = "/stocks/financials/v1/income-statements";
-    auto response = send_request(core::HttpMethod::Get, path, params);
-
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
-    if (doc_result.error()) {
-        throw std::runtime_error("Failed to parse JSON response");
-    }
-    auto& doc = doc_result.value();
-    auto root_obj = doc.get_object();
-    if (root_obj.error()) {
-        throw std::runtime_error("Response is not a JSON object");
-    }
 
     std::vector<IncomeStatement> results;
-    auto results_field = root_obj.value().find_field_unordered("results");
-    if (!results_field.error()) {
-        auto results_array = results_field.value().get_array();
-        if (!results_array.error()) {
-            for (auto result_elem : results_array.value()) {
-                auto obj_result = result_elem.get_object();
-                if (!obj_result.error()) {
-                    auto obj = obj_result.value();
-                    IncomeStatement statement;
-
-                    auto ticker_field = obj.find_field_unordered("ticker");
-                    if (!ticker_field.error()) {
-                        statement.ticker = std::string(ticker_field.value().get_string().value());
-                    }
+    collect_pages(path, params, results, [&](::simdjson::ondemand::object &root) {
+        auto results_field = root.find_field_unordered("results");
+        if (!results_field.error()) {
+            auto results_array = results_field.value().get_array();
+            if (!results_array.error()) {
+                for (auto result_elem : results_array.value()) {
+                    auto obj_result = result_elem.get_object();
+                    if (!obj_result.error()) {
+                        auto obj = obj_result.value();
+                        IncomeStatement statement;
+
+                        auto ticker_field = obj.find_field_unordered("ticker");
+                        if (!ticker_field.error()) {
+                            statement.ticker =
+                                std::string(ticker_field.value().get_string().value());
+                        }
 
-                    auto period_field = obj.find_field_unordered("period");
-                    if (!period_field.error()) {
-                        statement.period = std::string(period_field.value().get_string().value());
-                    }
+                        auto period_field = obj.find_field_unordered("period");
+                        if (!period_field.error()) {
+                            statement.period =
+                                std::string(period_field.value().get_string().value());
+                        }
 
-                    auto calendar_date_field = obj.find_field_unordered("calendar_date");
-                    if (!calendar_date_field.error()) {
-                        statement.calendar_date =
-                            std::string(calendar_date_field.value().get_string().value());
-                    }
+                        auto calendar_date_field = obj.find_field_unordered("calendar_date");
+                        if (!calendar_date_field.error()) {
+                            statement.calendar_date =
+                                std::string(calendar_date_field.value().get_string().value());
+                        }
 
-                    auto revenues_field = obj.find_field_unordered("revenues");
-                    if (!revenues_field.error()) {
-                        auto revenues_obj = revenues_field.value().get_object();
-                        if (!revenues_obj.error()) {
-                            auto value_field = revenues_obj.value().find_field_unordered("value");
-                            if (!value_field.error()) {
-                                statement.revenues = value_field.value().get_int64().value();
+                        auto revenues_field = obj.find_field_unordered("revenues");
+                        if (!revenues_field.error()) {
+                            auto revenues_obj = revenues_field.value().get_object();
+                            if (!revenues_obj.error()) {
+                                auto value_field =
+                                    revenues_obj.value().find_field_unordered("value");
+                                if (!value_field.error()) {
+                                    statement.revenues = value_field.value().get_int64().value();
+                                }
                             }
                         }
-                    }
 
-                    auto net_income_field = obj.find_field_unordered("net_income");
-                    if (!net_income_field.error()) {
-                        auto net_income_obj = net_income_field.value().get_object();
-                        if (!net_income_obj.error()) {
-                            auto value_field = net_income_obj.value().find_field_unordered("value");
-                            if (!value_field.error()) {
-                                statement.net_income = value_field.value().get_int64().value();
+                        auto net_income_field = obj.find_field_unordered("net_income");
+                        if (!net_income_field.error()) {
+                            auto net_income_obj = net_income_field.value().get_object();
+                            if (!net_income_obj.error()) {
+                                auto value_field =
+                                    net_income_obj.value().find_field_unordered("value");
+                                if (!value_field.error()) {
+                                    statement.net_income = value_field.value().get_int64().value();
+                                }
                             }
                         }
-                    }
 
-                    results.push_back(statement);
+                        results.push_back(statement);
+                    }
                 }
             }
         }
-    }
+    });
 
     return results;
 }
@@ -353,7 +336,7 @@ std::vector<CashFlowStatement> RESTClient::list_cash_flow_statements(
     const std::optional<std::string> &timeframe_gt, const std::optional<std::string> &timeframe_gte,
     const std::optional<std::string> &timeframe_lt, const std::optional<std::string> &timeframe_lte,
     std::optional<int> limit, const std::optional<std::string> &sort) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
 
     add_param(params, "cik", cik);
     add_param(params, "cik.any_of", cik_any_of);
@@ -394,70 +377,63 @@ std::vector<CashFlowStatement> RESTClient::list_cash_flow_statements(
     add_param(params, "sort", sort);
 
     std::string path = "/stocks/financials/v1/cash-flow-statements";
-    auto response = send_request(core::HttpMethod::Get, path, params);
-
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
-    if (doc_result.error()) {
-        throw std::runtime_error("Failed to parse JSON response");
-    }
-    auto& doc = doc_result.value();
-    auto root_obj = doc.get_object();
-    if (root_obj.error()) {
-        throw std::runtime_error("Response is not a JSON object");
-    }
 
     std::vector<CashFlowStatement> results;
-    auto results_field = root_obj.value().find_field_unordered("results");
-    if (!results_field.error()) {
-        auto results_array = results_field.value().get_array();
-        if (!results_array.error()) {
-            for (auto result_elem : results_array.value()) {
-                auto obj_result = result_elem.get_object();
-                if (!obj_result.error()) {
-                    auto obj = obj_result.value();
-                    CashFlowStatement statement;
-
-                    auto ticker_field = obj.find_field_unordered("ticker");
-                    if (!ticker_field.error()) {
-                        statement.ticker = std::string(ticker_field.value().get_string().value());
-                    }
+    collect_pages(path, params, results, [&](::simdjson::ondemand::object &root) {
+        auto results_field = root.find_field_unordered("results");
+        if (!results_field.error()) {
+            auto results_array = results_field.value().get_array();
+            if (!results_array.error()) {
+                for (auto result_elem : results_array.value()) {
+                    auto obj_result = result_elem.get_object();
+                    if (!obj_result.error()) {
+                        auto obj = obj_result.value();
+                        CashFlowStatement statement;
+
+                        auto ticker_field = obj.find_field_unordered("ticker");
+                        if (!ticker_field.error()) {
+                            statement.ticker =
+                                std::string(ticker_field.value().get_string().value());
+                        }
 
-                    auto period_field = obj.find_field_unordered("period");
-                    if (!period_field.error()) {
-                        statement.period = std::string(period_field.value().get_string().value());
-                    }
+                        auto period_field = obj.find_field_unordered("period");
+                        if (!period_field.error()) {
+                            statement.period =
+                                std::string(period_field.value().get_string().value());
+                        }
 
-                    auto cash_from_operating_activities_field =
-                        obj.find_field_unordered("cash_from_operating_activities");
-                    if (!cash_from_operating_activities_field.error()) {
-                        auto cash_obj = cash_from_operating_activities_field.value().get_object();
-                        if (!cash_obj.error()) {
-                            auto value_field = cash_obj.value().find_field_unordered("value");
-                            if (!value_field.error()) {
-                                statement.cash_from_operating_activities =
-                                    value_field.value().get_int64().value();
+                        auto cash_from_operating_activities_field =
+                            obj.find_field_unordered("cash_from_operating_activities");
+                        if (!cash_from_operating_activities_field.error()) {
+                            auto cash_obj =
+                                cash_from_operating_activities_field.value().get_object();
+                            if (!cash_obj.error()) {
+                                auto value_field = cash_obj.value().find_field_unordered("value");
+                                if (!value_field.error()) {
+                                    statement.cash_from_operating_activities =
+                                        value_field.value().get_int64().value();
+                                }
                             }
                         }
-                    }
 
-                    auto free_cash_flow_field = obj.find_field_unordered("free_cash_flow");
-                    if (!free_cash_flow_field.error()) {
-                        auto fcf_obj = free_cash_flow_field.value().get_object();
-                        if (!fcf_obj.error()) {
-                            auto value_field = fcf_obj.value().find_field_unordered("value");
-                            if (!value_field.error()) {
-                                statement.free_cash_flow = value_field.value().get_int64().value();
+                        auto free_cash_flow_field = obj.find_field_unordered("free_cash_flow");
+                        if (!free_cash_flow_field.error()) {
+                            auto fcf_obj = free_cash_flow_field.value().get_object();
+                            if (!fcf_obj.error()) {
+                                auto value_field = fcf_obj.value().find_field_unordered("value");
+                                if (!value_field.error()) {
+                                    statement.free_cash_flow =
+                                        value_field.value().get_int64().value();
+                                }
                             }
                         }
-                    }
 
-                    results.push_back(statement);
+                        results.push_back(statement);
+                    }
                 }
             }
         }
-    }
+    });
 
     return results;
 }
@@ -521,7 +497,7 @@ std::vector<FinancialRatios> RESTClient::list_financial_ratios(
     std::optional<double> free_cash_flow_gte, std::optional<double> free_cash_flow_lt,
     std::optional<double> free_cash_flow_lte, std::optional<int> limit,
     const std::optional<std::string> &sort) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
 
     add_param(params, "ticker", ticker);
     add_param(params, "ticker.any_of", ticker_any_of);
@@ -639,58 +615,48 @@ std::vector<FinancialRatios> RESTClient::list_financial_ratios(
     add_param(params, "sort", sort);
 
     std::string path = "/stocks/financials/v1/ratios";
-    auto response = send_request(core::HttpMethod::Get, path, params);
-
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
-    if (doc_result.error()) {
-        throw std::runtime_error("Failed to parse JSON response");
-    }
-    auto& doc = doc_result.value();
-    auto root_obj = doc.get_object();
-    if (root_obj.error()) {
-        throw std::runtime_error("Response is not a JSON object");
-    }
 
     std::vector<FinancialRatios> results;
-    auto results_field = root_obj.value().find_field_unordered("results");
-    if (!results_field.error()) {
-        auto results_array = results_field.value().get_array();
-        if (!results_array.error()) {
-            for (auto result_elem : results_array.value()) {
-                auto obj_result = result_elem.get_object();
-                if (!obj_result.error()) {
-                    auto obj = obj_result.value();
-                    FinancialRatios ratios;
-
-                    auto ticker_field = obj.find_field_unordered("ticker");
-                    if (!ticker_field.error()) {
-                        ratios.ticker = std::string(ticker_field.value().get_string().value());
-                    }
+    collect_pages(path, params, results, [&](::simdjson::ondemand::object &root) {
+        auto results_field = root.find_field_unordered("results");
+        if (!results_field.error()) {
+            auto results_array = results_field.value().get_array();
+            if (!results_array.error()) {
+                for (auto result_elem : results_array.value()) {
+                    auto obj_result = result_elem.get_object();
+                    if (!obj_result.error()) {
+                        auto obj = obj_result.value();
+                        FinancialRatios ratios;
+
+                        auto ticker_field = obj.find_field_unordered("ticker");
+                        if (!ticker_field.error()) {
+                            ratios.ticker = std::string(ticker_field.value().get_string().value());
+                        }
 
-                    auto current_ratio_field = obj.find_field_unordered("current_ratio");
-                    if (!current_ratio_field.error()) {
-                        ratios.current_ratio = current_ratio_field.value().get_double().value();
-                    }
+                        auto current_ratio_field = obj.find_field_unordered("current_ratio");
+                        if (!current_ratio_field.error()) {
+                            ratios.current_ratio = current_ratio_field.value().get_double().value();
+                        }
 
-                    auto return_on_equity_field = obj.find_field_unordered("return_on_equity");
-                    if (!return_on_equity_field.error()) {
-                        ratios.return_on_equity =
-                            return_on_equity_field.value().get_double().value();
-                    }
+                        auto return_on_equity_field = obj.find_field_unordered("return_on_equity");
+                        if (!return_on_equity_field.error()) {
+                            ratios.return_on_equity =
+                                return_on_equity_field.value().get_double().value();
+                        }
 
-                    auto price_to_earnings_field = obj.find_field_unordered("price_to_earnings");
-                    if (!price_to_earnings_field.error()) {
-                        ratios.price_to_earnings =
-                            price_to_earnings_field.value().get_double().value();
-                    }
+                        auto price_to_earnings_field =
+                            obj.find_field_unordered("price_to_earnings");
+                        if (!price_to_earnings_field.error()) {
+                            ratios.price_to_earnings =
+                                price_to_earnings_field.value().get_double().value();
+                        }
 
-                    results.push_back(ratios);
+                        results.push_back(ratios);
+                    }
                 }
             }
         }
-    }
+    });
 
     return results;
 }
@@ -0,0 +1,59 @@
+#include "massive/rest/hedging.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace massive::rest {
+
+std::chrono::milliseconds HedgeTracker::delay(std::string_view endpoint,
+                                              const HedgePolicy &policy) const {
+    std::vector<std::chrono::microseconds> samples;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = windows_.find(endpoint);
+        if (it == windows_.end() || it->second.samples.size() < kMinSamples) {
+            return std::clamp(policy.initial_delay, policy.min_delay, policy.max_delay);
+        }
+        samples = it->second.samples;
+    }
+
+    const double percentile = std::clamp(policy.percentile, 0.0, 1.0);
+    const auto rank = static_cast<std::size_t>(
+        std::floor(percentile * static_cast<double>(samples.size() - 1)));
+    std::nth_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(rank),
+                     samples.end());
+    const auto delay = std::chrono::ceil<std::chrono::milliseconds>(samples[rank]);
+    return std::clamp(delay, policy.min_delay, policy.max_delay);
+}
+
+void HedgeTracker::record_hedge_sent() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.hedges_sent;
+}
+
+void HedgeTracker::record_response(std::string_view endpoint,
+                                   std::chrono::microseconds latency, bool from_hedge) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.requests;
+    if (from_hedge) {
+        ++stats_.hedge_wins;
+    }
+    auto it = windows_.find(endpoint);
+    if (it == windows_.end()) {
+        it = windows_.emplace(std::string(endpoint), Window{}).first;
+    }
+    auto &window = it->second;
+    if (window.samples.size() < kWindowSize) {
+        window.samples.push_back(latency);
+    } else {
+        window.samples[window.next] = latency;
+        window.next = (window.next + 1) % kWindowSize;
+    }
+}
+
+HedgeStats HedgeTracker::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+} // namespace massive::rest
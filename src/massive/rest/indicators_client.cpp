@@ -1,4 +1,5 @@
 #include "massive/rest/client.hpp"
+#include "massive/rest/json_parser.hpp"
 #include <simdjson/ondemand.h>
 #include <stdexcept>
 
@@ -9,7 +10,7 @@ SMAIndicatorResults RESTClient::get_sma(const std::string &ticker,
                                         const std::optional<std::string> &timespan,
                                         std::optional<int> window, std::optional<bool> adjusted,
                                         std::optional<int> limit) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
     if (timespan.has_value()) {
         params["timespan"] = timespan.value();
     }
@@ -26,9 +27,7 @@ SMAIndicatorResults RESTClient::get_sma(const std::string &ticker,
     std::string path = "/v1/indicators/sma/" + ticker;
     auto response = send_request(core::HttpMethod::Get, path, params);
 
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
+    auto doc_result = iterate_json(response.body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
@@ -83,7 +82,7 @@ EMAIndicatorResults RESTClient::get_ema(const std::string &ticker,
                                         const std::optional<std::string> &timespan,
                                         std::optional<int> window, std::optional<bool> adjusted,
                                         std::optional<int> limit) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
     if (timespan.has_value()) {
         params["timespan"] = timespan.value();
     }
@@ -100,9 +99,7 @@ EMAIndicatorResults RESTClient::get_ema(const std::string &ticker,
     std::string path = "/v1/indicators/ema/" + ticker;
     auto response = send_request(core::HttpMethod::Get, path, params);
 
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
+    auto doc_result = iterate_json(response.body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
@@ -157,7 +154,7 @@ RSIIndicatorResults RESTClient::get_rsi(const std::string &ticker,
                                         const std::optional<std::string> &timespan,
                                         std::optional<int> window, std::optional<bool> adjusted,
                                         std::optional<int> limit) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
     if (timespan.has_value()) {
         params["timespan"] = timespan.value();
     }
@@ -174,9 +171,7 @@ RSIIndicatorResults RESTClient::get_rsi(const std::string &ticker,
     std::string path = "/v1/indicators/rsi/" + ticker;
     auto response = send_request(core::HttpMethod::Get, path, params);
 
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
+    auto doc_result = iterate_json(response.body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
@@ -233,7 +228,7 @@ MACDIndicatorResults RESTClient::get_macd(const std::string &ticker,
                                           std::optional<int> long_window,
                                           std::optional<int> signal_window,
                                           std::optional<bool> adjusted, std::optional<int> limit) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
     if (timespan.has_value()) {
         params["timespan"] = timespan.value();
     }
@@ -256,9 +251,7 @@ MACDIndicatorResults RESTClient::get_macd(const std::string &ticker,
     std::string path = "/v1/indicators/macd/" + ticker;
     auto response = send_request(core::HttpMethod::Get, path, params);
 
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
+    auto doc_result = iterate_json(response.body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
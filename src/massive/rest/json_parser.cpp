@@ -0,0 +1,35 @@
+#include "massive/rest/json_parser.hpp"
+
+#include "massive/core/http_transport.hpp"
+
+namespace massive::rest {
+
+static_assert(core::kResponseBodyPadding >= ::simdjson::SIMDJSON_PADDING,
+              "transport body padding must cover simdjson's read-ahead");
+
+namespace {
+struct ParserScratch {
+    ::simdjson::ondemand::parser parser;
+    // Copy target for bodies without padding; keeps its capacity between calls.
+    std::string padded;
+};
+
+ParserScratch &thread_scratch() {
+    thread_local ParserScratch scratch;
+    return scratch;
+}
+} // namespace
+
+::simdjson::simdjson_result<::simdjson::ondemand::document> iterate_json(const std::string &body) {
+    auto &scratch = thread_scratch();
+    if (body.capacity() >= body.size() + ::simdjson::SIMDJSON_PADDING) {
+        return scratch.parser.iterate(body.data(), body.size(), body.capacity());
+    }
+
+    scratch.padded.reserve(body.size() + ::simdjson::SIMDJSON_PADDING);
+    scratch.padded.assign(body);
+    return scratch.parser.iterate(scratch.padded.data(), scratch.padded.size(),
+                                  scratch.padded.capacity());
+}
+
+} // namespace massive::rest
@@ -1,9 +1,16 @@
 #include "massive/rest/pagination.hpp"
 #include <simdjson/ondemand.h>
+#include <algorithm>
+#include <cstdint>
 #include <stdexcept>
 
 namespace massive::rest {
 
+namespace {
+// Largest page the API serves; bounds how much a bogus count can make us reserve.
+constexpr std::int64_t kMaxPageSize = 50000;
+} // namespace
+
 PaginationInfo extract_pagination_info(simdjson::ondemand::object& root_obj) {
     PaginationInfo info;
 
@@ -79,4 +86,31 @@ bool has_pagination(simdjson::ondemand::object& root_obj) {
     return false;
 }
 
+std::size_t page_count_hint(simdjson::ondemand::object& root_obj) {
+    for (const char* key : {"count", "resultsCount"}) {
+        auto field = root_obj.find_field_unordered(key);
+        if (field.error()) {
+            continue;
+        }
+        auto value = field.value().get_int64();
+        if (!value.error()) {
+            return static_cast<std::size_t>(
+                std::clamp<std::int64_t>(value.value(), 0, kMaxPageSize));
+        }
+    }
+    return 0;
+}
+
+std::optional<std::string> next_page_url(simdjson::ondemand::object& root_obj) {
+    auto next_url_field = root_obj.find_field_unordered("next_url");
+    if (next_url_field.error()) {
+        return std::nullopt;
+    }
+    auto next_url_str = next_url_field.value().get_string();
+    if (next_url_str.error() || next_url_str.value().empty()) {
+        return std::nullopt;
+    }
+    return std::string(next_url_str.value());
+}
+
 } // namespace massive::rest
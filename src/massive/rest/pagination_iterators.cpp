@@ -1,4 +1,5 @@
 #include "massive/rest/client.hpp"
+#include "massive/rest/json_parser.hpp"
 #include "massive/rest/pagination.hpp"
 #include <simdjson/ondemand.h>
 #include <stdexcept>
@@ -11,9 +12,7 @@ namespace {
 std::pair<simdjson::ondemand::array, PaginationInfo> parse_paginated_response_base(
     const std::string& response_body) {
     
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response_body;
-    auto doc_result = parser.iterate(json);
+    auto doc_result = iterate_json(response_body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
@@ -35,6 +34,18 @@ std::pair<simdjson::ondemand::array, PaginationInfo> parse_paginated_response_ba
     PaginationInfo pagination = extract_pagination_info(root_obj.value());
     return {results_array, pagination};
 }
+
+// Options carrying a read-ahead's cancellation, so abandoning the iterator cuts its request
+// short; none for pages fetched on the caller's thread.
+std::optional<RequestOptions>
+cancellable(const std::shared_ptr<core::RequestCancellation>& cancellation) {
+    if (!cancellation) {
+        return std::nullopt;
+    }
+    RequestOptions options;
+    options.cancellation = cancellation;
+    return options;
+}
 } // namespace
 
 // Paginated iterator for tickers
@@ -56,7 +67,7 @@ PaginatedIterator<Ticker> RESTClient::list_tickers_iter(
     const std::optional<std::string> &order) {
     
     // Build initial parameters
-    std::map<std::string, std::string> base_params;
+    QueryParams base_params;
     if (ticker.has_value()) {
         base_params["ticker"] = ticker.value();
     }
@@ -105,11 +116,13 @@ PaginatedIterator<Ticker> RESTClient::list_tickers_iter(
     // Don't set limit for iterators - let pagination handle it
 
     // Create fetch function
-    auto fetch_fn = [this, base_params](const std::optional<std::string>& next_url) 
+    auto fetch_fn = [this, base_params](
+                        const std::optional<std::string>& next_url,
+                        const std::shared_ptr<core::RequestCancellation>& cancellation)
         -> std::pair<std::vector<Ticker>, PaginationInfo> {
         
         std::string path;
-        std::map<std::string, std::string> params = base_params;
+        QueryParams params = base_params;
         
         if (next_url.has_value()) {
             // If we have a next_url, use it directly
@@ -135,7 +148,8 @@ PaginatedIterator<Ticker> RESTClient::list_tickers_iter(
             path = "/v3/reference/tickers";
         }
 
-        auto response = send_request(core::HttpMethod::Get, path, params);
+        auto response = send_request(core::HttpMethod::Get, path, params,
+                                     cancellable(cancellation));
         
         auto [results_array, pagination] = parse_paginated_response_base(response.body);
         std::vector<Ticker> results;
@@ -180,7 +194,7 @@ PaginatedIterator<Ticker> RESTClient::list_tickers_iter(
         return {std::move(results), pagination};
     };
 
-    return PaginatedIterator<Ticker>(fetch_fn);
+    return PaginatedIterator<Ticker>(fetch_fn, std::nullopt, config_.page_prefetch());
 }
 
 // Paginated iterator for aggregates
@@ -193,7 +207,7 @@ PaginatedIterator<Agg> RESTClient::list_aggs_iter(
     std::optional<bool> adjusted,
     const std::optional<std::string>& sort) {
     
-    std::map<std::string, std::string> base_params;
+    QueryParams base_params;
     if (adjusted.has_value()) {
         base_params["adjusted"] = adjusted.value() ? "true" : "false";
     }
@@ -204,11 +218,13 @@ PaginatedIterator<Agg> RESTClient::list_aggs_iter(
     std::string base_path = "/v2/aggs/ticker/" + ticker + "/range/" + 
                            std::to_string(multiplier) + "/" + timespan + "/" + from + "/" + to;
 
-    auto fetch_fn = [this, base_path, base_params](const std::optional<std::string>& next_url) 
+    auto fetch_fn = [this, base_path, base_params](
+                        const std::optional<std::string>& next_url,
+                        const std::shared_ptr<core::RequestCancellation>& cancellation)
         -> std::pair<std::vector<Agg>, PaginationInfo> {
         
         std::string path = next_url.has_value() ? next_url.value() : base_path;
-        std::map<std::string, std::string> params = base_params;
+        QueryParams params = base_params;
         
         // Extract params from URL if it's a full URL
         if (next_url.has_value() && next_url->find('?') != std::string::npos) {
@@ -225,7 +241,8 @@ PaginatedIterator<Agg> RESTClient::list_aggs_iter(
             }
         }
 
-        auto response = send_request(core::HttpMethod::Get, path, params);
+        auto response = send_request(core::HttpMethod::Get, path, params,
+                                     cancellable(cancellation));
         
         auto [results_array, pagination] = parse_paginated_response_base(response.body);
         std::vector<Agg> results;
@@ -274,7 +291,7 @@ PaginatedIterator<Agg> RESTClient::list_aggs_iter(
         return {std::move(results), pagination};
     };
 
-    return PaginatedIterator<Agg>(fetch_fn);
+    return PaginatedIterator<Agg>(fetch_fn, std::nullopt, config_.page_prefetch());
 }
 
 // Paginated iterator for trades
@@ -288,7 +305,7 @@ PaginatedIterator<Trade> RESTClient::list_trades_iter(
     const std::optional<std::string>& sort,
     const std::optional<std::string>& order) {
     
-    std::map<std::string, std::string> base_params;
+    QueryParams base_params;
     if (timestamp.has_value()) {
         base_params["timestamp"] = timestamp.value();
     }
@@ -313,11 +330,13 @@ PaginatedIterator<Trade> RESTClient::list_trades_iter(
 
     std::string base_path = "/v3/trades/" + ticker;
 
-    auto fetch_fn = [this, base_path, base_params](const std::optional<std::string>& next_url) 
+    auto fetch_fn = [this, base_path, base_params](
+                        const std::optional<std::string>& next_url,
+                        const std::shared_ptr<core::RequestCancellation>& cancellation)
         -> std::pair<std::vector<Trade>, PaginationInfo> {
         
         std::string path = next_url.has_value() ? next_url.value() : base_path;
-        std::map<std::string, std::string> params = base_params;
+        QueryParams params = base_params;
         
         if (next_url.has_value() && next_url->find('?') != std::string::npos) {
             size_t query_pos = next_url->find('?');
@@ -333,7 +352,8 @@ PaginatedIterator<Trade> RESTClient::list_trades_iter(
             }
         }
 
-        auto response = send_request(core::HttpMethod::Get, path, params);
+        auto response = send_request(core::HttpMethod::Get, path, params,
+                                     cancellable(cancellation));
         
         auto [results_array, pagination] = parse_paginated_response_base(response.body);
         std::vector<Trade> results;
@@ -362,7 +382,7 @@ PaginatedIterator<Trade> RESTClient::list_trades_iter(
         return {std::move(results), pagination};
     };
 
-    return PaginatedIterator<Trade>(fetch_fn);
+    return PaginatedIterator<Trade>(fetch_fn, std::nullopt, config_.page_prefetch());
 }
 
 // Paginated iterator for quotes
@@ -376,7 +396,7 @@ PaginatedIterator<Quote> RESTClient::list_quotes_iter(
     const std::optional<std::string>& sort,
     const std::optional<std::string>& order) {
     
-    std::map<std::string, std::string> base_params;
+    QueryParams base_params;
     if (timestamp.has_value()) {
         base_params["timestamp"] = timestamp.value();
     }
@@ -401,11 +421,13 @@ PaginatedIterator<Quote> RESTClient::list_quotes_iter(
 
     std::string base_path = "/v3/quotes/" + ticker;
 
-    auto fetch_fn = [this, base_path, base_params](const std::optional<std::string>& next_url) 
+    auto fetch_fn = [this, base_path, base_params](
+                        const std::optional<std::string>& next_url,
+                        const std::shared_ptr<core::RequestCancellation>& cancellation)
         -> std::pair<std::vector<Quote>, PaginationInfo> {
         
         std::string path = next_url.has_value() ? next_url.value() : base_path;
-        std::map<std::string, std::string> params = base_params;
+        QueryParams params = base_params;
         
         if (next_url.has_value() && next_url->find('?') != std::string::npos) {
             size_t query_pos = next_url->find('?');
@@ -421,7 +443,8 @@ PaginatedIterator<Quote> RESTClient::list_quotes_iter(
             }
         }
 
-        auto response = send_request(core::HttpMethod::Get, path, params);
+        auto response = send_request(core::HttpMethod::Get, path, params,
+                                     cancellable(cancellation));
         
         auto [results_array, pagination] = parse_paginated_response_base(response.body);
         std::vector<Quote> results;
@@ -470,7 +493,7 @@ PaginatedIterator<Quote> RESTClient::list_quotes_iter(
         return {std::move(results), pagination};
     };
 
-    return PaginatedIterator<Quote>(fetch_fn);
+    return PaginatedIterator<Quote>(fetch_fn, std::nullopt, config_.page_prefetch());
 }
 
 } // namespace massive::rest
@@ -0,0 +1,63 @@
+#include "massive/rest/query_params.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace massive::rest {
+
+namespace {
+bool key_less(const QueryParams::value_type &entry, std::string_view key) {
+    return entry.first < key;
+}
+} // namespace
+
+std::string &QueryParams::operator[](std::string_view key) {
+    value_type *first = data();
+    value_type *position = std::lower_bound(first, first + size_, key, key_less);
+    if (position != first + size_ && position->first == key) {
+        return position->second;
+    }
+
+    const auto index = static_cast<std::size_t>(position - first);
+    if (!spilled_.empty()) {
+        auto inserted = spilled_.emplace(spilled_.begin() + static_cast<std::ptrdiff_t>(index),
+                                         std::string(key), std::string());
+        ++size_;
+        return inserted->second;
+    }
+    if (size_ == kInlineCapacity) {
+        spilled_.reserve(kInlineCapacity * 2);
+        std::move(inline_.begin(), inline_.end(), std::back_inserter(spilled_));
+        auto inserted = spilled_.emplace(spilled_.begin() + static_cast<std::ptrdiff_t>(index),
+                                         std::string(key), std::string());
+        ++size_;
+        return inserted->second;
+    }
+
+    // Shift the tail up one slot to keep the keys sorted.
+    std::move_backward(position, first + size_, first + size_ + 1);
+    position->first.assign(key);
+    position->second.clear();
+    ++size_;
+    return position->second;
+}
+
+const std::string *QueryParams::find(std::string_view key) const {
+    const value_type *first = data();
+    const value_type *position = std::lower_bound(first, first + size_, key, key_less);
+    if (position != first + size_ && position->first == key) {
+        return &position->second;
+    }
+    return nullptr;
+}
+
+void QueryParams::clear() {
+    for (std::size_t i = 0; i < std::min(size_, kInlineCapacity); ++i) {
+        inline_[i].first.clear();
+        inline_[i].second.clear();
+    }
+    spilled_.clear();
+    size_ = 0;
+}
+
+} // namespace massive::rest
@@ -1,19 +1,38 @@
 #include "massive/rest/client.hpp"
+#include "massive/rest/json_parser.hpp"
 #include <simdjson/ondemand.h>
 #include <stdexcept>
 
 namespace massive::rest {
 
-std::vector<Quote> RESTClient::list_quotes(const std::string &ticker,
-                                           const std::optional<std::string> &timestamp,
-                                           const std::optional<std::string> &timestamp_lt,
-                                           const std::optional<std::string> &timestamp_lte,
-                                           const std::optional<std::string> &timestamp_gt,
-                                           const std::optional<std::string> &timestamp_gte,
-                                           std::optional<int> limit,
-                                           const std::optional<std::string> &sort,
-                                           const std::optional<std::string> &order) {
-    std::map<std::string, std::string> params;
+namespace {
+Quote parse_quote(::simdjson::ondemand::object &element) {
+    Quote quote;
+    auto ask_field = element.find_field_unordered("ap");
+    if (!ask_field.error()) {
+        quote.ask = ask_field.value().get_double().value();
+    }
+
+    auto bid_field = element.find_field_unordered("bp");
+    if (!bid_field.error()) {
+        quote.bid = bid_field.value().get_double().value();
+    }
+
+    auto timestamp_field = element.find_field_unordered("t");
+    if (!timestamp_field.error()) {
+        quote.timestamp = timestamp_field.value().get_int64().value();
+    }
+    return quote;
+}
+
+QueryParams quote_params(const std::optional<std::string> &timestamp,
+                         const std::optional<std::string> &timestamp_lt,
+                         const std::optional<std::string> &timestamp_lte,
+                         const std::optional<std::string> &timestamp_gt,
+                         const std::optional<std::string> &timestamp_gte, std::optional<int> limit,
+                         const std::optional<std::string> &sort,
+                         const std::optional<std::string> &order) {
+    QueryParams params;
     if (timestamp.has_value()) {
         params["timestamp"] = timestamp.value();
     }
@@ -38,65 +57,58 @@ std::vector<Quote> RESTClient::list_quotes(const std::string &ticker,
     if (order.has_value()) {
         params["order"] = order.value();
     }
+    return params;
+}
+} // namespace
 
-    std::string path = "/v3/quotes/" + ticker;
-    auto response = send_request(core::HttpMethod::Get, path, params);
-
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
-    if (doc_result.error()) {
-        throw std::runtime_error("Failed to parse JSON response");
-    }
-    auto& doc = doc_result.value();
-    auto root_obj = doc.get_object();
-    if (root_obj.error()) {
-        throw std::runtime_error("Response is not a JSON object");
-    }
-
+std::vector<Quote> RESTClient::list_quotes(const std::string &ticker,
+                                           const std::optional<std::string> &timestamp,
+                                           const std::optional<std::string> &timestamp_lt,
+                                           const std::optional<std::string> &timestamp_lte,
+                                           const std::optional<std::string> &timestamp_gt,
+                                           const std::optional<std::string> &timestamp_gte,
+                                           std::optional<int> limit,
+                                           const std::optional<std::string> &sort,
+                                           const std::optional<std::string> &order) {
     std::vector<Quote> results;
-
-    auto results_field = root_obj.value().find_field_unordered("results");
-    if (!results_field.error()) {
-        auto results_array = results_field.value().get_array();
-        if (!results_array.error()) {
-            for (auto result : results_array.value()) {
-                Quote quote;
-                auto obj_result = result.get_object();
-                if (!obj_result.error()) {
-                    auto obj = obj_result.value();
-
-                    auto ask_field = obj.find_field_unordered("ap");
-                    if (!ask_field.error()) {
-                        quote.ask = ask_field.value().get_double().value();
-                    }
-
-                    auto bid_field = obj.find_field_unordered("bp");
-                    if (!bid_field.error()) {
-                        quote.bid = bid_field.value().get_double().value();
-                    }
-
-                    auto timestamp_field = obj.find_field_unordered("t");
-                    if (!timestamp_field.error()) {
-                        quote.timestamp = timestamp_field.value().get_int64().value();
-                    }
-
-                    results.push_back(quote);
-                }
-            }
-        }
-    }
-
+    // Collected results can be taken back, so a page cut off mid-body is simply fetched again.
+    stream_pages(
+        "/v3/quotes/" + ticker,
+        quote_params(timestamp, timestamp_lt, timestamp_lte, timestamp_gt, timestamp_gte, limit,
+                     sort, order),
+        [&results](::simdjson::ondemand::object &element) {
+            results.push_back(parse_quote(element));
+        },
+        [&results](std::size_t kept) {
+            results.erase(results.begin() + static_cast<std::ptrdiff_t>(kept), results.end());
+        });
     return results;
 }
 
-LastQuote RESTClient::get_last_quote(const std::string &ticker) {
+void RESTClient::stream_quotes(const std::string &ticker,
+                               const std::function<void(const Quote &)> &on_quote,
+                               const std::optional<std::string> &timestamp,
+                               const std::optional<std::string> &timestamp_lt,
+                               const std::optional<std::string> &timestamp_lte,
+                               const std::optional<std::string> &timestamp_gt,
+                               const std::optional<std::string> &timestamp_gte,
+                               std::optional<int> limit,
+                               const std::optional<std::string> &sort,
+                               const std::optional<std::string> &order) {
+    stream_pages("/v3/quotes/" + ticker,
+                 quote_params(timestamp, timestamp_lt, timestamp_lte, timestamp_gt, timestamp_gte,
+                              limit, sort, order),
+                 [&](::simdjson::ondemand::object &element) {
+                     on_quote(parse_quote(element));
+                 });
+}
+
+LastQuote RESTClient::get_last_quote(const std::string &ticker,
+                                     const std::optional<RequestOptions> &options) {
     std::string path = "/v2/last/quote/" + ticker;
-    auto response = send_request(core::HttpMethod::Get, path);
+    auto response = send_request(core::HttpMethod::Get, path, {}, options);
 
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
+    auto doc_result = iterate_json(response.body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
@@ -143,9 +155,7 @@ LastForexQuote RESTClient::get_last_forex_quote(const std::string& from, const s
     std::string path = "/v1/last_quote/currencies/" + from + "/" + to;
     auto response = send_request(core::HttpMethod::Get, path);
 
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
+    auto doc_result = iterate_json(response.body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
@@ -203,7 +213,7 @@ RealTimeCurrencyConversion RESTClient::get_real_time_currency_conversion(
     const std::string& to,
     std::optional<double> amount,
     std::optional<int> precision) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
     if (amount.has_value()) {
         params["amount"] = std::to_string(amount.value());
     }
@@ -214,9 +224,7 @@ RealTimeCurrencyConversion RESTClient::get_real_time_currency_conversion(
     std::string path = "/v1/conversion/" + from + "/" + to;
     auto response = send_request(core::HttpMethod::Get, path, params);
 
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
+    auto doc_result = iterate_json(response.body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
@@ -1,17 +1,14 @@
 #include "massive/rest/client.hpp"
+#include "massive/rest/json_parser.hpp"
 #include <simdjson/ondemand.h>
 #include <stdexcept>
 
 namespace massive::rest {
 
 // Reference Data - Markets
-std::vector<MarketHoliday> RESTClient::get_market_holidays() {
-    std::string path = "/v1/marketstatus/upcoming";
-    auto response = send_request(core::HttpMethod::Get, path);
-
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
+namespace {
+std::vector<MarketHoliday> parse_market_holidays(const std::string &body) {
+    auto doc_result = iterate_json(body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
@@ -54,14 +51,18 @@ std::vector<MarketHoliday> RESTClient::get_market_holidays() {
 
     return results;
 }
+} // namespace
+
+std::vector<MarketHoliday> RESTClient::get_market_holidays() {
+    std::string path = "/v1/marketstatus/upcoming";
+    return cached_get<std::vector<MarketHoliday>>(path, {}, parse_market_holidays);
+}
 
 MarketStatus RESTClient::get_market_status() {
     std::string path = "/v1/marketstatus/now";
     auto response = send_request(core::HttpMethod::Get, path);
 
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
+    auto doc_result = iterate_json(response.body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
@@ -106,7 +107,7 @@ std::vector<Ticker> RESTClient::list_tickers(
     std::optional<int> cusip, std::optional<int> cik, const std::optional<std::string> &date,
     std::optional<bool> active, const std::optional<std::string> &search, std::optional<int> limit,
     const std::optional<std::string> &sort, const std::optional<std::string> &order) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
     if (ticker.has_value()) {
         params["ticker"] = ticker.value();
     }
@@ -157,88 +158,68 @@ std::vector<Ticker> RESTClient::list_tickers(
     }
 
     std::string path = "/v3/reference/tickers";
-    auto response = send_request(core::HttpMethod::Get, path, params);
-
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
-    if (doc_result.error()) {
-        throw std::runtime_error("Failed to parse JSON response");
-    }
-    auto& doc = doc_result.value();
-    auto root_obj = doc.get_object();
-    if (root_obj.error()) {
-        throw std::runtime_error("Response is not a JSON object");
-    }
 
     std::vector<Ticker> results;
-    auto results_field = root_obj.value().find_field_unordered("results");
-    if (!results_field.error()) {
-        auto results_array = results_field.value().get_array();
-        if (!results_array.error()) {
-            for (auto result_elem : results_array.value()) {
-                auto obj_result = result_elem.get_object();
-                if (!obj_result.error()) {
-                    auto obj = obj_result.value();
-                    Ticker tick;
+    collect_pages(path, params, results, [&](::simdjson::ondemand::object &root) {
+        auto results_field = root.find_field_unordered("results");
+        if (!results_field.error()) {
+            auto results_array = results_field.value().get_array();
+            if (!results_array.error()) {
+                for (auto result_elem : results_array.value()) {
+                    auto obj_result = result_elem.get_object();
+                    if (!obj_result.error()) {
+                        auto obj = obj_result.value();
+                        Ticker tick;
+
+                        auto ticker_field = obj.find_field_unordered("ticker");
+                        if (!ticker_field.error()) {
+                            tick.ticker = std::string(ticker_field.value().get_string().value());
+                        }
 
-                    auto ticker_field = obj.find_field_unordered("ticker");
-                    if (!ticker_field.error()) {
-                        tick.ticker = std::string(ticker_field.value().get_string().value());
-                    }
+                        auto name_field = obj.find_field_unordered("name");
+                        if (!name_field.error()) {
+                            tick.name = std::string(name_field.value().get_string().value());
+                        }
 
-                    auto name_field = obj.find_field_unordered("name");
-                    if (!name_field.error()) {
-                        tick.name = std::string(name_field.value().get_string().value());
-                    }
+                        auto market_field = obj.find_field_unordered("market");
+                        if (!market_field.error()) {
+                            tick.market = std::string(market_field.value().get_string().value());
+                        }
 
-                    auto market_field = obj.find_field_unordered("market");
-                    if (!market_field.error()) {
-                        tick.market = std::string(market_field.value().get_string().value());
-                    }
+                        auto locale_field = obj.find_field_unordered("locale");
+                        if (!locale_field.error()) {
+                            tick.locale = std::string(locale_field.value().get_string().value());
+                        }
 
-                    auto locale_field = obj.find_field_unordered("locale");
-                    if (!locale_field.error()) {
-                        tick.locale = std::string(locale_field.value().get_string().value());
-                    }
+                        auto primary_exchange_field = obj.find_field_unordered("primary_exchange");
+                        if (!primary_exchange_field.error()) {
+                            tick.primary_exchange =
+                                std::string(primary_exchange_field.value().get_string().value());
+                        }
 
-                    auto primary_exchange_field = obj.find_field_unordered("primary_exchange");
-                    if (!primary_exchange_field.error()) {
-                        tick.primary_exchange =
-                            std::string(primary_exchange_field.value().get_string().value());
-                    }
+                        auto type_field = obj.find_field_unordered("type");
+                        if (!type_field.error()) {
+                            tick.type = std::string(type_field.value().get_string().value());
+                        }
 
-                    auto type_field = obj.find_field_unordered("type");
-                    if (!type_field.error()) {
-                        tick.type = std::string(type_field.value().get_string().value());
-                    }
+                        auto active_field = obj.find_field_unordered("active");
+                        if (!active_field.error()) {
+                            tick.active = active_field.value().get_bool().value();
+                        }
 
-                    auto active_field = obj.find_field_unordered("active");
-                    if (!active_field.error()) {
-                        tick.active = active_field.value().get_bool().value();
+                        results.push_back(tick);
                     }
-
-                    results.push_back(tick);
                 }
             }
         }
-    }
+    });
 
     return results;
 }
 
-TickerDetails RESTClient::get_ticker_details(const std::string &ticker,
-                                             const std::optional<std::string> &date) {
-    std::map<std::string, std::string> params;
-    if (date.has_value()) {
-        params["date"] = date.value();
-    }
-    std::string path = "/v3/reference/tickers/" + ticker;
-    auto response = send_request(core::HttpMethod::Get, path, params);
-
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
+namespace {
+TickerDetails parse_ticker_details(const std::string &body) {
+    auto doc_result = iterate_json(body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
@@ -295,12 +276,23 @@ TickerDetails RESTClient::get_ticker_details(const std::string &ticker,
 
     return details;
 }
+} // namespace
+
+TickerDetails RESTClient::get_ticker_details(const std::string &ticker,
+                                             const std::optional<std::string> &date) {
+    QueryParams params;
+    if (date.has_value()) {
+        params["date"] = date.value();
+    }
+    std::string path = "/v3/reference/tickers/" + ticker;
+    return cached_get<TickerDetails>(path, params, parse_ticker_details);
+}
 
 // Reference Data - Ticker News
 std::vector<TickerNews> RESTClient::list_ticker_news(
     const std::string &ticker, std::optional<int> limit,
     const std::optional<std::string> &order, const std::optional<std::string> &sort) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
     params["ticker"] = ticker;
     if (limit.has_value()) {
         params["limit"] = std::to_string(limit.value());
@@ -313,97 +305,87 @@ std::vector<TickerNews> RESTClient::list_ticker_news(
     }
 
     std::string path = "/v2/reference/news";
-    auto response = send_request(core::HttpMethod::Get, path, params);
-
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
-    if (doc_result.error()) {
-        throw std::runtime_error("Failed to parse JSON response");
-    }
-    auto& doc = doc_result.value();
-    auto root_obj = doc.get_object();
-    if (root_obj.error()) {
-        throw std::runtime_error("Response is not a JSON object");
-    }
 
     std::vector<TickerNews> results;
-    auto results_field = root_obj.value().find_field_unordered("results");
-    if (!results_field.error()) {
-        auto results_array = results_field.value().get_array();
-        if (!results_array.error()) {
-            for (auto result_elem : results_array.value()) {
-                auto obj_result = result_elem.get_object();
-                if (!obj_result.error()) {
-                    auto obj = obj_result.value();
-                    TickerNews news;
-
-                    auto id_field = obj.find_field_unordered("id");
-                    if (!id_field.error()) {
-                        news.id = std::string(id_field.value().get_string().value());
-                    }
+    collect_pages(path, params, results, [&](::simdjson::ondemand::object &root) {
+        auto results_field = root.find_field_unordered("results");
+        if (!results_field.error()) {
+            auto results_array = results_field.value().get_array();
+            if (!results_array.error()) {
+                for (auto result_elem : results_array.value()) {
+                    auto obj_result = result_elem.get_object();
+                    if (!obj_result.error()) {
+                        auto obj = obj_result.value();
+                        TickerNews news;
+
+                        auto id_field = obj.find_field_unordered("id");
+                        if (!id_field.error()) {
+                            news.id = std::string(id_field.value().get_string().value());
+                        }
 
-                    auto publisher_name_field = obj.find_field_unordered("publisher.name");
-                    if (!publisher_name_field.error()) {
-                        news.publisher_name = std::string(publisher_name_field.value().get_string().value());
-                    }
+                        auto publisher_name_field = obj.find_field_unordered("publisher.name");
+                        if (!publisher_name_field.error()) {
+                            news.publisher_name =
+                                std::string(publisher_name_field.value().get_string().value());
+                        }
 
-                    auto title_field = obj.find_field_unordered("title");
-                    if (!title_field.error()) {
-                        news.title = std::string(title_field.value().get_string().value());
-                    }
+                        auto title_field = obj.find_field_unordered("title");
+                        if (!title_field.error()) {
+                            news.title = std::string(title_field.value().get_string().value());
+                        }
 
-                    auto author_field = obj.find_field_unordered("author");
-                    if (!author_field.error()) {
-                        news.author = std::string(author_field.value().get_string().value());
-                    }
+                        auto author_field = obj.find_field_unordered("author");
+                        if (!author_field.error()) {
+                            news.author = std::string(author_field.value().get_string().value());
+                        }
 
-                    auto published_utc_field = obj.find_field_unordered("published_utc");
-                    if (!published_utc_field.error()) {
-                        news.published_utc = std::string(published_utc_field.value().get_string().value());
-                    }
+                        auto published_utc_field = obj.find_field_unordered("published_utc");
+                        if (!published_utc_field.error()) {
+                            news.published_utc =
+                                std::string(published_utc_field.value().get_string().value());
+                        }
 
-                    auto article_url_field = obj.find_field_unordered("article_url");
-                    if (!article_url_field.error()) {
-                        news.article_url = std::string(article_url_field.value().get_string().value());
-                    }
+                        auto article_url_field = obj.find_field_unordered("article_url");
+                        if (!article_url_field.error()) {
+                            news.article_url =
+                                std::string(article_url_field.value().get_string().value());
+                        }
 
-                    auto tickers_field = obj.find_field_unordered("tickers");
-                    if (!tickers_field.error()) {
-                        auto tickers_array = tickers_field.value().get_array();
-                        if (!tickers_array.error()) {
-                            news.tickers = std::vector<std::string>();
-                            for (auto ticker_elem : tickers_array.value()) {
-                                auto ticker_str = ticker_elem.get_string();
-                                if (!ticker_str.error()) {
-                                    news.tickers.value().push_back(std::string(ticker_str.value()));
+                        auto tickers_field = obj.find_field_unordered("tickers");
+                        if (!tickers_field.error()) {
+                            auto tickers_array = tickers_field.value().get_array();
+                            if (!tickers_array.error()) {
+                                news.tickers = std::vector<std::string>();
+                                for (auto ticker_elem : tickers_array.value()) {
+                                    auto ticker_str = ticker_elem.get_string();
+                                    if (!ticker_str.error()) {
+                                        news.tickers.value().push_back(
+                                            std::string(ticker_str.value()));
+                                    }
                                 }
                             }
                         }
-                    }
 
-                    auto description_field = obj.find_field_unordered("description");
-                    if (!description_field.error()) {
-                        news.description = std::string(description_field.value().get_string().value());
-                    }
+                        auto description_field = obj.find_field_unordered("description");
+                        if (!description_field.error()) {
+                            news.description =
+                                std::string(description_field.value().get_string().value());
+                        }
 
-                    results.push_back(news);
+                        results.push_back(news);
+                    }
                 }
             }
         }
-    }
+    });
 
     return results;
 }
 
 // Reference Data - Ticker Types
-std::vector<TickerTypes> RESTClient::get_ticker_types() {
-    std::string path = "/v3/reference/tickers/types";
-    auto response = send_request(core::HttpMethod::Get, path);
-
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
+namespace {
+std::vector<TickerTypes> parse_ticker_types(const std::string &body) {
+    auto doc_result = iterate_json(body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
@@ -426,7 +408,8 @@ std::vector<TickerTypes> RESTClient::get_ticker_types() {
 
                     auto asset_class_field = obj.find_field_unordered("asset_class");
                     if (!asset_class_field.error()) {
-                        types.asset_class = std::string(asset_class_field.value().get_string().value());
+                        types.asset_class =
+                            std::string(asset_class_field.value().get_string().value());
                     }
 
                     auto code_field = obj.find_field_unordered("code");
@@ -436,7 +419,8 @@ std::vector<TickerTypes> RESTClient::get_ticker_types() {
 
                     auto description_field = obj.find_field_unordered("description");
                     if (!description_field.error()) {
-                        types.description = std::string(description_field.value().get_string().value());
+                        types.description =
+                            std::string(description_field.value().get_string().value());
                     }
 
                     auto locale_field = obj.find_field_unordered("locale");
@@ -452,15 +436,19 @@ std::vector<TickerTypes> RESTClient::get_ticker_types() {
 
     return results;
 }
+} // namespace
+
+std::vector<TickerTypes> RESTClient::get_ticker_types() {
+    std::string path = "/v3/reference/tickers/types";
+    return cached_get<std::vector<TickerTypes>>(path, {}, parse_ticker_types);
+}
 
 // Reference Data - Related Companies
 std::vector<RelatedCompany> RESTClient::get_related_companies(const std::string &ticker) {
     std::string path = "/v2/reference/tickers/" + ticker + "/related";
     auto response = send_request(core::HttpMethod::Get, path);
 
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
+    auto doc_result = iterate_json(response.body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
@@ -503,7 +491,8 @@ std::vector<RelatedCompany> RESTClient::get_related_companies(const std::string
 
                     auto primary_exchange_field = obj.find_field_unordered("primary_exchange");
                     if (!primary_exchange_field.error()) {
-                        company.primary_exchange = std::string(primary_exchange_field.value().get_string().value());
+                        company.primary_exchange =
+                            std::string(primary_exchange_field.value().get_string().value());
                     }
 
                     auto type_field = obj.find_field_unordered("type");
@@ -528,7 +517,7 @@ std::vector<RelatedCompany> RESTClient::get_related_companies(const std::string
 // Reference Data - Splits
 std::vector<Split> RESTClient::list_splits(const std::optional<std::string> &ticker,
                                            std::optional<int> limit) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
     if (ticker.has_value()) {
         params["ticker"] = ticker.value();
     }
@@ -537,57 +526,46 @@ std::vector<Split> RESTClient::list_splits(const std::optional<std::string> &tic
     }
 
     std::string path = "/v3/reference/splits";
-    auto response = send_request(core::HttpMethod::Get, path, params);
-
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
-    if (doc_result.error()) {
-        throw std::runtime_error("Failed to parse JSON response");
-    }
-    auto& doc = doc_result.value();
-    auto root_obj = doc.get_object();
-    if (root_obj.error()) {
-        throw std::runtime_error("Response is not a JSON object");
-    }
 
     std::vector<Split> results;
-    auto results_field = root_obj.value().find_field_unordered("results");
-    if (!results_field.error()) {
-        auto results_array = results_field.value().get_array();
-        if (!results_array.error()) {
-            for (auto result_elem : results_array.value()) {
-                auto obj_result = result_elem.get_object();
-                if (!obj_result.error()) {
-                    auto obj = obj_result.value();
-                    Split split;
+    collect_pages(path, params, results, [&](::simdjson::ondemand::object &root) {
+        auto results_field = root.find_field_unordered("results");
+        if (!results_field.error()) {
+            auto results_array = results_field.value().get_array();
+            if (!results_array.error()) {
+                for (auto result_elem : results_array.value()) {
+                    auto obj_result = result_elem.get_object();
+                    if (!obj_result.error()) {
+                        auto obj = obj_result.value();
+                        Split split;
+
+                        auto ticker_field = obj.find_field_unordered("ticker");
+                        if (!ticker_field.error()) {
+                            split.ticker = std::string(ticker_field.value().get_string().value());
+                        }
 
-                    auto ticker_field = obj.find_field_unordered("ticker");
-                    if (!ticker_field.error()) {
-                        split.ticker = std::string(ticker_field.value().get_string().value());
-                    }
+                        auto execution_date_field = obj.find_field_unordered("execution_date");
+                        if (!execution_date_field.error()) {
+                            split.execution_date =
+                                std::string(execution_date_field.value().get_string().value());
+                        }
 
-                    auto execution_date_field = obj.find_field_unordered("execution_date");
-                    if (!execution_date_field.error()) {
-                        split.execution_date =
-                            std::string(execution_date_field.value().get_string().value());
-                    }
+                        auto split_from_field = obj.find_field_unordered("split_from");
+                        if (!split_from_field.error()) {
+                            split.split_from = split_from_field.value().get_int64().value();
+                        }
 
-                    auto split_from_field = obj.find_field_unordered("split_from");
-                    if (!split_from_field.error()) {
-                        split.split_from = split_from_field.value().get_int64().value();
-                    }
+                        auto split_to_field = obj.find_field_unordered("split_to");
+                        if (!split_to_field.error()) {
+                            split.split_to = split_to_field.value().get_int64().value();
+                        }
 
-                    auto split_to_field = obj.find_field_unordered("split_to");
-                    if (!split_to_field.error()) {
-                        split.split_to = split_to_field.value().get_int64().value();
+                        results.push_back(split);
                     }
-
-                    results.push_back(split);
                 }
             }
         }
-    }
+    });
 
     return results;
 }
@@ -595,7 +573,7 @@ std::vector<Split> RESTClient::list_splits(const std::optional<std::string> &tic
 // Reference Data - Dividends
 std::vector<Dividend> RESTClient::list_dividends(const std::optional<std::string> &ticker,
                                                  std::optional<int> limit) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
     if (ticker.has_value()) {
         params["ticker"] = ticker.value();
     }
@@ -604,140 +582,116 @@ std::vector<Dividend> RESTClient::list_dividends(const std::optional<std::string
     }
 
     std::string path = "/v3/reference/dividends";
-    auto response = send_request(core::HttpMethod::Get, path, params);
-
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
-    if (doc_result.error()) {
-        throw std::runtime_error("Failed to parse JSON response");
-    }
-    auto& doc = doc_result.value();
-    auto root_obj = doc.get_object();
-    if (root_obj.error()) {
-        throw std::runtime_error("Response is not a JSON object");
-    }
 
     std::vector<Dividend> results;
-    auto results_field = root_obj.value().find_field_unordered("results");
-    if (!results_field.error()) {
-        auto results_array = results_field.value().get_array();
-        if (!results_array.error()) {
-            for (auto result_elem : results_array.value()) {
-                auto obj_result = result_elem.get_object();
-                if (!obj_result.error()) {
-                    auto obj = obj_result.value();
-                    Dividend dividend;
+    collect_pages(path, params, results, [&](::simdjson::ondemand::object &root) {
+        auto results_field = root.find_field_unordered("results");
+        if (!results_field.error()) {
+            auto results_array = results_field.value().get_array();
+            if (!results_array.error()) {
+                for (auto result_elem : results_array.value()) {
+                    auto obj_result = result_elem.get_object();
+                    if (!obj_result.error()) {
+                        auto obj = obj_result.value();
+                        Dividend dividend;
+
+                        auto ticker_field = obj.find_field_unordered("ticker");
+                        if (!ticker_field.error()) {
+                            dividend.ticker =
+                                std::string(ticker_field.value().get_string().value());
+                        }
 
-                    auto ticker_field = obj.find_field_unordered("ticker");
-                    if (!ticker_field.error()) {
-                        dividend.ticker = std::string(ticker_field.value().get_string().value());
-                    }
+                        auto cash_amount_field = obj.find_field_unordered("cash_amount");
+                        if (!cash_amount_field.error()) {
+                            dividend.cash_amount = cash_amount_field.value().get_double().value();
+                        }
 
-                    auto cash_amount_field = obj.find_field_unordered("cash_amount");
-                    if (!cash_amount_field.error()) {
-                        dividend.cash_amount = cash_amount_field.value().get_double().value();
-                    }
+                        auto ex_dividend_date_field = obj.find_field_unordered("ex_dividend_date");
+                        if (!ex_dividend_date_field.error()) {
+                            dividend.ex_dividend_date =
+                                std::string(ex_dividend_date_field.value().get_string().value());
+                        }
 
-                    auto ex_dividend_date_field = obj.find_field_unordered("ex_dividend_date");
-                    if (!ex_dividend_date_field.error()) {
-                        dividend.ex_dividend_date =
-                            std::string(ex_dividend_date_field.value().get_string().value());
-                    }
+                        auto pay_date_field = obj.find_field_unordered("pay_date");
+                        if (!pay_date_field.error()) {
+                            dividend.pay_date =
+                                std::string(pay_date_field.value().get_string().value());
+                        }
 
-                    auto pay_date_field = obj.find_field_unordered("pay_date");
-                    if (!pay_date_field.error()) {
-                        dividend.pay_date =
-                            std::string(pay_date_field.value().get_string().value());
-                    }
+                        auto record_date_field = obj.find_field_unordered("record_date");
+                        if (!record_date_field.error()) {
+                            dividend.record_date =
+                                std::string(record_date_field.value().get_string().value());
+                        }
 
-                    auto record_date_field = obj.find_field_unordered("record_date");
-                    if (!record_date_field.error()) {
-                        dividend.record_date =
-                            std::string(record_date_field.value().get_string().value());
-                    }
+                        auto frequency_field = obj.find_field_unordered("frequency");
+                        if (!frequency_field.error()) {
+                            dividend.frequency = frequency_field.value().get_int64().value();
+                        }
 
-                    auto frequency_field = obj.find_field_unordered("frequency");
-                    if (!frequency_field.error()) {
-                        dividend.frequency = frequency_field.value().get_int64().value();
+                        results.push_back(dividend);
                     }
-
-                    results.push_back(dividend);
                 }
             }
         }
-    }
+    });
 
     return results;
 }
 
 // Reference Data - Conditions
 std::vector<Condition> RESTClient::list_conditions(std::optional<int> limit) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
     if (limit.has_value()) {
         params["limit"] = std::to_string(limit.value());
     }
 
     std::string path = "/v3/reference/conditions";
-    auto response = send_request(core::HttpMethod::Get, path, params);
 
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
-    if (doc_result.error()) {
-        throw std::runtime_error("Failed to parse JSON response");
-    }
-    auto& doc = doc_result.value();
-    auto root_obj = doc.get_object();
-    if (root_obj.error()) {
-        throw std::runtime_error("Response is not a JSON object");
-    }
-
-    std::vector<Condition> results;
-    auto results_field = root_obj.value().find_field_unordered("results");
-    if (!results_field.error()) {
-        auto results_array = results_field.value().get_array();
-        if (!results_array.error()) {
-            for (auto result_elem : results_array.value()) {
-                auto obj_result = result_elem.get_object();
-                if (!obj_result.error()) {
-                    auto obj = obj_result.value();
-                    Condition condition;
+    return cached_result<std::vector<Condition>>(path, params, [&] {
+        std::vector<Condition> results;
+        collect_pages(path, params, results, [&](::simdjson::ondemand::object &root) {
+            auto results_field = root.find_field_unordered("results");
+            if (!results_field.error()) {
+                auto results_array = results_field.value().get_array();
+                if (!results_array.error()) {
+                    for (auto result_elem : results_array.value()) {
+                        auto obj_result = result_elem.get_object();
+                        if (!obj_result.error()) {
+                            auto obj = obj_result.value();
+                            Condition condition;
+
+                            auto id_field = obj.find_field_unordered("id");
+                            if (!id_field.error()) {
+                                condition.id = id_field.value().get_int64().value();
+                            }
 
-                    auto id_field = obj.find_field_unordered("id");
-                    if (!id_field.error()) {
-                        condition.id = id_field.value().get_int64().value();
-                    }
+                            auto asset_class_field = obj.find_field_unordered("asset_class");
+                            if (!asset_class_field.error()) {
+                                condition.asset_class =
+                                    std::string(asset_class_field.value().get_string().value());
+                            }
 
-                    auto asset_class_field = obj.find_field_unordered("asset_class");
-                    if (!asset_class_field.error()) {
-                        condition.asset_class =
-                            std::string(asset_class_field.value().get_string().value());
-                    }
+                            auto description_field = obj.find_field_unordered("description");
+                            if (!description_field.error()) {
+                                condition.description =
+                                    std::string(description_field.value().get_string().value());
+                            }
 
-                    auto description_field = obj.find_field_unordered("description");
-                    if (!description_field.error()) {
-                        condition.description =
-                            std::string(description_field.value().get_string().value());
+                            results.push_back(condition);
+                        }
                     }
-
-                    results.push_back(condition);
                 }
             }
-        }
-    }
-
-    return results;
+        });
+        return results;
+    });
 }
 
 // Reference Data - Exchanges
-std::vector<Exchange> RESTClient::get_exchanges() {
-    std::string path = "/v3/reference/exchanges";
-    auto response = send_request(core::HttpMethod::Get, path);
-
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
+namespace {
+std::vector<Exchange> parse_exchanges(const std::string &body) {
+    auto doc_result = iterate_json(body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
@@ -786,15 +740,17 @@ std::vector<Exchange> RESTClient::get_exchanges() {
 
     return results;
 }
+} // namespace
 
-// Reference Data - Contracts
-OptionsContract RESTClient::get_options_contract(const std::string &ticker) {
-    std::string path = "/v3/reference/options/contracts/" + ticker;
-    auto response = send_request(core::HttpMethod::Get, path);
+std::vector<Exchange> RESTClient::get_exchanges() {
+    std::string path = "/v3/reference/exchanges";
+    return cached_get<std::vector<Exchange>>(path, {}, parse_exchanges);
+}
 
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
+// Reference Data - Contracts
+namespace {
+OptionsContract parse_options_contract(const std::string &body) {
+    auto doc_result = iterate_json(body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
@@ -843,6 +799,12 @@ OptionsContract RESTClient::get_options_contract(const std::string &ticker) {
 
     return contract;
 }
+} // namespace
+
+OptionsContract RESTClient::get_options_contract(const std::string &ticker) {
+    std::string path = "/v3/reference/options/contracts/" + ticker;
+    return cached_get<OptionsContract>(path, {}, parse_options_contract);
+}
 
 std::vector<OptionsContract> RESTClient::list_options_contracts(
     const std::optional<std::string> &underlying_ticker,
@@ -866,7 +828,7 @@ std::vector<OptionsContract> RESTClient::list_options_contracts(
     std::optional<int> limit,
     const std::optional<std::string> &sort,
     const std::optional<std::string> &order) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
     if (underlying_ticker.has_value()) {
         params["underlying_ticker"] = underlying_ticker.value();
     }
@@ -932,64 +894,55 @@ std::vector<OptionsContract> RESTClient::list_options_contracts(
     }
 
     std::string path = "/v3/reference/options/contracts";
-    auto response = send_request(core::HttpMethod::Get, path, params);
-
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
-    if (doc_result.error()) {
-        throw std::runtime_error("Failed to parse JSON response");
-    }
-    auto& doc = doc_result.value();
-    auto root_obj = doc.get_object();
-    if (root_obj.error()) {
-        throw std::runtime_error("Response is not a JSON object");
-    }
 
     std::vector<OptionsContract> results;
-    auto results_field = root_obj.value().find_field_unordered("results");
-    if (!results_field.error()) {
-        auto results_array = results_field.value().get_array();
-        if (!results_array.error()) {
-            for (auto result_elem : results_array.value()) {
-                auto obj_result = result_elem.get_object();
-                if (!obj_result.error()) {
-                    auto obj = obj_result.value();
-                    OptionsContract contract;
+    collect_pages(path, params, results, [&](::simdjson::ondemand::object &root) {
+        auto results_field = root.find_field_unordered("results");
+        if (!results_field.error()) {
+            auto results_array = results_field.value().get_array();
+            if (!results_array.error()) {
+                for (auto result_elem : results_array.value()) {
+                    auto obj_result = result_elem.get_object();
+                    if (!obj_result.error()) {
+                        auto obj = obj_result.value();
+                        OptionsContract contract;
+
+                        auto ticker_field = obj.find_field_unordered("ticker");
+                        if (!ticker_field.error()) {
+                            contract.ticker =
+                                std::string(ticker_field.value().get_string().value());
+                        }
 
-                    auto ticker_field = obj.find_field_unordered("ticker");
-                    if (!ticker_field.error()) {
-                        contract.ticker = std::string(ticker_field.value().get_string().value());
-                    }
+                        auto underlying_ticker_field =
+                            obj.find_field_unordered("underlying_ticker");
+                        if (!underlying_ticker_field.error()) {
+                            contract.underlying_ticker =
+                                std::string(underlying_ticker_field.value().get_string().value());
+                        }
 
-                    auto underlying_ticker_field = obj.find_field_unordered("underlying_ticker");
-                    if (!underlying_ticker_field.error()) {
-                        contract.underlying_ticker =
-                            std::string(underlying_ticker_field.value().get_string().value());
-                    }
+                        auto contract_type_field = obj.find_field_unordered("contract_type");
+                        if (!contract_type_field.error()) {
+                            contract.contract_type =
+                                std::string(contract_type_field.value().get_string().value());
+                        }
 
-                    auto contract_type_field = obj.find_field_unordered("contract_type");
-                    if (!contract_type_field.error()) {
-                        contract.contract_type =
-                            std::string(contract_type_field.value().get_string().value());
-                    }
+                        auto expiration_date_field = obj.find_field_unordered("expiration_date");
+                        if (!expiration_date_field.error()) {
+                            contract.expiration_date =
+                                std::string(expiration_date_field.value().get_string().value());
+                        }
 
-                    auto expiration_date_field = obj.find_field_unordered("expiration_date");
-                    if (!expiration_date_field.error()) {
-                        contract.expiration_date =
-                            std::string(expiration_date_field.value().get_string().value());
-                    }
+                        auto strike_price_field = obj.find_field_unordered("strike_price");
+                        if (!strike_price_field.error()) {
+                            contract.strike_price = strike_price_field.value().get_double().value();
+                        }
 
-                    auto strike_price_field = obj.find_field_unordered("strike_price");
-                    if (!strike_price_field.error()) {
-                        contract.strike_price = strike_price_field.value().get_double().value();
+                        results.push_back(contract);
                     }
-
-                    results.push_back(contract);
                 }
             }
         }
-    }
+    });
 
     return results;
 }
@@ -1002,7 +955,7 @@ std::vector<IPO> RESTClient::list_ipos(
     const std::optional<std::string> &listing_date_gt, const std::optional<std::string> &listing_date_gte,
     const std::optional<std::string> &ipo_status, std::optional<int> limit,
     const std::optional<std::string> &sort, const std::optional<std::string> &order) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
     if (ticker.has_value()) {
         params["ticker"] = ticker.value();
     }
@@ -1041,106 +994,98 @@ std::vector<IPO> RESTClient::list_ipos(
     }
 
     std::string path = "/vX/reference/ipos";
-    auto response = send_request(core::HttpMethod::Get, path, params);
-
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
-    if (doc_result.error()) {
-        throw std::runtime_error("Failed to parse JSON response");
-    }
-    auto& doc = doc_result.value();
-    auto root_obj = doc.get_object();
-    if (root_obj.error()) {
-        throw std::runtime_error("Response is not a JSON object");
-    }
 
     std::vector<IPO> results;
-    auto results_field = root_obj.value().find_field_unordered("results");
-    if (!results_field.error()) {
-        auto results_array = results_field.value().get_array();
-        if (!results_array.error()) {
-            for (auto result_elem : results_array.value()) {
-                auto obj_result = result_elem.get_object();
-                if (!obj_result.error()) {
-                    auto obj = obj_result.value();
-                    IPO ipo;
+    collect_pages(path, params, results, [&](::simdjson::ondemand::object &root) {
+        auto results_field = root.find_field_unordered("results");
+        if (!results_field.error()) {
+            auto results_array = results_field.value().get_array();
+            if (!results_array.error()) {
+                for (auto result_elem : results_array.value()) {
+                    auto obj_result = result_elem.get_object();
+                    if (!obj_result.error()) {
+                        auto obj = obj_result.value();
+                        IPO ipo;
+
+                        auto ticker_field = obj.find_field_unordered("ticker");
+                        if (!ticker_field.error()) {
+                            ipo.ticker = std::string(ticker_field.value().get_string().value());
+                        }
 
-                    auto ticker_field = obj.find_field_unordered("ticker");
-                    if (!ticker_field.error()) {
-                        ipo.ticker = std::string(ticker_field.value().get_string().value());
-                    }
+                        auto name_field = obj.find_field_unordered("name");
+                        if (!name_field.error()) {
+                            ipo.name = std::string(name_field.value().get_string().value());
+                        }
 
-                    auto name_field = obj.find_field_unordered("name");
-                    if (!name_field.error()) {
-                        ipo.name = std::string(name_field.value().get_string().value());
-                    }
+                        auto market_field = obj.find_field_unordered("market");
+                        if (!market_field.error()) {
+                            ipo.market = std::string(market_field.value().get_string().value());
+                        }
 
-                    auto market_field = obj.find_field_unordered("market");
-                    if (!market_field.error()) {
-                        ipo.market = std::string(market_field.value().get_string().value());
-                    }
+                        auto locale_field = obj.find_field_unordered("locale");
+                        if (!locale_field.error()) {
+                            ipo.locale = std::string(locale_field.value().get_string().value());
+                        }
 
-                    auto locale_field = obj.find_field_unordered("locale");
-                    if (!locale_field.error()) {
-                        ipo.locale = std::string(locale_field.value().get_string().value());
-                    }
+                        auto primary_exchange_field = obj.find_field_unordered("primary_exchange");
+                        if (!primary_exchange_field.error()) {
+                            ipo.primary_exchange =
+                                std::string(primary_exchange_field.value().get_string().value());
+                        }
 
-                    auto primary_exchange_field = obj.find_field_unordered("primary_exchange");
-                    if (!primary_exchange_field.error()) {
-                        ipo.primary_exchange = std::string(primary_exchange_field.value().get_string().value());
-                    }
+                        auto type_field = obj.find_field_unordered("type");
+                        if (!type_field.error()) {
+                            ipo.type = std::string(type_field.value().get_string().value());
+                        }
 
-                    auto type_field = obj.find_field_unordered("type");
-                    if (!type_field.error()) {
-                        ipo.type = std::string(type_field.value().get_string().value());
-                    }
+                        auto date_field = obj.find_field_unordered("date");
+                        if (!date_field.error()) {
+                            ipo.date = std::string(date_field.value().get_string().value());
+                        }
 
-                    auto date_field = obj.find_field_unordered("date");
-                    if (!date_field.error()) {
-                        ipo.date = std::string(date_field.value().get_string().value());
-                    }
+                        auto exchange_field = obj.find_field_unordered("exchange");
+                        if (!exchange_field.error()) {
+                            ipo.exchange = std::string(exchange_field.value().get_string().value());
+                        }
 
-                    auto exchange_field = obj.find_field_unordered("exchange");
-                    if (!exchange_field.error()) {
-                        ipo.exchange = std::string(exchange_field.value().get_string().value());
-                    }
+                        auto exchange_symbol_field = obj.find_field_unordered("exchange_symbol");
+                        if (!exchange_symbol_field.error()) {
+                            ipo.exchange_symbol =
+                                std::string(exchange_symbol_field.value().get_string().value());
+                        }
 
-                    auto exchange_symbol_field = obj.find_field_unordered("exchange_symbol");
-                    if (!exchange_symbol_field.error()) {
-                        ipo.exchange_symbol = std::string(exchange_symbol_field.value().get_string().value());
-                    }
+                        auto name_of_issuer_field = obj.find_field_unordered("name_of_issuer");
+                        if (!name_of_issuer_field.error()) {
+                            ipo.name_of_issuer =
+                                std::string(name_of_issuer_field.value().get_string().value());
+                        }
 
-                    auto name_of_issuer_field = obj.find_field_unordered("name_of_issuer");
-                    if (!name_of_issuer_field.error()) {
-                        ipo.name_of_issuer = std::string(name_of_issuer_field.value().get_string().value());
-                    }
+                        auto shares_field = obj.find_field_unordered("shares");
+                        if (!shares_field.error()) {
+                            ipo.shares = std::string(shares_field.value().get_string().value());
+                        }
 
-                    auto shares_field = obj.find_field_unordered("shares");
-                    if (!shares_field.error()) {
-                        ipo.shares = std::string(shares_field.value().get_string().value());
-                    }
+                        auto price_field = obj.find_field_unordered("price");
+                        if (!price_field.error()) {
+                            ipo.price = price_field.value().get_double().value();
+                        }
 
-                    auto price_field = obj.find_field_unordered("price");
-                    if (!price_field.error()) {
-                        ipo.price = price_field.value().get_double().value();
-                    }
+                        auto currency_field = obj.find_field_unordered("currency");
+                        if (!currency_field.error()) {
+                            ipo.currency = std::string(currency_field.value().get_string().value());
+                        }
 
-                    auto currency_field = obj.find_field_unordered("currency");
-                    if (!currency_field.error()) {
-                        ipo.currency = std::string(currency_field.value().get_string().value());
-                    }
+                        auto status_field = obj.find_field_unordered("status");
+                        if (!status_field.error()) {
+                            ipo.status = std::string(status_field.value().get_string().value());
+                        }
 
-                    auto status_field = obj.find_field_unordered("status");
-                    if (!status_field.error()) {
-                        ipo.status = std::string(status_field.value().get_string().value());
+                        results.push_back(ipo);
                     }
-
-                    results.push_back(ipo);
                 }
             }
         }
-    }
+    });
 
     return results;
 }
@@ -1166,7 +1111,7 @@ std::vector<ShortInterest> RESTClient::list_short_interest(
     std::optional<int> limit,
     const std::optional<std::string> &sort,
     const std::optional<std::string> &order) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
     if (ticker.has_value()) {
         params["ticker"] = ticker.value();
     }
@@ -1226,76 +1171,74 @@ std::vector<ShortInterest> RESTClient::list_short_interest(
     }
 
     std::string path = "/v2/reference/short-interest";
-    auto response = send_request(core::HttpMethod::Get, path, params);
-
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
-    if (doc_result.error()) {
-        throw std::runtime_error("Failed to parse JSON response");
-    }
-    auto& doc = doc_result.value();
-    auto root_obj = doc.get_object();
-    if (root_obj.error()) {
-        throw std::runtime_error("Response is not a JSON object");
-    }
 
     std::vector<ShortInterest> results;
-    auto results_field = root_obj.value().find_field_unordered("results");
-    if (!results_field.error()) {
-        auto results_array = results_field.value().get_array();
-        if (!results_array.error()) {
-            for (auto result_elem : results_array.value()) {
-                auto obj_result = result_elem.get_object();
-                if (!obj_result.error()) {
-                    auto obj = obj_result.value();
-                    ShortInterest short_interest;
+    collect_pages(path, params, results, [&](::simdjson::ondemand::object &root) {
+        auto results_field = root.find_field_unordered("results");
+        if (!results_field.error()) {
+            auto results_array = results_field.value().get_array();
+            if (!results_array.error()) {
+                for (auto result_elem : results_array.value()) {
+                    auto obj_result = result_elem.get_object();
+                    if (!obj_result.error()) {
+                        auto obj = obj_result.value();
+                        ShortInterest short_interest;
+
+                        auto ticker_field = obj.find_field_unordered("ticker");
+                        if (!ticker_field.error()) {
+                            short_interest.ticker =
+                                std::string(ticker_field.value().get_string().value());
+                        }
 
-                    auto ticker_field = obj.find_field_unordered("ticker");
-                    if (!ticker_field.error()) {
-                        short_interest.ticker = std::string(ticker_field.value().get_string().value());
-                    }
+                        auto settlement_date_field = obj.find_field_unordered("settlement_date");
+                        if (!settlement_date_field.error()) {
+                            short_interest.settlement_date =
+                                std::string(settlement_date_field.value().get_string().value());
+                        }
 
-                    auto settlement_date_field = obj.find_field_unordered("settlement_date");
-                    if (!settlement_date_field.error()) {
-                        short_interest.settlement_date = std::string(settlement_date_field.value().get_string().value());
-                    }
+                        auto current_short_interest_field =
+                            obj.find_field_unordered("current_short_interest");
+                        if (!current_short_interest_field.error()) {
+                            short_interest.current_short_interest =
+                                current_short_interest_field.value().get_int64().value();
+                        }
 
-                    auto current_short_interest_field = obj.find_field_unordered("current_short_interest");
-                    if (!current_short_interest_field.error()) {
-                        short_interest.current_short_interest = current_short_interest_field.value().get_int64().value();
-                    }
+                        auto previous_short_interest_field =
+                            obj.find_field_unordered("previous_short_interest");
+                        if (!previous_short_interest_field.error()) {
+                            short_interest.previous_short_interest =
+                                previous_short_interest_field.value().get_int64().value();
+                        }
 
-                    auto previous_short_interest_field = obj.find_field_unordered("previous_short_interest");
-                    if (!previous_short_interest_field.error()) {
-                        short_interest.previous_short_interest = previous_short_interest_field.value().get_int64().value();
-                    }
+                        auto change_field = obj.find_field_unordered("change");
+                        if (!change_field.error()) {
+                            short_interest.change = change_field.value().get_double().value();
+                        }
 
-                    auto change_field = obj.find_field_unordered("change");
-                    if (!change_field.error()) {
-                        short_interest.change = change_field.value().get_double().value();
-                    }
+                        auto change_percent_field = obj.find_field_unordered("change_percent");
+                        if (!change_percent_field.error()) {
+                            short_interest.change_percent =
+                                change_percent_field.value().get_double().value();
+                        }
 
-                    auto change_percent_field = obj.find_field_unordered("change_percent");
-                    if (!change_percent_field.error()) {
-                        short_interest.change_percent = change_percent_field.value().get_double().value();
-                    }
+                        auto day_to_cover_field = obj.find_field_unordered("day_to_cover");
+                        if (!day_to_cover_field.error()) {
+                            short_interest.day_to_cover =
+                                day_to_cover_field.value().get_int64().value();
+                        }
 
-                    auto day_to_cover_field = obj.find_field_unordered("day_to_cover");
-                    if (!day_to_cover_field.error()) {
-                        short_interest.day_to_cover = day_to_cover_field.value().get_int64().value();
-                    }
+                        auto name_field = obj.find_field_unordered("name");
+                        if (!name_field.error()) {
+                            short_interest.name =
+                                std::string(name_field.value().get_string().value());
+                        }
 
-                    auto name_field = obj.find_field_unordered("name");
-                    if (!name_field.error()) {
-                        short_interest.name = std::string(name_field.value().get_string().value());
+                        results.push_back(short_interest);
                     }
-
-                    results.push_back(short_interest);
                 }
             }
         }
-    }
+    });
 
     return results;
 }
@@ -1321,7 +1264,7 @@ std::vector<ShortVolume> RESTClient::list_short_volume(
     std::optional<int> limit,
     const std::optional<std::string> &sort,
     const std::optional<std::string> &order) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
     if (ticker.has_value()) {
         params["ticker"] = ticker.value();
     }
@@ -1381,61 +1324,56 @@ std::vector<ShortVolume> RESTClient::list_short_volume(
     }
 
     std::string path = "/v2/reference/short-volume";
-    auto response = send_request(core::HttpMethod::Get, path, params);
-
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
-    if (doc_result.error()) {
-        throw std::runtime_error("Failed to parse JSON response");
-    }
-    auto& doc = doc_result.value();
-    auto root_obj = doc.get_object();
-    if (root_obj.error()) {
-        throw std::runtime_error("Response is not a JSON object");
-    }
 
     std::vector<ShortVolume> results;
-    auto results_field = root_obj.value().find_field_unordered("results");
-    if (!results_field.error()) {
-        auto results_array = results_field.value().get_array();
-        if (!results_array.error()) {
-            for (auto result_elem : results_array.value()) {
-                auto obj_result = result_elem.get_object();
-                if (!obj_result.error()) {
-                    auto obj = obj_result.value();
-                    ShortVolume short_volume;
+    collect_pages(path, params, results, [&](::simdjson::ondemand::object &root) {
+        auto results_field = root.find_field_unordered("results");
+        if (!results_field.error()) {
+            auto results_array = results_field.value().get_array();
+            if (!results_array.error()) {
+                for (auto result_elem : results_array.value()) {
+                    auto obj_result = result_elem.get_object();
+                    if (!obj_result.error()) {
+                        auto obj = obj_result.value();
+                        ShortVolume short_volume;
+
+                        auto ticker_field = obj.find_field_unordered("ticker");
+                        if (!ticker_field.error()) {
+                            short_volume.ticker =
+                                std::string(ticker_field.value().get_string().value());
+                        }
 
-                    auto ticker_field = obj.find_field_unordered("ticker");
-                    if (!ticker_field.error()) {
-                        short_volume.ticker = std::string(ticker_field.value().get_string().value());
-                    }
+                        auto date_field = obj.find_field_unordered("date");
+                        if (!date_field.error()) {
+                            short_volume.date =
+                                std::string(date_field.value().get_string().value());
+                        }
 
-                    auto date_field = obj.find_field_unordered("date");
-                    if (!date_field.error()) {
-                        short_volume.date = std::string(date_field.value().get_string().value());
-                    }
+                        auto short_volume_field = obj.find_field_unordered("short_volume");
+                        if (!short_volume_field.error()) {
+                            short_volume.short_volume =
+                                short_volume_field.value().get_int64().value();
+                        }
 
-                    auto short_volume_field = obj.find_field_unordered("short_volume");
-                    if (!short_volume_field.error()) {
-                        short_volume.short_volume = short_volume_field.value().get_int64().value();
-                    }
+                        auto total_volume_field = obj.find_field_unordered("total_volume");
+                        if (!total_volume_field.error()) {
+                            short_volume.total_volume =
+                                total_volume_field.value().get_int64().value();
+                        }
 
-                    auto total_volume_field = obj.find_field_unordered("total_volume");
-                    if (!total_volume_field.error()) {
-                        short_volume.total_volume = total_volume_field.value().get_int64().value();
-                    }
+                        auto short_volume_ratio_field =
+                            obj.find_field_unordered("short_volume_ratio");
+                        if (!short_volume_ratio_field.error()) {
+                            short_volume.short_volume_ratio =
+                                short_volume_ratio_field.value().get_double().value();
+                        }
 
-                    auto short_volume_ratio_field = obj.find_field_unordered("short_volume_ratio");
-                    if (!short_volume_ratio_field.error()) {
-                        short_volume.short_volume_ratio = short_volume_ratio_field.value().get_double().value();
+                        results.push_back(short_volume);
                     }
-
-                    results.push_back(short_volume);
                 }
             }
         }
-    }
+    });
 
     return results;
 }
@@ -1444,7 +1382,7 @@ std::vector<ShortVolume> RESTClient::list_short_volume(
 TickerChangeResults RESTClient::get_ticker_events(
     const std::string& ticker,
     const std::optional<std::string>& types) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
     if (types.has_value()) {
         params["types"] = types.value();
     }
@@ -1452,9 +1390,7 @@ TickerChangeResults RESTClient::get_ticker_events(
     std::string path = "/vX/reference/tickers/" + ticker + "/events";
     auto response = send_request(core::HttpMethod::Get, path, params);
 
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
+    auto doc_result = iterate_json(response.body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
@@ -1508,9 +1444,11 @@ TickerChangeResults RESTClient::get_ticker_events(
                         auto ticker_change_obj = ticker_change_field.value().get_object();
                         if (!ticker_change_obj.error()) {
                             TickerChange ticker_change;
-                            auto ticker_field = ticker_change_obj.value().find_field_unordered("ticker");
+                            auto ticker_field =
+                                ticker_change_obj.value().find_field_unordered("ticker");
                             if (!ticker_field.error()) {
-                                ticker_change.ticker = std::string(ticker_field.value().get_string().value());
+                                ticker_change.ticker =
+                                    std::string(ticker_field.value().get_string().value());
                             }
                             event.ticker_change = ticker_change;
                         }
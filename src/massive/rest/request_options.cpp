@@ -41,6 +41,11 @@ RequestOptionBuilder& RequestOptionBuilder::body(const std::string& body) {
     return *this;
 }
 
+RequestOptionBuilder& RequestOptionBuilder::hedge(const HedgePolicy& policy) {
+    options_.hedge = policy;
+    return *this;
+}
+
 RequestOptions RequestOptionBuilder::build() const {
     return options_;
 }
@@ -0,0 +1,175 @@
+#include "massive/rest/results_stream.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+namespace massive::rest {
+
+namespace {
+// Kept apart from iterate_json's parser so an element handler can still use that one.
+::simdjson::ondemand::parser &element_parser() {
+    thread_local ::simdjson::ondemand::parser parser;
+    return parser;
+}
+} // namespace
+
+ResultsStreamParser::ResultsStreamParser(ElementHandler on_element)
+    : on_element_(std::move(on_element)) {}
+
+void ResultsStreamParser::feed(std::string_view chunk) {
+    // Bytes from `start` up to the current position still have to be copied into the envelope
+    // or the current element, depending on the mode. Between elements nothing is kept.
+    std::size_t start = 0;
+    auto flush = [&](std::size_t end) {
+        if (mode_ == Mode::Envelope) {
+            envelope_.append(chunk.data() + start, end - start);
+        } else if (mode_ == Mode::Element) {
+            element_.append(chunk.data() + start, end - start);
+        }
+        start = end;
+    };
+
+    for (std::size_t i = 0; i < chunk.size(); ++i) {
+        const char c = chunk[i];
+        const bool top_level = mode_ == Mode::Envelope && depth_ == 1;
+        if (in_string_) {
+            if (escaped_) {
+                escaped_ = false;
+            } else if (c == '\\') {
+                escaped_ = true;
+            } else if (c == '"') {
+                in_string_ = false;
+            } else if (top_level) {
+                key_ += c;
+            }
+            continue;
+        }
+
+        switch (c) {
+        case '"':
+            in_string_ = true;
+            if (top_level) {
+                key_.clear();
+            }
+            break;
+        case ':':
+            if (top_level) {
+                results_key_ = key_ == "results";
+            }
+            break;
+        case '[':
+        case '{':
+            ++depth_;
+            if (top_level && c == '[' && results_key_) {
+                // The envelope keeps the brackets but none of the elements.
+                flush(i + 1);
+                mode_ = Mode::Results;
+                results_key_ = false;
+            } else if (mode_ == Mode::Results) {
+                start = i;
+                mode_ = Mode::Element;
+            }
+            break;
+        case ']':
+        case '}':
+            if (depth_ == 0) {
+                throw std::runtime_error("Malformed JSON response");
+            }
+            --depth_;
+            if (mode_ == Mode::Element && depth_ == 2) {
+                flush(i + 1);
+                emit();
+                mode_ = Mode::Results;
+            } else if (mode_ == Mode::Results) {
+                start = i;
+                mode_ = Mode::Envelope;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    flush(chunk.size());
+}
+
+void ResultsStreamParser::reset() {
+    envelope_.clear();
+    element_.clear();
+    key_.clear();
+    results_key_ = false;
+    mode_ = Mode::Envelope;
+    depth_ = 0;
+    in_string_ = false;
+    escaped_ = false;
+    elements_ = 0;
+}
+
+void ResultsStreamParser::finish() const {
+    if (depth_ != 0 || in_string_) {
+        throw std::runtime_error("Truncated JSON response");
+    }
+}
+
+void ResultsStreamParser::emit() {
+    ++elements_;
+    element_.reserve(element_.size() + ::simdjson::SIMDJSON_PADDING);
+    auto document =
+        element_parser().iterate(element_.data(), element_.size(), element_.capacity());
+    if (document.error()) {
+        throw std::runtime_error("Failed to parse JSON response");
+    }
+    auto object = document.get_object();
+    if (!object.error()) {
+        auto element = object.value();
+        on_element_(element);
+    }
+    element_.clear();
+}
+
+ChunkQueue::ChunkQueue(std::size_t capacity) : capacity_(capacity == 0 ? 1 : capacity) {}
+
+void ChunkQueue::push(std::string_view chunk) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return abandoned_ || chunks_.size() < capacity_; });
+    if (abandoned_) {
+        throw std::runtime_error("Response body no longer wanted");
+    }
+    chunks_.emplace_back(std::string(chunk));
+    cv_.notify_all();
+}
+
+void ChunkQueue::push_restart() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    chunks_.emplace_back(std::nullopt);
+    cv_.notify_all();
+}
+
+void ChunkQueue::close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    cv_.notify_all();
+}
+
+bool ChunkQueue::pop(std::string &chunk, bool &restart) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return closed_ || !chunks_.empty(); });
+    if (chunks_.empty()) {
+        return false;
+    }
+    restart = !chunks_.front().has_value();
+    if (!restart) {
+        chunk = std::move(*chunks_.front());
+    }
+    chunks_.pop_front();
+    cv_.notify_all();
+    return true;
+}
+
+void ChunkQueue::abandon() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    abandoned_ = true;
+    chunks_.clear();
+    cv_.notify_all();
+}
+
+} // namespace massive::rest
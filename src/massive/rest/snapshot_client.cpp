@@ -1,4 +1,5 @@
 #include "massive/rest/client.hpp"
+#include "massive/rest/json_parser.hpp"
 #include <simdjson/ondemand.h>
 #include <stdexcept>
 
@@ -176,16 +177,15 @@ TickerSnapshot parse_ticker_snapshot_from_object(ObjectType& ticker_obj) {
 } // namespace
 
 TickerSnapshot RESTClient::get_snapshot_ticker(SnapshotMarketType market_type,
-                                               const std::string &ticker) {
+                                               const std::string &ticker,
+                                               const std::optional<RequestOptions> &options) {
     std::string locale = get_locale(market_type);
     std::string market_type_str = to_string(market_type);
     std::string path =
         "/v2/snapshot/locale/" + locale + "/markets/" + market_type_str + "/tickers/" + ticker;
-    auto response = send_request(core::HttpMethod::Get, path);
+    auto response = send_request(core::HttpMethod::Get, path, {}, options);
 
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
+    auto doc_result = iterate_json(response.body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
@@ -267,7 +267,7 @@ std::vector<TickerSnapshot> RESTClient::get_snapshot_all(SnapshotMarketType mark
     std::string market_type_str = to_string(market_type);
     std::string path = "/v2/snapshot/locale/" + locale + "/markets/" + market_type_str + "/tickers";
 
-    std::map<std::string, std::string> params;
+    QueryParams params;
     if (!tickers.empty()) {
         std::string tickers_str;
         for (size_t i = 0; i < tickers.size(); ++i) {
@@ -283,9 +283,7 @@ std::vector<TickerSnapshot> RESTClient::get_snapshot_all(SnapshotMarketType mark
 
     auto response = send_request(core::HttpMethod::Get, path, params);
 
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
+    auto doc_result = iterate_json(response.body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
@@ -381,16 +379,14 @@ std::vector<TickerSnapshot> RESTClient::get_snapshot_direction(SnapshotMarketTyp
     std::string path =
         "/v2/snapshot/locale/" + locale + "/markets/" + market_type_str + "/" + direction_str;
 
-    std::map<std::string, std::string> params;
+    QueryParams params;
     if (include_otc) {
         params["include_otc"] = "true";
     }
 
     auto response = send_request(core::HttpMethod::Get, path, params);
 
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
+    auto doc_result = iterate_json(response.body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
@@ -483,7 +479,7 @@ std::vector<UniversalSnapshot> RESTClient::list_universal_snapshots(
     const std::optional<std::string> &ticker_gt, const std::optional<std::string> &ticker_gte,
     std::optional<int> limit, const std::optional<std::string> &sort,
     const std::optional<std::string> &order) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
     if (type.has_value()) {
         params["type"] = type.value();
     }
@@ -519,57 +515,47 @@ std::vector<UniversalSnapshot> RESTClient::list_universal_snapshots(
     }
 
     std::string path = "/v3/snapshot";
-    auto response = send_request(core::HttpMethod::Get, path, params);
-
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
-    if (doc_result.error()) {
-        throw std::runtime_error("Failed to parse JSON response");
-    }
-    auto& doc = doc_result.value();
-    auto root_obj = doc.get_object();
-    if (root_obj.error()) {
-        throw std::runtime_error("Response is not a JSON object");
-    }
 
     std::vector<UniversalSnapshot> results;
-    auto results_field = root_obj.value().find_field_unordered("results");
-    if (!results_field.error()) {
-        auto results_array = results_field.value().get_array();
-        if (!results_array.error()) {
-            for (auto result_elem : results_array.value()) {
-                auto obj_result = result_elem.get_object();
-                if (!obj_result.error()) {
-                    auto obj = obj_result.value();
-                    UniversalSnapshot snapshot;
-
-                    auto ticker_field = obj.find_field_unordered("ticker");
-                    if (!ticker_field.error()) {
-                        snapshot.ticker = std::string(ticker_field.value().get_string().value());
-                    }
+    collect_pages(path, params, results, [&](::simdjson::ondemand::object &root) {
+        auto results_field = root.find_field_unordered("results");
+        if (!results_field.error()) {
+            auto results_array = results_field.value().get_array();
+            if (!results_array.error()) {
+                for (auto result_elem : results_array.value()) {
+                    auto obj_result = result_elem.get_object();
+                    if (!obj_result.error()) {
+                        auto obj = obj_result.value();
+                        UniversalSnapshot snapshot;
+
+                        auto ticker_field = obj.find_field_unordered("ticker");
+                        if (!ticker_field.error()) {
+                            snapshot.ticker =
+                                std::string(ticker_field.value().get_string().value());
+                        }
 
-                    auto type_field = obj.find_field_unordered("type");
-                    if (!type_field.error()) {
-                        snapshot.type = std::string(type_field.value().get_string().value());
-                    }
+                        auto type_field = obj.find_field_unordered("type");
+                        if (!type_field.error()) {
+                            snapshot.type = std::string(type_field.value().get_string().value());
+                        }
 
-                    // Note: Full parsing of nested structures (session, last_quote, etc.)
-                    // would require more complex parsing. This is a simplified version.
-                    // Full implementation would parse all nested fields.
+                        // Note: Full parsing of nested structures (session, last_quote, etc.)
+                        // would require more complex parsing. This is a simplified version.
+                        // Full implementation would parse all nested fields.
 
-                    results.push_back(snapshot);
+                        results.push_back(snapshot);
+                    }
                 }
             }
         }
-    }
+    });
 
     return results;
 }
 
 std::vector<IndicesSnapshot>
 RESTClient::get_snapshot_indices(const std::vector<std::string> &ticker_any_of) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
     if (!ticker_any_of.empty()) {
         std::string tickers_str;
         for (size_t i = 0; i < ticker_any_of.size(); ++i) {
@@ -583,9 +569,7 @@ RESTClient::get_snapshot_indices(const std::vector<std::string> &ticker_any_of)
     std::string path = "/v3/snapshot/indices";
     auto response = send_request(core::HttpMethod::Get, path, params);
 
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
+    auto doc_result = iterate_json(response.body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
@@ -640,9 +624,7 @@ TickerSnapshot RESTClient::get_snapshot_option(const std::string& option_ticker)
     std::string path = "/v2/snapshot/options/" + option_ticker;
     auto response = send_request(core::HttpMethod::Get, path);
 
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
+    auto doc_result = iterate_json(response.body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
@@ -669,7 +651,7 @@ std::vector<TickerSnapshot> RESTClient::list_snapshot_options_chain(
     const std::string& underlying_ticker,
     const std::optional<std::string>& expiration_date,
     const std::optional<std::string>& contract_type) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
     params["underlying_ticker"] = underlying_ticker;
     if (expiration_date.has_value()) {
         params["expiration_date"] = expiration_date.value();
@@ -679,34 +661,23 @@ std::vector<TickerSnapshot> RESTClient::list_snapshot_options_chain(
     }
 
     std::string path = "/v3/snapshot/options/" + underlying_ticker;
-    auto response = send_request(core::HttpMethod::Get, path, params);
-
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
-    if (doc_result.error()) {
-        throw std::runtime_error("Failed to parse JSON response");
-    }
-    auto& doc = doc_result.value();
-    auto root_obj = doc.get_object();
-    if (root_obj.error()) {
-        throw std::runtime_error("Response is not a JSON object");
-    }
 
     std::vector<TickerSnapshot> results;
-    auto results_field = root_obj.value().find_field_unordered("results");
-    if (!results_field.error()) {
-        auto results_array = results_field.value().get_array();
-        if (!results_array.error()) {
-            for (auto result_elem : results_array.value()) {
-                auto obj_result = result_elem.get_object();
-                if (!obj_result.error()) {
-                    auto obj = obj_result.value();
-                    results.push_back(parse_ticker_snapshot_from_object(obj));
+    collect_pages(path, params, results, [&](::simdjson::ondemand::object &root) {
+        auto results_field = root.find_field_unordered("results");
+        if (!results_field.error()) {
+            auto results_array = results_field.value().get_array();
+            if (!results_array.error()) {
+                for (auto result_elem : results_array.value()) {
+                    auto obj_result = result_elem.get_object();
+                    if (!obj_result.error()) {
+                        auto obj = obj_result.value();
+                        results.push_back(parse_ticker_snapshot_from_object(obj));
+                    }
                 }
             }
         }
-    }
+    });
 
     return results;
 }
@@ -716,9 +687,7 @@ SnapshotTickerFullBook RESTClient::get_snapshot_crypto_book(const std::string& t
     std::string path = "/v2/snapshot/locale/global/markets/crypto/tickers/" + ticker + "/book";
     auto response = send_request(core::HttpMethod::Get, path);
 
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
+    auto doc_result = iterate_json(response.body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
@@ -1,4 +1,5 @@
 #include "massive/rest/client.hpp"
+#include "massive/rest/json_parser.hpp"
 #include <simdjson/ondemand.h>
 #include <stdexcept>
 
@@ -7,7 +8,7 @@ namespace massive::rest {
 // Summaries
 std::vector<SummaryResult>
 RESTClient::get_summaries(const std::vector<std::string> &ticker_any_of) {
-    std::map<std::string, std::string> params;
+    QueryParams params;
     if (!ticker_any_of.empty()) {
         std::string tickers_str;
         for (size_t i = 0; i < ticker_any_of.size(); ++i) {
@@ -21,9 +22,7 @@ RESTClient::get_summaries(const std::vector<std::string> &ticker_any_of) {
     std::string path = "/v1/summaries";
     auto response = send_request(core::HttpMethod::Get, path, params);
 
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
+    auto doc_result = iterate_json(response.body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
@@ -1,19 +1,38 @@
 #include "massive/rest/client.hpp"
+#include "massive/rest/json_parser.hpp"
 #include <simdjson/ondemand.h>
 #include <stdexcept>
 
 namespace massive::rest {
 
-std::vector<Trade> RESTClient::list_trades(const std::string &ticker,
-                                           const std::optional<std::string> &timestamp,
-                                           const std::optional<std::string> &timestamp_lt,
-                                           const std::optional<std::string> &timestamp_lte,
-                                           const std::optional<std::string> &timestamp_gt,
-                                           const std::optional<std::string> &timestamp_gte,
-                                           std::optional<int> limit,
-                                           const std::optional<std::string> &sort,
-                                           const std::optional<std::string> &order) {
-    std::map<std::string, std::string> params;
+namespace {
+Trade parse_trade(::simdjson::ondemand::object &element) {
+    Trade trade;
+    auto price_field = element.find_field_unordered("p");
+    if (!price_field.error()) {
+        trade.price = price_field.value().get_double().value();
+    }
+
+    auto size_field = element.find_field_unordered("s");
+    if (!size_field.error()) {
+        trade.size = size_field.value().get_int64().value();
+    }
+
+    auto timestamp_field = element.find_field_unordered("t");
+    if (!timestamp_field.error()) {
+        trade.timestamp = timestamp_field.value().get_int64().value();
+    }
+    return trade;
+}
+
+QueryParams trade_params(const std::optional<std::string> &timestamp,
+                         const std::optional<std::string> &timestamp_lt,
+                         const std::optional<std::string> &timestamp_lte,
+                         const std::optional<std::string> &timestamp_gt,
+                         const std::optional<std::string> &timestamp_gte, std::optional<int> limit,
+                         const std::optional<std::string> &sort,
+                         const std::optional<std::string> &order) {
+    QueryParams params;
     if (timestamp.has_value()) {
         params["timestamp"] = timestamp.value();
     }
@@ -38,66 +57,57 @@ std::vector<Trade> RESTClient::list_trades(const std::string &ticker,
     if (order.has_value()) {
         params["order"] = order.value();
     }
+    return params;
+}
+} // namespace
 
-    std::string path = "/v3/trades/" + ticker;
-    auto response = send_request(core::HttpMethod::Get, path, params);
-
-    // Parse JSON response
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
-    if (doc_result.error()) {
-        throw std::runtime_error("Failed to parse JSON response");
-    }
-    auto& doc = doc_result.value();
-    auto root_obj = doc.get_object();
-    if (root_obj.error()) {
-        throw std::runtime_error("Response is not a JSON object");
-    }
-
+std::vector<Trade> RESTClient::list_trades(const std::string &ticker,
+                                           const std::optional<std::string> &timestamp,
+                                           const std::optional<std::string> &timestamp_lt,
+                                           const std::optional<std::string> &timestamp_lte,
+                                           const std::optional<std::string> &timestamp_gt,
+                                           const std::optional<std::string> &timestamp_gte,
+                                           std::optional<int> limit,
+                                           const std::optional<std::string> &sort,
+                                           const std::optional<std::string> &order) {
     std::vector<Trade> results;
-
-    auto results_field = root_obj.value().find_field_unordered("results");
-    if (!results_field.error()) {
-        auto results_array = results_field.value().get_array();
-        if (!results_array.error()) {
-            for (auto result : results_array.value()) {
-                Trade trade;
-                auto obj_result = result.get_object();
-                if (!obj_result.error()) {
-                    auto obj = obj_result.value();
-
-                    auto price_field = obj.find_field_unordered("p");
-                    if (!price_field.error()) {
-                        trade.price = price_field.value().get_double().value();
-                    }
-
-                    auto size_field = obj.find_field_unordered("s");
-                    if (!size_field.error()) {
-                        trade.size = size_field.value().get_int64().value();
-                    }
-
-                    auto timestamp_field = obj.find_field_unordered("t");
-                    if (!timestamp_field.error()) {
-                        trade.timestamp = timestamp_field.value().get_int64().value();
-                    }
-
-                    results.push_back(trade);
-                }
-            }
-        }
-    }
-
+    // Collected results can be taken back, so a page cut off mid-body is simply fetched again.
+    stream_pages(
+        "/v3/trades/" + ticker,
+        trade_params(timestamp, timestamp_lt, timestamp_lte, timestamp_gt, timestamp_gte, limit,
+                     sort, order),
+        [&results](::simdjson::ondemand::object &element) {
+            results.push_back(parse_trade(element));
+        },
+        [&results](std::size_t kept) {
+            results.erase(results.begin() + static_cast<std::ptrdiff_t>(kept), results.end());
+        });
     return results;
 }
 
+void RESTClient::stream_trades(const std::string &ticker,
+                               const std::function<void(const Trade &)> &on_trade,
+                               const std::optional<std::string> &timestamp,
+                               const std::optional<std::string> &timestamp_lt,
+                               const std::optional<std::string> &timestamp_lte,
+                               const std::optional<std::string> &timestamp_gt,
+                               const std::optional<std::string> &timestamp_gte,
+                               std::optional<int> limit,
+                               const std::optional<std::string> &sort,
+                               const std::optional<std::string> &order) {
+    stream_pages("/v3/trades/" + ticker,
+                 trade_params(timestamp, timestamp_lt, timestamp_lte, timestamp_gt, timestamp_gte,
+                              limit, sort, order),
+                 [&](::simdjson::ondemand::object &element) {
+                     on_trade(parse_trade(element));
+                 });
+}
+
 LastTrade RESTClient::get_last_trade(const std::string &ticker) {
     std::string path = "/v2/last/trade/" + ticker;
     auto response = send_request(core::HttpMethod::Get, path);
 
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
+    auto doc_result = iterate_json(response.body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
@@ -144,9 +154,7 @@ CryptoTrade RESTClient::get_last_crypto_trade(const std::string& from, const std
     std::string path = "/v1/last/crypto/" + from + "/" + to;
     auto response = send_request(core::HttpMethod::Get, path);
 
-    ::simdjson::ondemand::parser parser;
-    ::simdjson::padded_string json = response.body;
-    auto doc_result = parser.iterate(json);
+    auto doc_result = iterate_json(response.body);
     if (doc_result.error()) {
         throw std::runtime_error("Failed to parse JSON response");
     }
@@ -0,0 +1,481 @@
+#include "massive/testing/loopback_server.hpp"
+
+#include <boost/asio/ip/tcp.hpp>
+// Must follow ip/tcp.hpp: awaitable.hpp uses std::exchange without including <utility>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <boost/beast/ssl.hpp>
+#include <boost/beast/websocket.hpp>
+#include <boost/beast/websocket/ssl.hpp>
+
+#include <openssl/evp.h>
+#include <openssl/x509.h>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace massive::testing {
+
+namespace net = boost::asio;
+namespace ssl = boost::asio::ssl;
+namespace beast = boost::beast;
+namespace http = boost::beast::http;
+namespace websocket = boost::beast::websocket;
+using tcp = boost::asio::ip::tcp;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+using TlsStream = beast::ssl_stream<beast::tcp_stream>;
+
+// Throttled bodies are written in pieces of this size.
+constexpr std::size_t kWriteChunk = 16 * 1024;
+constexpr std::int64_t kBaseTimestamp = 1700000000000000000;
+
+// A P-256 key and a one-day certificate for 127.0.0.1, so no files need to ship.
+void use_self_signed_certificate(ssl::context &context) {
+    std::unique_ptr<EVP_PKEY_CTX, decltype(&EVP_PKEY_CTX_free)> key_context(
+        EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr), &EVP_PKEY_CTX_free);
+    EVP_PKEY *raw_key = nullptr;
+    if (!key_context || EVP_PKEY_keygen_init(key_context.get()) <= 0 ||
+        EVP_PKEY_CTX_set_ec_paramgen_curve_nid(key_context.get(), NID_X9_62_prime256v1) <= 0 ||
+        EVP_PKEY_keygen(key_context.get(), &raw_key) <= 0) {
+        throw std::runtime_error("Failed to generate loopback server key");
+    }
+    std::unique_ptr<EVP_PKEY, decltype(&EVP_PKEY_free)> key(raw_key, &EVP_PKEY_free);
+
+    std::unique_ptr<X509, decltype(&X509_free)> certificate(X509_new(), &X509_free);
+    X509_NAME *name = certificate ? X509_get_subject_name(certificate.get()) : nullptr;
+    const auto *common_name = reinterpret_cast<const unsigned char *>("127.0.0.1");
+    if (name == nullptr || X509_set_version(certificate.get(), 2) != 1 ||
+        ASN1_INTEGER_set(X509_get_serialNumber(certificate.get()), 1) != 1 ||
+        X509_gmtime_adj(X509_getm_notBefore(certificate.get()), -3600) == nullptr ||
+        X509_gmtime_adj(X509_getm_notAfter(certificate.get()), 24 * 3600) == nullptr ||
+        X509_set_pubkey(certificate.get(), key.get()) != 1 ||
+        X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, common_name, -1, -1, 0) != 1 ||
+        X509_set_issuer_name(certificate.get(), name) != 1 ||
+        X509_sign(certificate.get(), key.get(), EVP_sha256()) == 0 ||
+        SSL_CTX_use_certificate(context.native_handle(), certificate.get()) != 1 ||
+        SSL_CTX_use_PrivateKey(context.native_handle(), key.get()) != 1) {
+        throw std::runtime_error("Failed to create loopback server certificate");
+    }
+}
+
+// The value of `name` in a request target's query, or empty.
+std::string_view query_value(std::string_view target, std::string_view name) {
+    const auto query = target.find('?');
+    if (query == std::string_view::npos) {
+        return {};
+    }
+    std::string_view rest = target.substr(query + 1);
+    while (!rest.empty()) {
+        const auto amp = rest.find('&');
+        const auto pair = rest.substr(0, amp);
+        rest = amp == std::string_view::npos ? std::string_view() : rest.substr(amp + 1);
+        if (pair.size() > name.size() && pair.substr(0, name.size()) == name &&
+            pair[name.size()] == '=') {
+            return pair.substr(name.size() + 1);
+        }
+    }
+    return {};
+}
+
+std::size_t parse_count(std::string_view text) {
+    std::size_t value = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') {
+            return 0;
+        }
+        value = value * 10 + static_cast<std::size_t>(c - '0');
+    }
+    return value;
+}
+
+// One synthetic trade in the single-letter form the REST and WebSocket parsers read. `prefix`
+// holds extra leading fields, such as the event type of a WebSocket message.
+void append_trade(std::string &out, std::size_t sequence, std::string_view prefix = {}) {
+    out += '{';
+    out += prefix;
+    out += R"("c":[12,37],"i":")";
+    out += std::to_string(sequence);
+    out += R"(","p":)";
+    out += std::to_string(100 + sequence % 50);
+    out += '.';
+    out += std::to_string(10 + sequence % 90);
+    out += R"(,"q":)";
+    out += std::to_string(sequence);
+    out += R"(,"s":)";
+    out += std::to_string(1 + sequence % 500);
+    out += R"(,"t":)";
+    out += std::to_string(kBaseTimestamp + static_cast<std::int64_t>(sequence) * 1000);
+    out += R"(,"x":11,"z":3})";
+}
+} // namespace
+
+struct LoopbackServer::Impl {
+    explicit Impl(LoopbackServerOptions opts) : options(std::move(opts)) {
+        options.threads = std::max<std::size_t>(options.threads, 1);
+        use_self_signed_certificate(tls);
+    }
+
+    net::awaitable<void> accept_loop();
+    net::awaitable<void> serve(tcp::socket socket);
+    net::awaitable<void> respond(TlsStream &stream, const http::request<http::string_body> &req,
+                                 bool &keep_alive);
+    net::awaitable<void> serve_websocket(TlsStream stream,
+                                         http::request<http::string_body> req);
+    [[nodiscard]] std::string trades_page(std::string_view target) const;
+
+    LoopbackServerOptions options;
+    ssl::context tls{ssl::context::tls_server};
+    // Reset by stop(), which destroys every pending connection with it.
+    std::optional<net::io_context> context;
+    std::optional<tcp::acceptor> acceptor;
+    std::vector<std::thread> threads;
+    std::uint16_t port{0};
+
+    std::atomic<std::uint64_t> connections{0};
+    std::atomic<std::uint64_t> requests{0};
+    std::atomic<std::uint64_t> throttled{0};
+    std::atomic<std::uint64_t> disconnects{0};
+    std::atomic<std::uint64_t> websocket_sessions{0};
+    std::atomic<std::uint64_t> frames{0};
+};
+
+net::awaitable<void> LoopbackServer::Impl::accept_loop() {
+    while (true) {
+        boost::system::error_code ec;
+        tcp::socket socket(net::make_strand(*context));
+        co_await acceptor->async_accept(socket, net::redirect_error(net::use_awaitable, ec));
+        if (ec == net::error::operation_aborted) {
+            co_return;
+        }
+        if (ec) {
+            continue;
+        }
+        connections.fetch_add(1, std::memory_order_relaxed);
+        net::co_spawn(socket.get_executor(), serve(std::move(socket)), net::detached);
+    }
+}
+
+net::awaitable<void> LoopbackServer::Impl::serve(tcp::socket socket) {
+    TlsStream stream(beast::tcp_stream(std::move(socket)), tls);
+    boost::system::error_code ec;
+    co_await stream.async_handshake(ssl::stream_base::server,
+                                    net::redirect_error(net::use_awaitable, ec));
+    if (ec) {
+        co_return;
+    }
+
+    beast::flat_buffer buffer;
+    bool keep_alive = true;
+    while (keep_alive) {
+        http::request<http::string_body> req;
+        co_await http::async_read(stream, buffer, req,
+                                  net::redirect_error(net::use_awaitable, ec));
+        if (ec) {
+            co_return;
+        }
+        if (websocket::is_upgrade(req)) {
+            co_await serve_websocket(std::move(stream), std::move(req));
+            co_return;
+        }
+        keep_alive = req.keep_alive();
+        co_await respond(stream, req, keep_alive);
+    }
+    co_await stream.async_shutdown(net::redirect_error(net::use_awaitable, ec));
+}
+
+net::awaitable<void> LoopbackServer::Impl::respond(TlsStream &stream,
+                                                   const http::request<http::string_body> &req,
+                                                   bool &keep_alive) {
+    const auto sequence = requests.fetch_add(1, std::memory_order_relaxed) + 1;
+    auto executor = co_await net::this_coro::executor;
+    boost::system::error_code ec;
+    if (options.latency.count() > 0) {
+        net::steady_timer timer(executor, options.latency);
+        co_await timer.async_wait(net::redirect_error(net::use_awaitable, ec));
+    }
+
+    http::response<http::string_body> res;
+    res.version(req.version());
+    res.keep_alive(keep_alive);
+    res.set(http::field::content_type, "application/json");
+    const std::string_view target(req.target().data(), req.target().size());
+    if (options.throttle_every != 0 && sequence % options.throttle_every == 0) {
+        throttled.fetch_add(1, std::memory_order_relaxed);
+        res.result(http::status::too_many_requests);
+        res.set(http::field::retry_after, "1");
+        res.body() = R"({"status":"ERROR","error":"Too many requests"})";
+    } else if (req.method() == http::verb::get && target.rfind("/v3/trades/", 0) == 0) {
+        res.result(http::status::ok);
+        res.body() = trades_page(target);
+    } else {
+        res.result(http::status::not_found);
+        res.body() = R"({"status":"NOT_FOUND"})";
+    }
+    res.prepare_payload();
+
+    const bool cut = options.disconnect_every != 0 && sequence % options.disconnect_every == 0;
+    if (!cut && options.bytes_per_second == 0) {
+        co_await http::async_write(stream, res, net::redirect_error(net::use_awaitable, ec));
+        keep_alive = keep_alive && !ec;
+        co_return;
+    }
+
+    // Header first, then the body by hand so it can be paced or cut short.
+    http::response_serializer<http::string_body> serializer(res);
+    co_await http::async_write_header(stream, serializer,
+                                      net::redirect_error(net::use_awaitable, ec));
+    const std::string &body = res.body();
+    const std::size_t length = cut ? body.size() / 2 : body.size();
+    const auto started = Clock::now();
+    net::steady_timer pacer(executor);
+    for (std::size_t offset = 0; offset < length && !ec;) {
+        const std::size_t chunk = std::min(kWriteChunk, length - offset);
+        co_await net::async_write(stream, net::buffer(body.data() + offset, chunk),
+                                  net::redirect_error(net::use_awaitable, ec));
+        offset += chunk;
+        if (options.bytes_per_second != 0) {
+            const auto due = started + std::chrono::microseconds(
+                                           offset * 1000000 / options.bytes_per_second);
+            pacer.expires_at(due);
+            co_await pacer.async_wait(net::redirect_error(net::use_awaitable, ec));
+        }
+    }
+    if (cut) {
+        disconnects.fetch_add(1, std::memory_order_relaxed);
+        // Abrupt, without close_notify, like a dropped connection.
+        beast::get_lowest_layer(stream).socket().close(ec);
+        keep_alive = false;
+    } else if (ec) {
+        keep_alive = false;
+    }
+}
+
+std::string LoopbackServer::Impl::trades_page(std::string_view target) const {
+    const auto path_end = target.find('?');
+    const auto path = target.substr(0, path_end);
+    const std::size_t page = parse_count(query_value(target, "cursor"));
+
+    std::string body;
+    body.reserve(options.trades_per_page * 96 + 256);
+    body += R"({"status":"OK","request_id":"loopback","results":[)";
+    const std::size_t first = page * options.trades_per_page;
+    for (std::size_t i = 0; i < options.trades_per_page; ++i) {
+        if (i != 0) {
+            body += ',';
+        }
+        append_trade(body, first + i);
+    }
+    body += ']';
+    if (page + 1 < options.pages) {
+        body += R"(,"next_url":"https://127.0.0.1:)";
+        body += std::to_string(port);
+        body += path;
+        body += "?cursor=";
+        body += std::to_string(page + 1);
+        body += '"';
+    }
+    body += '}';
+    return body;
+}
+
+net::awaitable<void> LoopbackServer::Impl::serve_websocket(TlsStream stream,
+                                                           http::request<http::string_body> req) {
+    websocket_sessions.fetch_add(1, std::memory_order_relaxed);
+    auto executor = co_await net::this_coro::executor;
+    auto ws = std::make_shared<websocket::stream<TlsStream>>(std::move(stream));
+    beast::get_lowest_layer(*ws).expires_never();
+    boost::system::error_code ec;
+    co_await ws->async_accept(req, net::redirect_error(net::use_awaitable, ec));
+    if (ec) {
+        co_return;
+    }
+    ws->text(true);
+
+    // Shared with the writer coroutine, which runs on the same strand. Every frame goes out
+    // through the writer, as Beast allows one write in flight; the reader queues its replies
+    // and wakes it.
+    struct Session {
+        explicit Session(const net::any_io_executor &executor) : wake(executor) {}
+        std::set<std::string> symbols;
+        bool all{false};
+        bool closed{false};
+        std::deque<std::string> replies;
+        net::steady_timer wake;
+    };
+    auto session = std::make_shared<Session>(executor);
+    session->replies.emplace_back(
+        R"([{"ev":"status","status":"connected","message":"Connected"}])");
+
+    auto writer = [this, ws, session]() -> net::awaitable<void> {
+        const auto interval = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / std::max(options.frames_per_second, 1e-3)));
+        auto due = Clock::now();
+        std::size_t sent = 0;
+        std::size_t sequence = 0;
+        std::string frame;
+        std::string prefix;
+        std::vector<std::string> symbols;
+        boost::system::error_code write_ec;
+        while (!session->closed) {
+            while (!session->replies.empty()) {
+                co_await ws->async_write(net::buffer(session->replies.front()),
+                                         net::redirect_error(net::use_awaitable, write_ec));
+                if (write_ec) {
+                    co_return;
+                }
+                session->replies.pop_front();
+            }
+            const bool subscribed = session->all || !session->symbols.empty();
+            if (!subscribed) {
+                // Trades start as soon as the first subscription arrives.
+                due = Clock::now();
+                session->wake.expires_at(Clock::time_point::max());
+                co_await session->wake.async_wait(net::redirect_error(net::use_awaitable,
+                                                                      write_ec));
+                continue;
+            }
+            if (Clock::now() < due) {
+                session->wake.expires_at(due);
+                co_await session->wake.async_wait(net::redirect_error(net::use_awaitable,
+                                                                      write_ec));
+                continue;
+            }
+            // T.* cycles through a few well-known tickers.
+            if (session->all) {
+                symbols = {"AAPL", "MSFT", "NVDA", "AMZN", "TSLA"};
+            } else if (symbols.size() != session->symbols.size()) {
+                symbols.assign(session->symbols.begin(), session->symbols.end());
+            }
+            frame = "[";
+            for (std::size_t i = 0; i < options.trades_per_frame; ++i, ++sequence) {
+                if (i != 0) {
+                    frame += ',';
+                }
+                prefix = R"("ev":"T","sym":")";
+                prefix += symbols[sequence % symbols.size()];
+                prefix += "\",";
+                append_trade(frame, sequence, prefix);
+            }
+            frame += ']';
+            co_await ws->async_write(net::buffer(frame),
+                                     net::redirect_error(net::use_awaitable, write_ec));
+            if (write_ec) {
+                co_return;
+            }
+            frames.fetch_add(1, std::memory_order_relaxed);
+            if (options.disconnect_after_frames != 0 &&
+                ++sent >= options.disconnect_after_frames) {
+                disconnects.fetch_add(1, std::memory_order_relaxed);
+                session->closed = true;
+                beast::get_lowest_layer(*ws).socket().close(write_ec);
+                co_return;
+            }
+            // Fixed schedule; a writer that falls behind sends back to back to catch up.
+            due += interval;
+        }
+    };
+    net::co_spawn(executor, writer(), net::detached);
+
+    beast::flat_buffer buffer;
+    while (true) {
+        buffer.clear();
+        co_await ws->async_read(buffer, net::redirect_error(net::use_awaitable, ec));
+        if (ec) {
+            session->closed = true;
+            session->wake.cancel();
+            co_return;
+        }
+        const std::string message = beast::buffers_to_string(buffer.data());
+        if (message.find(R"("action":"auth")") != std::string::npos) {
+            session->replies.emplace_back(
+                R"([{"ev":"status","status":"auth_success","message":"authenticated"}])");
+            session->wake.cancel();
+            continue;
+        }
+        if (message.find(R"("action":"subscribe")") == std::string::npos) {
+            continue;
+        }
+        // "params":"T.*,T.AAPL"; only trade channels produce frames.
+        const auto params = message.find(R"("params":")");
+        std::string_view list = params == std::string::npos
+                                    ? std::string_view()
+                                    : std::string_view(message).substr(params + 10);
+        list = list.substr(0, list.find('"'));
+        while (!list.empty()) {
+            const auto comma = list.find(',');
+            const auto channel = list.substr(0, comma);
+            list = comma == std::string_view::npos ? std::string_view() : list.substr(comma + 1);
+            if (channel == "T.*") {
+                session->all = true;
+            } else if (channel.rfind("T.", 0) == 0) {
+                session->symbols.emplace(channel.substr(2));
+            }
+        }
+        session->wake.cancel();
+    }
+}
+
+LoopbackServer::LoopbackServer(LoopbackServerOptions options)
+    : impl_(std::make_unique<Impl>(std::move(options))) {
+    impl_->context.emplace(static_cast<int>(impl_->options.threads));
+    impl_->acceptor.emplace(*impl_->context,
+                            tcp::endpoint(net::ip::make_address("127.0.0.1"),
+                                          impl_->options.port));
+    impl_->port = impl_->acceptor->local_endpoint().port();
+    net::co_spawn(*impl_->context, impl_->accept_loop(), net::detached);
+    for (std::size_t i = 0; i < impl_->options.threads; ++i) {
+        impl_->threads.emplace_back([this] { impl_->context->run(); });
+    }
+}
+
+LoopbackServer::~LoopbackServer() { stop(); }
+
+void LoopbackServer::stop() {
+    if (!impl_->context) {
+        return;
+    }
+    impl_->context->stop();
+    for (auto &thread : impl_->threads) {
+        thread.join();
+    }
+    impl_->threads.clear();
+    impl_->acceptor.reset();
+    // Destroying the context destroys the suspended connections, closing their sockets.
+    impl_->context.reset();
+}
+
+std::uint16_t LoopbackServer::port() const noexcept { return impl_->port; }
+
+std::string LoopbackServer::base_url() const {
+    return "https://127.0.0.1:" + std::to_string(impl_->port);
+}
+
+LoopbackServerStats LoopbackServer::stats() const noexcept {
+    LoopbackServerStats stats;
+    stats.connections = impl_->connections.load(std::memory_order_relaxed);
+    stats.requests = impl_->requests.load(std::memory_order_relaxed);
+    stats.throttled = impl_->throttled.load(std::memory_order_relaxed);
+    stats.disconnects = impl_->disconnects.load(std::memory_order_relaxed);
+    stats.websocket_sessions = impl_->websocket_sessions.load(std::memory_order_relaxed);
+    stats.frames = impl_->frames.load(std::memory_order_relaxed);
+    return stats;
+}
+
+}  // namespace massive::testing
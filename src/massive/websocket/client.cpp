@@ -1,14 +1,22 @@
 #include "massive/websocket/client.hpp"
+#include "massive/core/http/dns_cache.hpp"
+#include "massive/core/http/happy_eyeballs.hpp"
+#include "massive/core/http/tls_context.hpp"
 
 #include <boost/beast/core.hpp>
 #include <boost/beast/ssl.hpp>
 #include <boost/beast/websocket.hpp>
 #include <boost/beast/websocket/ssl.hpp>
-#include <boost/asio/connect.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/use_future.hpp>
 #include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/asio/ssl/stream.hpp>
 #include <boost/asio/buffer.hpp>
+#include <boost/asio/use_awaitable.hpp>
 #include <simdjson/ondemand.h>
+#include <deque>
+#include <iostream>
 #include <sstream>
 #include <stdexcept>
 #include <thread>
@@ -26,18 +34,79 @@ using tcp = boost::asio::ip::tcp;
 // PIMPL structure for WebSocket implementation
 struct Impl {
     net::io_context ioc;
-    ssl::context ctx{ssl::context::sslv23_client};
+    // Kept across connect() calls so reconnects can resume the previous TLS session
+    core::TlsContext tls;
+    std::string session_key;
     std::unique_ptr<websocket::stream<beast::ssl_stream<tcp::socket>>> ws;
+    // Runs the io_context, and with it every read and write, once connect() has finished.
+    // From then on the stream is only touched on that thread.
     std::thread worker_thread;
+    // Frames waiting to be written by the worker; the front one is in flight. Beast allows
+    // one write (close included) at a time.
+    std::deque<std::string> outbox;
+    bool closing{false};
     std::atomic<bool> running{false};
     std::atomic<bool> connected{false};
     MessageHandler message_handler;
-    
-    Impl() {
-        ctx.set_default_verify_paths();
-    }
+    // Reused for every frame on the connection so steady-state reads do not allocate
+    simdjson::ondemand::parser parser;
+    std::vector<WebSocketMessage> messages;
 };
 
+namespace {
+// Leaves simdjson's padding behind the frame in `buffer` and returns a view of the frame.
+std::string_view padded_frame(beast::flat_buffer& buffer) {
+    buffer.prepare(simdjson::SIMDJSON_PADDING);
+    auto frame = buffer.data();
+    return {static_cast<const char*>(frame.data()), frame.size()};
+}
+
+// The functions below run on the worker thread.
+void write_next(Impl* impl);
+
+void start_close(Impl* impl) {
+    // Completes once the server answers; the pending read then ends with error::closed.
+    impl->ws->async_close(websocket::close_code::normal, [](beast::error_code) {});
+}
+
+void write_next(Impl* impl) {
+    impl->ws->async_write(net::buffer(impl->outbox.front()),
+                          [impl](beast::error_code ec, std::size_t) {
+                              impl->outbox.pop_front();
+                              if (ec) {
+                                  impl->outbox.clear();
+                              } else if (!impl->outbox.empty()) {
+                                  write_next(impl);
+                              } else if (impl->closing) {
+                                  start_close(impl);
+                              }
+                          });
+}
+
+// Sends a text frame: directly before the worker starts, through the outbox after. Returns
+// false, sending nothing, once the connection has dropped. A frame queued just before the drop
+// is lost with it; the next connect() subscribes afresh anyway.
+bool send_frame(Impl* impl, std::string frame) {
+    if (!impl->worker_thread.joinable()) {
+        impl->ws->write(net::buffer(frame));
+        return true;
+    }
+    if (!impl->connected) {
+        return false;
+    }
+    net::post(impl->ioc, [impl, frame = std::move(frame)]() mutable {
+        if (!impl->connected) {
+            return;
+        }
+        impl->outbox.push_back(std::move(frame));
+        if (impl->outbox.size() == 1) {
+            write_next(impl);
+        }
+    });
+    return true;
+}
+} // namespace
+
 WebSocketClient::WebSocketClient(
     const std::string& api_key,
     Feed feed,
@@ -81,29 +150,34 @@ void WebSocketClient::connect(MessageHandler handler) {
     // Build WebSocket host and path
     std::string feed_str = to_string(feed_);
     std::string market_str = to_string(market_);
-    std::string host = feed_str;
+    std::string host = endpoint_host_.empty() ? feed_str : endpoint_host_;
     std::string path = "/" + market_str;
     
-    // Resolve host
-    tcp::resolver resolver(impl->ioc);
-    auto const results = resolver.resolve(host, "443");
+    // Resolve host through the shared cache, so reconnects skip the lookup
+    auto const endpoints = core::DnsCache::shared()->resolve(host, endpoint_port_);
     
     // Create WebSocket stream
     impl->ws = std::make_unique<websocket::stream<beast::ssl_stream<tcp::socket>>>(
-        impl->ioc, impl->ctx
+        impl->ioc, impl->tls.native()
     );
     
-    // Set SNI hostname
-    if (!SSL_set_tlsext_host_name(impl->ws->next_layer().native_handle(), host.c_str())) {
-        beast::error_code ec{static_cast<int>(::ERR_get_error()), net::error::get_ssl_category()};
-        throw beast::system_error{ec};
-    }
+    // Set SNI hostname and offer the cached session, if any
+    impl->session_key = host + ":" + endpoint_port_;
+    impl->tls.prepare(impl->ws->next_layer().native_handle(), host, impl->session_key);
     
-    // Connect
-    net::connect(impl->ws->next_layer().next_layer(), results.begin(), results.end());
+    // Connect, racing the resolved addresses; the stream is otherwise synchronous, so drive
+    // the io_context here until the connect finishes
+    auto connected = net::co_spawn(
+        impl->ioc,
+        core::async_connect_happy_eyeballs(impl->ws->next_layer().next_layer(), endpoints),
+        net::use_future);
+    impl->ioc.restart();
+    impl->ioc.run();
+    connected.get();
     
     // SSL handshake
     impl->ws->next_layer().handshake(ssl::stream_base::client);
+    impl->tls.record_handshake(impl->ws->next_layer().native_handle());
     
     // WebSocket handshake
     impl->ws->handshake(host, path);
@@ -114,27 +188,46 @@ void WebSocketClient::connect(MessageHandler handler) {
     // Authenticate
     authenticate();
     
-    // Reconcile subscriptions
+    // Subscribe to everything scheduled: a new connection starts with no subscriptions
+    current_subscriptions_.clear();
     reconcile_subscriptions();
     
-    // Start message processing in background thread
-    impl->worker_thread = std::thread([this, impl]() {
-        beast::flat_buffer buffer;
-        while (impl->running && impl->connected) {
-            try {
+    // Start message processing in background thread. Bounds the close handshake, among
+    // others, so close() cannot hang on a server that never answers.
+    impl->ws->set_option(websocket::stream_base::timeout::suggested(beast::role_type::client));
+    impl->closing = false;
+    net::co_spawn(
+        impl->ioc,
+        [this, impl]() -> net::awaitable<void> {
+            // clear() keeps the storage, so the buffer stops growing once it fits the largest
+            // frame
+            beast::flat_buffer buffer;
+            for (;;) {
                 buffer.clear();
-                impl->ws->read(buffer);
-                
-                std::string message = beast::buffers_to_string(buffer.data());
-                process_message(message);
+                co_await impl->ws->async_read(buffer, net::use_awaitable);
+                process_message(padded_frame(buffer));
+            }
+        },
+        [this, impl](std::exception_ptr error) {
+            impl->connected = false;
+            // Subscription changes are kept for the next connect() from now on
+            connected_ = false;
+            if (!error || !impl->running || !verbose_) {
+                return;
+            }
+            try {
+                std::rethrow_exception(error);
             } catch (const std::exception& e) {
-                if (verbose_) {
-                    std::cerr << "WebSocket read error: " << e.what() << std::endl;
-                }
-                break;
+                std::cerr << "WebSocket read error: " << e.what() << std::endl;
             }
-        }
-    });
+        });
+    impl->ioc.restart();
+    impl->worker_thread = std::thread([impl]() { impl->ioc.run(); });
+}
+
+void WebSocketClient::set_endpoint(std::string host, std::string port) {
+    endpoint_host_ = std::move(host);
+    endpoint_port_ = std::move(port);
 }
 
 void WebSocketClient::authenticate() {
@@ -154,12 +247,11 @@ void WebSocketClient::authenticate() {
     // Read auth response
     beast::flat_buffer buffer;
     impl->ws->read(buffer);
-    std::string response = beast::buffers_to_string(buffer.data());
+    std::string_view response = padded_frame(buffer);
     
     // Parse response to check if auth succeeded
-    simdjson::ondemand::parser parser;
-    simdjson::padded_string json = response;
-    auto doc_result = parser.iterate(json);
+    auto doc_result = impl->parser.iterate(response.data(), response.size(),
+                                           response.size() + simdjson::SIMDJSON_PADDING);
     if (!doc_result.error()) {
         auto& doc = doc_result.value();
         auto arr = doc.get_array();
@@ -210,8 +302,10 @@ void WebSocketClient::reconcile_subscriptions() {
             first = false;
         }
         sub_msg << R"("})";
-        std::string sub_str = sub_msg.str();
-        impl->ws->write(net::buffer(sub_str));
+        if (!send_frame(impl, sub_msg.str())) {
+            // Disconnected: left scheduled for the next connect()
+            return;
+        }
     }
     
     // Unsubscribe from removed subscriptions
@@ -233,8 +327,9 @@ void WebSocketClient::reconcile_subscriptions() {
         }
         unsub_msg << R"("})";
         
-        std::string unsub_str = unsub_msg.str();
-        impl->ws->write(net::buffer(unsub_str));
+        if (!send_frame(impl, unsub_msg.str())) {
+            return;
+        }
     }
     
     current_subscriptions_ = scheduled_subscriptions_;
@@ -272,7 +367,7 @@ void WebSocketClient::unsubscribe_all() {
     }
 }
 
-void WebSocketClient::process_message(const std::string& message) {
+void WebSocketClient::process_message(std::string_view message) {
     auto* impl = static_cast<Impl*>(websocket_impl_);
     
     if (raw_) {
@@ -280,30 +375,31 @@ void WebSocketClient::process_message(const std::string& message) {
     }
     
     // Skip status messages
-    if (message.find(R"("ev":"status")") != std::string::npos) {
+    if (message.find(R"("ev":"status")") != std::string_view::npos) {
         return;
     }
     
-    auto parsed_messages = parse_messages(message);
-    if (!parsed_messages.empty() && impl->message_handler) {
-        impl->message_handler(parsed_messages);
+    parse_messages(message, impl->messages);
+    if (!impl->messages.empty() && impl->message_handler) {
+        impl->message_handler(impl->messages);
     }
 }
 
-std::vector<WebSocketMessage> WebSocketClient::parse_messages(const std::string& json) {
-    std::vector<WebSocketMessage> messages;
+void WebSocketClient::parse_messages(std::string_view json,
+                                     std::vector<WebSocketMessage>& messages) {
+    auto* impl = static_cast<Impl*>(websocket_impl_);
+    messages.clear();
     
-    simdjson::ondemand::parser parser;
-    simdjson::padded_string json_data = json;
-    auto doc_result = parser.iterate(json_data);
+    auto doc_result = impl->parser.iterate(json.data(), json.size(),
+                                           json.size() + simdjson::SIMDJSON_PADDING);
     if (doc_result.error()) {
-        return messages;
+        return;
     }
     
     auto& doc = doc_result.value();
     auto arr = doc.get_array();
     if (arr.error()) {
-        return messages;
+        return;
     }
     
     for (auto elem : arr.value()) {
@@ -406,8 +502,6 @@ std::vector<WebSocketMessage> WebSocketClient::parse_messages(const std::string&
             messages.push_back(agg);
         }
     }
-    
-    return messages;
 }
 
 void WebSocketClient::close() {
@@ -416,7 +510,21 @@ void WebSocketClient::close() {
     impl->running = false;
     connected_ = false;
     
-    if (impl->ws && impl->connected) {
+    if (impl->worker_thread.joinable()) {
+        // The worker owns the stream, so it sends the close frame, after any queued writes;
+        // its read then ends and the io_context runs out of work.
+        net::post(impl->ioc, [impl]() {
+            impl->closing = true;
+            if (impl->connected && impl->outbox.empty()) {
+                start_close(impl);
+            }
+        });
+        impl->worker_thread.join();
+        // If the worker had already stopped, the stream is ours now: finish what it left.
+        impl->ioc.restart();
+        impl->ioc.run();
+        impl->outbox.clear();
+    } else if (impl->ws && impl->connected) {
         try {
             impl->ws->close(websocket::close_code::normal);
         } catch (...) {
@@ -424,10 +532,6 @@ void WebSocketClient::close() {
         }
     }
     
-    if (impl->worker_thread.joinable()) {
-        impl->worker_thread.join();
-    }
-    
     impl->connected = false;
 }
 